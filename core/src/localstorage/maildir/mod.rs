@@ -27,12 +27,13 @@ mod filename;
 mod uidlist;
 
 use crate::localstorage::mailbox_name_codec;
+use crate::localstorage::mapped::MappedRange;
 use crate::message_id::{maildir_message_id, MessageId};
 use crate::mime::{parse_envelope, parse_thread_headers, EmailAddress, EnvelopeHeaders};
 use crate::store::{Address, ConversationSummary, DateTime, Envelope};
 use crate::store::{ThreadId, ThreadSummary};
 use crate::store::Flag;
-use crate::store::{Folder, FolderInfo, OpenFolderEvent, Store, StoreError, StoreKind};
+use crate::store::{Folder, FolderInfo, FolderStatus, OpenFolderEvent, Store, StoreError, StoreKind};
 use filename::MaildirFilename;
 use std::collections::HashSet;
 use std::fs;
@@ -125,6 +126,29 @@ impl MaildirStore {
         Ok(result)
     }
 
+    /// Total and unread messages in the maildir at path, from directory entries alone:
+    /// everything in new/ is unread, and so is anything in cur/ without the S flag.
+    fn count_messages(path: &Path) -> (u64, u64) {
+        let entries = |sub: &str| {
+            fs::read_dir(path.join(sub))
+                .into_iter()
+                .flatten()
+                .flatten()
+                .map(|e| e.file_name().to_string_lossy().into_owned())
+                .filter(|n| !n.starts_with('.'))
+        };
+        let new = entries("new").count() as u64;
+        let (mut total, mut unread) = (new, new);
+        for name in entries("cur") {
+            total += 1;
+            let seen = name.rsplit_once(":2,").map_or(false, |(_, flags)| flags.contains('S'));
+            if !seen {
+                unread += 1;
+            }
+        }
+        (total, unread)
+    }
+
     fn open_folder_sync(&self, name: &str) -> Result<Box<dyn Folder>, StoreError> {
         let path = self.resolve_mailbox_path(name);
         if !self.is_valid_maildir(&path) {
@@ -170,6 +194,23 @@ impl Store for MaildirStore {
         }
     }
 
+    fn poll_folder_status(
+        &self,
+        on_status: Box<dyn Fn(FolderStatus) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        match self.list_mailboxes() {
+            Ok(names) => {
+                for name in names {
+                    let (total, unread) = Self::count_messages(&self.resolve_mailbox_path(&name));
+                    on_status(FolderStatus { name, total, unread });
+                }
+                on_complete(Ok(()));
+            }
+            Err(e) => on_complete(Err(e)),
+        }
+    }
+
     fn open_folder(
         &self,
         name: &str,
@@ -422,6 +463,27 @@ impl Folder for MaildirFolder {
         on_complete(Ok(()));
     }
 
+    fn get_message_source(
+        &self,
+        id: &MessageId,
+        on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        let filename = match id.as_str().strip_prefix("maildir://") {
+            Some(rest) => rest.rsplit('/').next().unwrap_or_default(),
+            None => "",
+        };
+        if filename.is_empty() {
+            on_complete(Err(StoreError::new("invalid maildir message id")));
+            return;
+        }
+        let result = self
+            .find_message_file(filename)
+            .and_then(|path| MappedRange::open_file(&path))
+            .map(|raw| on_content_chunk(&raw));
+        on_complete(result);
+    }
+
     fn delete_message(
         &self,
         id: &MessageId,
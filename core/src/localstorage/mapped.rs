@@ -0,0 +1,157 @@
+/*
+ * mapped.rs
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//! Read-only views of a byte range of a local file (a Maildir message or one message of an
+//! mbox). On Unix the range is memory-mapped, so serving a large message's raw source
+//! neither reads nor copies it up front; elsewhere, or if mmap fails, it is read into memory.
+//! Callers hand the whole range to the content callback as one chunk, so the only copy is
+//! the one the consumer makes.
+
+use crate::store::StoreError;
+use std::fs::File;
+use std::io::{Read, Seek, SeekFrom};
+use std::ops::Deref;
+use std::path::Path;
+
+enum Inner {
+    #[cfg(unix)]
+    Mapped {
+        base: *mut libc::c_void,
+        map_len: usize,
+        offset: usize,
+        len: usize,
+    },
+    Owned(Vec<u8>),
+}
+
+/// Bytes `start..end` of a file, mapped or read. Derefs to `[u8]`.
+pub struct MappedRange {
+    inner: Inner,
+}
+
+// The mapping is private and read-only; nothing mutates it while it is alive.
+unsafe impl Send for MappedRange {}
+unsafe impl Sync for MappedRange {}
+
+impl MappedRange {
+    /// Map bytes `start..end` of the file at `path`. `end == u64::MAX` means end of file.
+    pub fn open(path: &Path, start: u64, end: u64) -> Result<Self, StoreError> {
+        let mut file = File::open(path).map_err(|e| StoreError::new(e.to_string()))?;
+        let file_len = file.metadata().map_err(|e| StoreError::new(e.to_string()))?.len();
+        let end = end.min(file_len);
+        if start > end {
+            return Err(StoreError::new("range outside file"));
+        }
+        let len = (end - start) as usize;
+        if len == 0 {
+            return Ok(Self { inner: Inner::Owned(Vec::new()) });
+        }
+        #[cfg(unix)]
+        {
+            if let Some(inner) = map(&file, start, len) {
+                return Ok(Self { inner });
+            }
+        }
+        let mut buf = vec![0u8; len];
+        file.seek(SeekFrom::Start(start)).map_err(|e| StoreError::new(e.to_string()))?;
+        file.read_exact(&mut buf).map_err(|e| StoreError::new(e.to_string()))?;
+        Ok(Self { inner: Inner::Owned(buf) })
+    }
+
+    /// Map a whole file.
+    pub fn open_file(path: &Path) -> Result<Self, StoreError> {
+        Self::open(path, 0, u64::MAX)
+    }
+}
+
+#[cfg(unix)]
+fn map(file: &File, start: u64, len: usize) -> Option<Inner> {
+    use std::os::unix::io::AsRawFd;
+    let page = match unsafe { libc::sysconf(libc::_SC_PAGESIZE) } {
+        n if n > 0 => n as u64,
+        _ => 4096,
+    };
+    // mmap offsets must be page-aligned: map from the page containing start
+    let aligned = start - start % page;
+    let offset = (start - aligned) as usize;
+    let map_len = offset + len;
+    let base = unsafe {
+        libc::mmap(
+            std::ptr::null_mut(),
+            map_len,
+            libc::PROT_READ,
+            libc::MAP_PRIVATE,
+            file.as_raw_fd(),
+            aligned as libc::off_t,
+        )
+    };
+    if base == libc::MAP_FAILED {
+        return None;
+    }
+    unsafe {
+        libc::madvise(base, map_len, libc::MADV_SEQUENTIAL);
+    }
+    Some(Inner::Mapped { base, map_len, offset, len })
+}
+
+impl Deref for MappedRange {
+    type Target = [u8];
+
+    fn deref(&self) -> &[u8] {
+        match &self.inner {
+            #[cfg(unix)]
+            Inner::Mapped { base, offset, len, .. } => unsafe {
+                std::slice::from_raw_parts((*base as *const u8).add(*offset), *len)
+            },
+            Inner::Owned(v) => v,
+        }
+    }
+}
+
+impl Drop for MappedRange {
+    fn drop(&mut self) {
+        #[cfg(unix)]
+        if let Inner::Mapped { base, map_len, .. } = self.inner {
+            unsafe {
+                libc::munmap(base, map_len);
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::io::Write;
+
+    #[test]
+    fn maps_unaligned_range() {
+        let path = std::env::temp_dir().join(format!("tagliacarte-mapped-{}", std::process::id()));
+        let data: Vec<u8> = (0..20000u32).map(|i| (i % 251) as u8).collect();
+        File::create(&path).unwrap().write_all(&data).unwrap();
+        let r = MappedRange::open(&path, 5000, 12345).unwrap();
+        assert_eq!(&r[..], &data[5000..12345]);
+        let whole = MappedRange::open_file(&path).unwrap();
+        assert_eq!(&whole[..], &data[..]);
+        let empty = MappedRange::open(&path, 100, 100).unwrap();
+        assert!(empty.is_empty());
+        std::fs::remove_file(&path).unwrap();
+    }
+}
@@ -23,6 +23,7 @@
 //! All trait methods are callback-driven. Since mbox is file-based, callbacks
 //! fire inline before the method returns.
 
+use crate::localstorage::mapped::MappedRange;
 use crate::message_id::{mbox_message_id, MessageId};
 use crate::mime::{parse_envelope, parse_thread_headers, EmailAddress, EnvelopeHeaders};
 use crate::store::{Address, ConversationSummary, DateTime, Envelope};
@@ -34,16 +35,20 @@ use std::fs::OpenOptions;
 use std::fs::File;
 use std::io::{BufRead, BufReader, Read, Seek, SeekFrom, Write};
 use std::path::{Path, PathBuf};
+use std::sync::{Arc, Mutex};
+use std::time::SystemTime;
 
 /// Local Store over a single mbox file (one folder: INBOX).
 pub struct MboxStore {
     path: PathBuf,
+    /// Message offsets, shared by every folder opened on the file.
+    index: Arc<Mutex<Option<MboxIndex>>>,
 }
 
 impl MboxStore {
     pub fn new(path: impl AsRef<Path>) -> Result<Self, StoreError> {
         let path = path.as_ref().to_path_buf();
-        Ok(Self { path })
+        Ok(Self { path, index: Arc::new(Mutex::new(None)) })
     }
 }
 
@@ -77,6 +82,7 @@ impl Store for MboxStore {
         }
         on_complete(Ok(Box::new(MboxFolder {
             path: self.path.clone(),
+            index: self.index.clone(),
         })));
     }
 
@@ -96,6 +102,15 @@ impl Store for MboxStore {
 /// Folder over a single mbox file.
 struct MboxFolder {
     path: PathBuf,
+    index: Arc<Mutex<Option<MboxIndex>>>,
+}
+
+/// Offsets from `scan_offsets`, valid while the file keeps the length and mtime they were
+/// scanned at.
+struct MboxIndex {
+    len: u64,
+    modified: Option<SystemTime>,
+    offsets: Arc<Vec<(u64, u64)>>,
 }
 
 /// Offsets of each message in the mbox (start inclusive, end exclusive; start is after "From " line).
@@ -141,6 +156,39 @@ impl MboxFolder {
         self.path.to_string_lossy().to_string()
     }
 
+    /// Message offsets, rescanning the file only when it has changed since the last scan.
+    fn offsets(&self) -> Result<Arc<Vec<(u64, u64)>>, StoreError> {
+        let meta = std::fs::metadata(&self.path).map_err(|e| StoreError::new(e.to_string()))?;
+        let (len, modified) = (meta.len(), meta.modified().ok());
+        let mut index = self.index.lock().unwrap();
+        if let Some(ref i) = *index {
+            if i.len == len && i.modified == modified {
+                return Ok(i.offsets.clone());
+            }
+        }
+        let offsets = Arc::new(scan_offsets(&self.path)?);
+        *index = Some(MboxIndex { len, modified, offsets: offsets.clone() });
+        Ok(offsets)
+    }
+
+    /// Byte range of a message in the mbox, from its id (mbox://path#offset).
+    fn message_range(&self, id: &MessageId) -> Result<(u64, u64), StoreError> {
+        let rest = id
+            .as_str()
+            .strip_prefix("mbox://")
+            .ok_or_else(|| StoreError::new("invalid mbox message id"))?;
+        let hash_idx = rest.find('#');
+        let offset_str = hash_idx.and_then(|i| rest.get(i + 1..)).and_then(|s| s.split('/').next());
+        let start: u64 = offset_str
+            .and_then(|x| x.parse().ok())
+            .ok_or_else(|| StoreError::new("invalid mbox message id"))?;
+        let offsets = self.offsets()?;
+        offsets
+            .binary_search_by_key(&start, |&(s, _)| s)
+            .map(|i| offsets[i])
+            .map_err(|_| StoreError::new("message not found"))
+    }
+
     fn read_range(&self, start: u64, end: u64) -> Result<Vec<u8>, StoreError> {
         let mut f = File::open(&self.path).map_err(|e| StoreError::new(e.to_string()))?;
         let len = (end - start) as usize;
@@ -158,7 +206,7 @@ impl Folder for MboxFolder {
         on_summary: Box<dyn Fn(ConversationSummary) + Send + Sync>,
         on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
     ) {
-        let offsets = match scan_offsets(&self.path) {
+        let offsets = match self.offsets() {
             Ok(o) => o,
             Err(e) => {
                 on_complete(Err(e));
@@ -199,7 +247,7 @@ impl Folder for MboxFolder {
         &self,
         on_complete: Box<dyn FnOnce(Result<u64, StoreError>) + Send>,
     ) {
-        match scan_offsets(&self.path) {
+        match self.offsets() {
             Ok(offsets) => on_complete(Ok(offsets.len() as u64)),
             Err(e) => on_complete(Err(e)),
         }
@@ -212,34 +260,10 @@ impl Folder for MboxFolder {
         on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync>,
         on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
     ) {
-        let s = id.as_str();
-        let prefix = "mbox://";
-        if !s.starts_with(prefix) {
-            on_complete(Err(StoreError::new("invalid mbox message id")));
-            return;
-        }
-        let rest = s.strip_prefix(prefix).unwrap();
-        let hash_idx = rest.find('#');
-        let offset_str = hash_idx.and_then(|i| rest.get(i + 1..)).and_then(|s| s.split('/').next());
-        let start: u64 = match offset_str.and_then(|x| x.parse().ok()) {
-            Some(n) => n,
-            None => {
-                on_complete(Err(StoreError::new("invalid mbox message id")));
-                return;
-            }
-        };
-        let offsets = match scan_offsets(&self.path) {
-            Ok(o) => o,
-            Err(e) => {
-                on_complete(Err(e));
-                return;
-            }
-        };
-        let idx = offsets.iter().position(|(s, _)| *s == start);
-        let (s, e) = match idx.and_then(|i| offsets.get(i)) {
-            Some(&(a, b)) => (a, b),
-            None => {
-                on_complete(Err(StoreError::new("message not found")));
+        let (s, e) = match self.message_range(id) {
+            Ok(r) => r,
+            Err(err) => {
+                on_complete(Err(err));
                 return;
             }
         };
@@ -258,13 +282,26 @@ impl Folder for MboxFolder {
         on_complete(Ok(()));
     }
 
+    fn get_message_source(
+        &self,
+        id: &MessageId,
+        on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        let result = self
+            .message_range(id)
+            .and_then(|(s, e)| MappedRange::open(&self.path, s, e))
+            .map(|raw| on_content_chunk(&raw));
+        on_complete(result);
+    }
+
     fn list_threads(
         &self,
         range: std::ops::Range<u64>,
         on_thread: Box<dyn Fn(ThreadSummary) + Send + Sync>,
         on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
     ) {
-        let offsets = match scan_offsets(&self.path) {
+        let offsets = match self.offsets() {
             Ok(o) => o,
             Err(e) => {
                 on_complete(Err(e));
@@ -319,7 +356,7 @@ impl Folder for MboxFolder {
         on_summary: Box<dyn Fn(ConversationSummary) + Send + Sync>,
         on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
     ) {
-        let offsets = match scan_offsets(&self.path) {
+        let offsets = match self.offsets() {
             Ok(o) => o,
             Err(e) => {
                 on_complete(Err(e));
@@ -327,7 +364,7 @@ impl Folder for MboxFolder {
             }
         };
         let mut in_thread = Vec::new();
-        for &(start, end) in &offsets {
+        for &(start, end) in offsets.iter() {
             let raw = match self.read_range(start, end) {
                 Ok(r) => r,
                 Err(e) => {
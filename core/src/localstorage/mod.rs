@@ -23,4 +23,5 @@
 pub mod index;
 pub mod maildir;
 pub mod mailbox_name_codec;
+pub mod mapped;
 pub mod mbox;
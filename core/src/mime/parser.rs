@@ -435,6 +435,11 @@ impl<H: MimeHandler> MimeParser<H> {
         self.handler
     }
 
+    /// Mutable access to the handler between receive() calls (e.g. to flush its own buffering).
+    pub fn handler_mut(&mut self) -> &mut H {
+        &mut self.handler
+    }
+
     /// End of input; flush any pending state.
     pub fn close(&mut self) -> Result<(), MimeParseError> {
         self.handler.set_locator(self.locator.clone());
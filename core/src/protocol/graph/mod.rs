@@ -156,6 +156,11 @@ impl Store for GraphStore {
         StoreKind::Email
     }
 
+    fn warm_up(&self, on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>) {
+        // Load the token and open the HTTPS connection; folders are fetched per request
+        on_complete(self.access_token().and_then(|_| self.ensure_connection()).map(|_| ()));
+    }
+
     fn list_folders(
         &self,
         on_folder: Box<dyn Fn(FolderInfo) + Send + Sync>,
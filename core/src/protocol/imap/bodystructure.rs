@@ -0,0 +1,434 @@
+/*
+ * bodystructure.rs
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//! IMAP BODYSTRUCTURE (RFC 3501 §7.4.2) parsing and structure-first fetch planning.
+//!
+//! The plan fetches the message header, each part's MIME header, and the bodies of
+//! displayable parts only; attachment bodies are left out and their headers carry
+//! the deferred-part markers so the UI can fetch them on demand.
+
+use crate::store::DeferredPart;
+
+/// One node of a message's MIME structure as reported by BODYSTRUCTURE.
+#[derive(Debug, Clone, PartialEq)]
+pub struct BodyPart {
+    /// IMAP section number ("1", "2.1", …). Empty for the top-level entity.
+    pub section: String,
+    /// Lowercase media type (e.g. "text", "multipart").
+    pub media_type: String,
+    /// Lowercase media subtype (e.g. "plain", "mixed").
+    pub media_subtype: String,
+    /// Content-Type parameters; names are lowercase.
+    pub params: Vec<(String, String)>,
+    pub id: Option<String>,
+    pub encoding: Option<String>,
+    /// Body size in octets (transfer-encoded). 0 for multiparts.
+    pub size: u64,
+    /// Lowercase disposition type (e.g. "attachment", "inline").
+    pub disposition: Option<String>,
+    pub children: Vec<BodyPart>,
+}
+
+impl BodyPart {
+    pub fn is_multipart(&self) -> bool {
+        self.media_type == "multipart"
+    }
+
+    pub fn param(&self, name: &str) -> Option<&str> {
+        self.params
+            .iter()
+            .find(|(k, _)| k.eq_ignore_ascii_case(name))
+            .map(|(_, v)| v.as_str())
+    }
+
+    /// Section spec for this part's own header: HEADER for the top level, else "n.MIME".
+    pub fn header_spec(&self) -> String {
+        header_spec_for_section(&self.section)
+    }
+
+    /// Section spec for this part's body: TEXT for the top level, else the section number.
+    pub fn body_spec(&self) -> String {
+        if self.section.is_empty() {
+            "TEXT".to_string()
+        } else {
+            self.section.clone()
+        }
+    }
+
+    /// Approximate decoded size (base64 shrinks by a quarter).
+    pub fn decoded_size(&self) -> u64 {
+        match self.encoding.as_deref() {
+            Some(e) if e.eq_ignore_ascii_case("base64") => self.size / 4 * 3,
+            _ => self.size,
+        }
+    }
+
+    /// True if the body is needed to display the message: text and embedded messages
+    /// that are not attachments, and images that are referenced inline.
+    pub fn is_displayable(&self) -> bool {
+        let attachment = self.disposition.as_deref() == Some("attachment");
+        match self.media_type.as_str() {
+            "text" | "message" => !attachment,
+            "image" => !attachment && (self.id.is_some() || self.disposition.as_deref() == Some("inline")),
+            _ => false,
+        }
+    }
+}
+
+/// Header section spec for a body section spec (as announced in the deferred-part marker).
+pub fn header_spec_for_section(section: &str) -> String {
+    if section.is_empty() || section.eq_ignore_ascii_case("TEXT") {
+        "HEADER".to_string()
+    } else {
+        format!("{}.MIME", section)
+    }
+}
+
+/// Parsed parenthesized-list item. Atoms and numbers are kept as strings.
+#[derive(Debug)]
+enum Item {
+    Nil,
+    Str(String),
+    List(Vec<Item>),
+}
+
+impl Item {
+    fn as_str(&self) -> Option<&str> {
+        match self {
+            Item::Str(s) => Some(s.as_str()),
+            _ => None,
+        }
+    }
+}
+
+struct Tokenizer<'a> {
+    b: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> Tokenizer<'a> {
+    fn skip_space(&mut self) {
+        while self.pos < self.b.len() && self.b[self.pos] == b' ' {
+            self.pos += 1;
+        }
+    }
+
+    /// Parse one item. Literals ({N}) are not supported and fail the parse.
+    fn item(&mut self) -> Option<Item> {
+        self.skip_space();
+        match *self.b.get(self.pos)? {
+            b'(' => {
+                self.pos += 1;
+                let mut items = Vec::new();
+                loop {
+                    self.skip_space();
+                    if *self.b.get(self.pos)? == b')' {
+                        self.pos += 1;
+                        return Some(Item::List(items));
+                    }
+                    items.push(self.item()?);
+                }
+            }
+            b'"' => {
+                self.pos += 1;
+                let mut out = Vec::new();
+                loop {
+                    let c = *self.b.get(self.pos)?;
+                    self.pos += 1;
+                    match c {
+                        b'"' => break,
+                        b'\\' => {
+                            out.push(*self.b.get(self.pos)?);
+                            self.pos += 1;
+                        }
+                        _ => out.push(c),
+                    }
+                }
+                Some(Item::Str(String::from_utf8_lossy(&out).into_owned()))
+            }
+            b'{' | b')' => None,
+            _ => {
+                let start = self.pos;
+                while self.pos < self.b.len() && !matches!(self.b[self.pos], b' ' | b'(' | b')') {
+                    self.pos += 1;
+                }
+                let atom = String::from_utf8_lossy(&self.b[start..self.pos]).into_owned();
+                if atom.eq_ignore_ascii_case("NIL") {
+                    Some(Item::Nil)
+                } else {
+                    Some(Item::Str(atom))
+                }
+            }
+        }
+    }
+}
+
+/// Parse the BODYSTRUCTURE from an untagged FETCH response line.
+/// Returns None if the line has no BODYSTRUCTURE or uses syntax we do not handle (e.g. literals).
+pub fn parse_bodystructure(line: &str) -> Option<BodyPart> {
+    let upper = line.to_ascii_uppercase();
+    let start = upper.find("BODYSTRUCTURE ")? + "BODYSTRUCTURE ".len();
+    let mut t = Tokenizer { b: line.as_bytes(), pos: start };
+    let item = t.item()?;
+    part_from_item(&item, String::new())
+}
+
+fn params_from_item(item: Option<&Item>) -> Vec<(String, String)> {
+    let mut out = Vec::new();
+    if let Some(Item::List(items)) = item {
+        for pair in items.chunks(2) {
+            if let (Some(k), Some(v)) = (pair[0].as_str(), pair.get(1).and_then(|v| v.as_str())) {
+                out.push((k.to_ascii_lowercase(), v.to_string()));
+            }
+        }
+    }
+    out
+}
+
+fn disposition_from_item(item: Option<&Item>) -> Option<String> {
+    match item {
+        Some(Item::List(items)) => items.first().and_then(|d| d.as_str()).map(|d| d.to_ascii_lowercase()),
+        _ => None,
+    }
+}
+
+fn child_section(parent: &str, index: usize) -> String {
+    if parent.is_empty() {
+        (index + 1).to_string()
+    } else {
+        format!("{}.{}", parent, index + 1)
+    }
+}
+
+fn part_from_item(item: &Item, section: String) -> Option<BodyPart> {
+    let items = match item {
+        Item::List(items) => items,
+        _ => return None,
+    };
+    if let Some(Item::List(_)) = items.first() {
+        // multipart: (child)(child)... "subtype" [params [disposition ...]]
+        let n = items.iter().take_while(|i| matches!(i, Item::List(_))).count();
+        let mut children = Vec::with_capacity(n);
+        for (i, child) in items[..n].iter().enumerate() {
+            children.push(part_from_item(child, child_section(&section, i))?);
+        }
+        return Some(BodyPart {
+            section,
+            media_type: "multipart".to_string(),
+            media_subtype: items.get(n)?.as_str()?.to_ascii_lowercase(),
+            params: params_from_item(items.get(n + 1)),
+            id: None,
+            encoding: None,
+            size: 0,
+            disposition: disposition_from_item(items.get(n + 2)),
+            children,
+        });
+    }
+    // single part: type subtype params id description encoding size [type-specific] [md5 disposition ...]
+    let media_type = items.first()?.as_str()?.to_ascii_lowercase();
+    let media_subtype = items.get(1)?.as_str()?.to_ascii_lowercase();
+    let ext = match (media_type.as_str(), media_subtype.as_str()) {
+        ("text", _) => 8,
+        ("message", "rfc822") | ("message", "global") => 10,
+        _ => 7,
+    };
+    Some(BodyPart {
+        section,
+        media_type,
+        media_subtype,
+        params: params_from_item(items.get(2)),
+        id: items.get(3).and_then(|i| i.as_str()).map(|s| s.to_string()),
+        encoding: items.get(5).and_then(|i| i.as_str()).map(|s| s.to_ascii_lowercase()),
+        size: items.get(6).and_then(|i| i.as_str()).and_then(|s| s.parse().ok()).unwrap_or(0),
+        disposition: disposition_from_item(items.get(ext + 1)),
+        children: Vec::new(),
+    })
+}
+
+/// One step of a structure-first fetch.
+#[derive(Debug, Clone, PartialEq)]
+pub enum FetchStep {
+    /// Bytes emitted verbatim between fetched sections (multipart delimiters).
+    Bytes(Vec<u8>),
+    /// Fetch a header section. `deferred` is (body section, decoded size) for a part whose
+    /// body is not fetched (see `deferred_parts`).
+    Header { spec: String, deferred: Option<(String, u64)> },
+    /// Fetch a body section and emit it as-is (still transfer-encoded).
+    Body { spec: String },
+}
+
+/// Plan used when the structure is unknown: the whole message, header then text.
+pub fn whole_message_plan() -> Vec<FetchStep> {
+    vec![
+        FetchStep::Header { spec: "HEADER".to_string(), deferred: None },
+        FetchStep::Body { spec: "TEXT".to_string() },
+    ]
+}
+
+/// Build the fetch plan reproducing the message as a MIME stream, with non-displayable
+/// bodies omitted. Returns None if a multipart has no boundary parameter.
+pub fn fetch_plan(root: &BodyPart) -> Option<Vec<FetchStep>> {
+    let mut plan = Vec::new();
+    plan_part(root, &mut plan)?;
+    Some(plan)
+}
+
+fn plan_part(part: &BodyPart, plan: &mut Vec<FetchStep>) -> Option<()> {
+    if part.is_multipart() {
+        plan.push(FetchStep::Header { spec: part.header_spec(), deferred: None });
+        let boundary = part.param("boundary")?;
+        for (i, child) in part.children.iter().enumerate() {
+            let delim = if i == 0 {
+                format!("--{}\r\n", boundary)
+            } else {
+                format!("\r\n--{}\r\n", boundary)
+            };
+            plan.push(FetchStep::Bytes(delim.into_bytes()));
+            plan_part(child, plan)?;
+        }
+        plan.push(FetchStep::Bytes(format!("\r\n--{}--\r\n", boundary).into_bytes()));
+    } else if part.is_displayable() {
+        plan.push(FetchStep::Header { spec: part.header_spec(), deferred: None });
+        plan.push(FetchStep::Body { spec: part.body_spec() });
+    } else {
+        plan.push(FetchStep::Header {
+            spec: part.header_spec(),
+            deferred: Some((part.body_spec(), part.decoded_size())),
+        });
+    }
+    Some(())
+}
+
+/// The parts `plan` leaves out. Each header section in a plan starts one MIME entity, in
+/// stream order, so its position among them is the entity index.
+pub fn deferred_parts(plan: &[FetchStep]) -> Vec<DeferredPart> {
+    plan.iter()
+        .filter_map(|step| match step {
+            FetchStep::Header { deferred, .. } => Some(deferred),
+            _ => None,
+        })
+        .enumerate()
+        .filter_map(|(entity, deferred)| {
+            deferred.as_ref().map(|(section, size)| DeferredPart { entity, section: section.clone(), size: *size })
+        })
+        .collect()
+}
+
+/// Normalise a fetched header section to end in exactly one blank line.
+pub fn finish_header(raw: &[u8]) -> Vec<u8> {
+    let mut end = raw.len();
+    while end > 0 && (raw[end - 1] == b'\r' || raw[end - 1] == b'\n') {
+        end -= 1;
+    }
+    let mut out = Vec::with_capacity(end + 4);
+    out.extend_from_slice(&raw[..end]);
+    if end > 0 {
+        out.extend_from_slice(b"\r\n");
+    }
+    out.extend_from_slice(b"\r\n");
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const MIXED: &str = r#"* 12 FETCH (UID 34 BODYSTRUCTURE ((("TEXT" "PLAIN" ("CHARSET" "utf-8") NIL NIL "QUOTED-PRINTABLE" 120 4 NIL NIL NIL)("TEXT" "HTML" ("CHARSET" "utf-8") NIL NIL "7BIT" 300 10 NIL NIL NIL) "ALTERNATIVE" ("BOUNDARY" "alt") NIL NIL)("IMAGE" "PNG" ("NAME" "logo.png") "<logo@x>" NIL "BASE64" 4000 NIL ("INLINE" ("FILENAME" "logo.png")) NIL)("APPLICATION" "PDF" ("NAME" "a \"b\".pdf") NIL NIL "BASE64" 800000 NIL ("ATTACHMENT" ("FILENAME" "a \"b\".pdf")) NIL) "MIXED" ("BOUNDARY" "mix") NIL NIL))"#;
+
+    #[test]
+    fn parses_nested_multipart() {
+        let root = parse_bodystructure(MIXED).unwrap();
+        assert!(root.is_multipart());
+        assert_eq!(root.media_subtype, "mixed");
+        assert_eq!(root.param("boundary"), Some("mix"));
+        assert_eq!(root.children.len(), 3);
+        let alt = &root.children[0];
+        assert_eq!(alt.section, "1");
+        assert_eq!(alt.media_subtype, "alternative");
+        assert_eq!(alt.children[1].section, "1.2");
+        assert_eq!(alt.children[1].media_subtype, "html");
+        let img = &root.children[1];
+        assert_eq!(img.id.as_deref(), Some("<logo@x>"));
+        assert_eq!(img.disposition.as_deref(), Some("inline"));
+        let pdf = &root.children[2];
+        assert_eq!(pdf.section, "3");
+        assert_eq!(pdf.param("name"), Some("a \"b\".pdf"));
+        assert_eq!(pdf.size, 800000);
+        assert_eq!(pdf.disposition.as_deref(), Some("attachment"));
+        assert!(!pdf.is_displayable());
+        assert!(img.is_displayable());
+    }
+
+    #[test]
+    fn parses_single_part() {
+        let line = r#"* 1 FETCH (BODYSTRUCTURE ("text" "plain" ("charset" "us-ascii") NIL NIL "7bit" 42 2 NIL NIL NIL NIL) UID 7)"#;
+        let root = parse_bodystructure(line).unwrap();
+        assert_eq!(root.section, "");
+        assert_eq!(root.header_spec(), "HEADER");
+        assert_eq!(root.body_spec(), "TEXT");
+        assert_eq!(fetch_plan(&root).unwrap(), whole_message_plan());
+    }
+
+    #[test]
+    fn literal_is_rejected() {
+        let line = "* 1 FETCH (UID 7 BODYSTRUCTURE (\"text\" \"plain\" ({5}";
+        assert!(parse_bodystructure(line).is_none());
+    }
+
+    #[test]
+    fn plan_defers_attachments() {
+        let root = parse_bodystructure(MIXED).unwrap();
+        let plan = fetch_plan(&root).unwrap();
+        let bodies: Vec<&str> = plan
+            .iter()
+            .filter_map(|s| match s {
+                FetchStep::Body { spec } => Some(spec.as_str()),
+                _ => None,
+            })
+            .collect();
+        assert_eq!(bodies, vec!["1.1", "1.2", "2"]);
+        assert!(plan.contains(&FetchStep::Header {
+            spec: "3.MIME".to_string(),
+            deferred: Some(("3".to_string(), 600000)),
+        }));
+        assert_eq!(plan.last(), Some(&FetchStep::Bytes(b"\r\n--mix--\r\n".to_vec())));
+    }
+
+    #[test]
+    fn deferred_parts_are_numbered_by_entity() {
+        let root = parse_bodystructure(MIXED).unwrap();
+        let plan = fetch_plan(&root).unwrap();
+        // mixed, alternative, 1.1, 1.2, 2, then the attachment
+        assert_eq!(
+            deferred_parts(&plan),
+            vec![DeferredPart { entity: 5, section: "3".to_string(), size: 600000 }]
+        );
+        assert!(deferred_parts(&whole_message_plan()).is_empty());
+    }
+
+    #[test]
+    fn finish_header_normalises_the_end() {
+        assert_eq!(
+            finish_header(b"Content-Type: application/pdf\r\n\r\n"),
+            b"Content-Type: application/pdf\r\n\r\n".to_vec()
+        );
+        assert_eq!(finish_header(b"A: b\n"), b"A: b\r\n\r\n".to_vec());
+    }
+}
@@ -21,6 +21,7 @@
 //! Async IMAP client: connect, CAPABILITY, STARTTLS (when advertised, debug flag to skip),
 //! LOGIN/AUTH, LIST, SELECT, FETCH. Pattern follows SMTP client (stateful protocol).
 
+use super::bodystructure::{parse_bodystructure, BodyPart};
 use crate::net::{connect_implicit_tls, connect_plain, PlainStream, TlsStreamWrapper};
 use crate::sasl::{
     initial_client_response, login_respond_to_challenge, respond_to_challenge, SaslError,
@@ -119,19 +120,31 @@ fn parse_line(s: &str) -> ImapLine {
     }
 }
 
-/// Read one line from stream; if line ends with {N}, read N bytes literal and append (as one logical line for parsing we return line + literal separately or combined).
-/// Returns (line_string, literal_data_if_any).
+/// Read one response from stream; if its line ends with {N}, read the N bytes literal and
+/// then the rest of the response, which follows the literal on the wire.
+/// Returns (line_string, literal_data_if_any): the line has the text after the literal
+/// appended after the `{N}`, e.g. `* STATUS {7} (MESSAGES 3)` with literal `foo bar`.
+/// Only the first literal's data is returned; later ones are read and dropped.
 async fn read_imap_line<S>(stream: &mut S, buf: &mut Vec<u8>) -> io::Result<(String, Option<Vec<u8>>)>
 where
     S: AsyncRead + Unpin,
 {
-    let (line, literal_size) = read_imap_line_literal_size(stream, buf).await?;
-    if let Some(n) = literal_size {
+    let (mut line, mut literal_size) = read_imap_line_literal_size(stream, buf).await?;
+    let mut literal = None;
+    while let Some(n) = literal_size {
         let mut lit = vec![0u8; n as usize];
         stream.read_exact(&mut lit).await?;
-        return Ok((line, Some(lit)));
+        if literal.is_none() {
+            literal = Some(lit);
+        }
+        let (rest, rest_literal_size) = read_imap_line_literal_size(stream, buf).await?;
+        if !rest.is_empty() {
+            line.push(' ');
+            line.push_str(&rest);
+        }
+        literal_size = rest_literal_size;
     }
-    Ok((line, None))
+    Ok((line, literal))
 }
 
 /// Read one line; if line ends with {N}, return (line, Some(N)) without reading the N bytes (caller can stream them).
@@ -986,7 +999,7 @@ impl AuthenticatedSession {
 }
 
 /// Result of SELECT (EXISTS, UIDVALIDITY).
-#[derive(Debug)]
+#[derive(Debug, Clone)]
 pub struct SelectResult {
     pub exists: u32,
     pub uid_validity: Option<u32>,
@@ -1015,6 +1028,22 @@ pub struct FetchSummary {
     pub header: Vec<u8>,
 }
 
+/// Whether an untagged response is the FETCH of `BODY[section]` for message `uid`.
+/// Servers may send the UID item after the literal, so it is only checked when present.
+fn is_section_fetch_response(line: &str, uid: u32, section: &str) -> bool {
+    if !line.contains(" FETCH (") || !line.contains(&format!("BODY[{}]", section)) {
+        return false;
+    }
+    match line.find("UID ") {
+        Some(open) => {
+            let rest = &line[open + 4..];
+            let end = rest.find(|c: char| c == ' ' || c == ')').unwrap_or(rest.len());
+            rest[..end].parse() == Ok(uid)
+        }
+        None => true,
+    }
+}
+
 fn parse_fetch_summary(line: &str, literal: Option<&[u8]>) -> Option<FetchSummary> {
     let fetch_part = line.find(" FETCH (")?;
     let seq_str = line[1..fetch_part].trim();
@@ -1068,11 +1097,21 @@ fn parse_list_line(line: &str) -> Option<ListEntry> {
     } else {
         (None, rest)
     };
-    let rest = rest.trim_start();
-    let name = if rest.starts_with('"') {
+    let (name, _) = parse_mailbox_name(rest)?;
+    Some(ListEntry {
+        attributes: attrs,
+        delimiter: delim,
+        name,
+    })
+}
+
+/// Mailbox name (quoted string or atom) at the start of s, and the rest of s after it.
+fn parse_mailbox_name(s: &str) -> Option<(String, &str)> {
+    let s = s.trim_start();
+    if s.starts_with('"') {
         let mut name = String::new();
         let mut i = 1;
-        let bytes = rest.as_bytes();
+        let bytes = s.as_bytes();
         while i < bytes.len() {
             if bytes[i] == b'\\' && i + 1 < bytes.len() {
                 name.push(bytes[i + 1] as char);
@@ -1084,15 +1123,59 @@ fn parse_list_line(line: &str) -> Option<ListEntry> {
                 i += 1;
             }
         }
-        name
+        Some((name, s.get(i + 1..).unwrap_or("")))
     } else {
-        rest.split_whitespace().next()?.to_string()
-    };
-    Some(ListEntry {
-        attributes: attrs,
-        delimiter: delim,
-        name,
-    })
+        let end = s.find(char::is_whitespace).unwrap_or(s.len());
+        if end == 0 {
+            return None;
+        }
+        Some((s[..end].to_string(), &s[end..]))
+    }
+}
+
+/// Parsed STATUS response: `* STATUS mailbox (MESSAGES n UNSEEN m)`.
+#[derive(Debug, Clone)]
+pub struct MailboxStatus {
+    pub name: String,
+    pub messages: Option<u64>,
+    pub unseen: Option<u64>,
+}
+
+fn parse_status_line(line: &str) -> Option<MailboxStatus> {
+    let rest = line.strip_prefix("* STATUS ")?;
+    let (name, rest) = parse_mailbox_name(rest)?;
+    parse_status_items(name, rest)
+}
+
+/// The parenthesized `(MESSAGES n UNSEEN m)` part of a STATUS response, for mailbox name.
+fn parse_status_items(name: String, rest: &str) -> Option<MailboxStatus> {
+    let rest = rest.trim_start().strip_prefix('(')?;
+    let items = &rest[..rest.find(')')?];
+    let mut status = MailboxStatus { name, messages: None, unseen: None };
+    let mut words = items.split_whitespace();
+    while let (Some(item), Some(value)) = (words.next(), words.next()) {
+        let value = value.parse::<u64>().ok();
+        if item.eq_ignore_ascii_case("MESSAGES") {
+            status.messages = value;
+        } else if item.eq_ignore_ascii_case("UNSEEN") {
+            status.unseen = value;
+        }
+    }
+    Some(status)
+}
+
+/// A STATUS response as read by `read_imap_line`. A mailbox name sent as a literal
+/// (`* STATUS {7}` CRLF `foo bar (MESSAGES 3)`) comes as the line `* STATUS {7} (MESSAGES 3)`
+/// with the name as its literal data.
+fn parse_status_response(line: &str, literal: Option<&[u8]>) -> Option<MailboxStatus> {
+    let rest = line.strip_prefix("* STATUS ")?;
+    if let Some(literal) = literal {
+        if rest.starts_with('{') {
+            let items = &rest[rest.find('}')? + 1..];
+            return parse_status_items(String::from_utf8_lossy(literal).into_owned(), items);
+        }
+    }
+    parse_status_line(line)
 }
 
 fn parse_list_attrs(s: &str) -> Option<(Vec<String>, &str)> {
@@ -1112,7 +1195,10 @@ fn parse_list_attrs(s: &str) -> Option<(Vec<String>, &str)> {
 
 /// A pending command awaiting its tagged response.
 struct PendingCommand {
-    /// Called for each untagged response line while this is the active command.
+    /// Recognises untagged responses that belong to this command wherever it is in the
+    /// pipeline (e.g. a FETCH naming its section). None: it only gets them while active.
+    claims: Option<Box<dyn Fn(&str) -> bool + Send>>,
+    /// Called for each untagged response line while this is the active command, or that it claims.
     on_untagged: Box<dyn Fn(&str, Option<&[u8]>) + Send>,
     /// Called once when the matching tagged response arrives (ok, raw_line).
     on_complete: Box<dyn FnOnce(bool, &str) + Send>,
@@ -1141,15 +1227,35 @@ impl ImapConnection {
         command: &str,
         on_untagged: impl Fn(&str, Option<&[u8]>) + Send + 'static,
         on_complete: impl FnOnce(bool, &str) + Send + 'static,
+    ) -> String {
+        self.enqueue(command, None, Box::new(on_untagged), Box::new(on_complete))
+    }
+
+    /// Like `send`, for commands pipelined behind others whose untagged responses can be
+    /// told apart: `claims` picks out this command's responses, so they reach it even if
+    /// the server answers the pipeline out of order.
+    pub fn send_claiming(
+        &self,
+        command: &str,
+        claims: impl Fn(&str) -> bool + Send + 'static,
+        on_untagged: impl Fn(&str, Option<&[u8]>) + Send + 'static,
+        on_complete: impl FnOnce(bool, &str) + Send + 'static,
+    ) -> String {
+        self.enqueue(command, Some(Box::new(claims)), Box::new(on_untagged), Box::new(on_complete))
+    }
+
+    fn enqueue(
+        &self,
+        command: &str,
+        claims: Option<Box<dyn Fn(&str) -> bool + Send>>,
+        on_untagged: Box<dyn Fn(&str, Option<&[u8]>) + Send>,
+        on_complete: Box<dyn FnOnce(bool, &str) + Send>,
     ) -> String {
         let tag = format!("A{:04}", self.tag_counter.fetch_add(1, Ordering::Relaxed));
         let _ = self.command_tx.send(PipelineCommand {
             tag: tag.clone(),
             command: command.to_string(),
-            pending: PendingCommand {
-                on_untagged: Box::new(on_untagged),
-                on_complete: Box::new(on_complete),
-            },
+            pending: PendingCommand { claims, on_untagged, on_complete },
         });
         tag
     }
@@ -1158,6 +1264,11 @@ impl ImapConnection {
     pub fn is_alive(&self) -> bool {
         !self.command_tx.is_closed()
     }
+
+    /// True if both handles drive the same connection.
+    pub fn same_connection(&self, other: &ImapConnection) -> bool {
+        self.command_tx.same_channel(&other.command_tx)
+    }
 }
 
 /// Async pipeline loop: reads from socket and dispatches responses by tag.
@@ -1193,8 +1304,11 @@ where
                     Ok((line_str, literal)) => {
                         let line = parse_line(&line_str);
                         if line.untagged {
-                            // Dispatch to the oldest pending command's on_untagged
-                            if let Some((_, ref p)) = pending.front() {
+                            // Dispatch to the command that claims the response, else the oldest
+                            let claimed = pending
+                                .iter()
+                                .find(|(_, p)| p.claims.as_ref().map_or(false, |c| c(&line_str)));
+                            if let Some((_, p)) = claimed.or(pending.front()) {
                                 (p.on_untagged)(&line_str, literal.as_deref());
                             }
                         } else if let Some(ref tag) = line.tag {
@@ -1328,6 +1442,85 @@ impl ImapConnection {
         );
     }
 
+    /// CAPABILITY: the capabilities the server advertises now (after authentication).
+    pub fn capabilities(
+        &self,
+        on_complete: impl FnOnce(Result<Vec<String>, ImapClientError>) + Send + 'static,
+    ) {
+        let caps: Arc<std::sync::Mutex<Vec<String>>> = Arc::new(std::sync::Mutex::new(Vec::new()));
+        let caps_for_untagged = caps.clone();
+        self.send(
+            "CAPABILITY",
+            move |line, _literal| {
+                if line.starts_with("* CAPABILITY ") {
+                    *caps_for_untagged.lock().unwrap() = parse_capabilities(line);
+                }
+            },
+            move |ok, raw| {
+                if ok {
+                    on_complete(Ok(std::mem::take(&mut *caps.lock().unwrap())));
+                } else {
+                    on_complete(Err(ImapClientError::new(raw.to_string())));
+                }
+            },
+        );
+    }
+
+    /// STATUS mailbox (MESSAGES UNSEEN). Commands for several mailboxes may be sent back to
+    /// back; each reports its own mailbox to on_status.
+    pub fn status(
+        &self,
+        mailbox: &str,
+        on_status: impl Fn(MailboxStatus) + Send + 'static,
+        on_complete: impl FnOnce(Result<(), ImapClientError>) + Send + 'static,
+    ) {
+        let cmd = format!("STATUS {} (MESSAGES UNSEEN)", quote_string(mailbox));
+        self.send(
+            &cmd,
+            move |line, literal| {
+                if let Some(s) = parse_status_response(line, literal) {
+                    on_status(s);
+                }
+            },
+            move |ok, raw| {
+                if ok {
+                    on_complete(Ok(()));
+                } else {
+                    on_complete(Err(ImapClientError::new(raw.to_string())));
+                }
+            },
+        );
+    }
+
+    /// LIST "" "*" RETURN (STATUS (MESSAGES UNSEEN)) (RFC 5819 LIST-STATUS): every folder
+    /// and its counts in one command.
+    pub fn list_status(
+        &self,
+        on_entry: impl Fn(ListEntry) + Send + 'static,
+        on_status: impl Fn(MailboxStatus) + Send + 'static,
+        on_complete: impl FnOnce(Result<(), ImapClientError>) + Send + 'static,
+    ) {
+        self.send(
+            r#"LIST "" "*" RETURN (STATUS (MESSAGES UNSEEN))"#,
+            move |line, literal| {
+                if line.starts_with("* LIST ") {
+                    if let Some(entry) = parse_list_line(line) {
+                        on_entry(entry);
+                    }
+                } else if let Some(s) = parse_status_response(line, literal) {
+                    on_status(s);
+                }
+            },
+            move |ok, raw| {
+                if ok {
+                    on_complete(Ok(()));
+                } else {
+                    on_complete(Err(ImapClientError::new(raw.to_string())));
+                }
+            },
+        );
+    }
+
     /// SELECT mailbox streaming: fires on_event for each untagged response.
     pub fn select_streaming(
         &self,
@@ -1371,6 +1564,30 @@ impl ImapConnection {
         );
     }
 
+    /// NOOP: collects the mailbox updates (EXISTS, RECENT, ...) the server has been holding for
+    /// the selected mailbox, reported as SELECT items.
+    pub fn noop_streaming(
+        &self,
+        on_event: impl Fn(SelectEvent) + Send + 'static,
+        on_complete: impl FnOnce(Result<(), ImapClientError>) + Send + 'static,
+    ) {
+        self.send(
+            "NOOP",
+            move |line, _literal| {
+                if let Some(ev) = parse_select_event(line) {
+                    on_event(ev);
+                }
+            },
+            move |ok, raw| {
+                if ok {
+                    on_complete(Ok(()));
+                } else {
+                    on_complete(Err(ImapClientError::new(raw.to_string())));
+                }
+            },
+        );
+    }
+
     /// FETCH summaries streaming.
     pub fn fetch_summaries_streaming(
         &self,
@@ -1429,6 +1646,69 @@ impl ImapConnection {
         );
     }
 
+    /// UID FETCH BODYSTRUCTURE. Completes with None if the structure could not be parsed.
+    pub fn fetch_bodystructure_by_uid(
+        &self,
+        uid: u32,
+        on_complete: impl FnOnce(Result<Option<BodyPart>, ImapClientError>) + Send + 'static,
+    ) {
+        let cmd = format!("UID FETCH {} (BODYSTRUCTURE)", uid);
+        let structure: Arc<std::sync::Mutex<Option<BodyPart>>> = Arc::new(std::sync::Mutex::new(None));
+        let structure_for_untagged = structure.clone();
+        self.send(
+            &cmd,
+            move |line, _literal| {
+                if line.contains(" FETCH (") {
+                    if let Some(part) = parse_bodystructure(line) {
+                        *structure_for_untagged.lock().unwrap() = Some(part);
+                    }
+                }
+            },
+            move |ok, raw| {
+                if ok {
+                    on_complete(Ok(structure.lock().unwrap().take()));
+                } else {
+                    on_complete(Err(ImapClientError::new(raw.to_string())));
+                }
+            },
+        );
+    }
+
+    /// UID FETCH a single body section (e.g. "HEADER", "TEXT", "2.1", "2.1.MIME").
+    /// With `peek` the \Seen flag is left unchanged. Literal arrives in `on_chunk`.
+    /// The response is matched by UID and section, so several may be pipelined.
+    pub fn fetch_section_by_uid_streaming(
+        &self,
+        uid: u32,
+        section: &str,
+        peek: bool,
+        on_chunk: impl Fn(&[u8]) + Send + 'static,
+        on_complete: impl FnOnce(Result<(), ImapClientError>) + Send + 'static,
+    ) {
+        let item = if peek { "BODY.PEEK" } else { "BODY" };
+        let cmd = format!("UID FETCH {} ({}[{}])", uid, item, section);
+        let section = section.to_string();
+        let section_for_untagged = section.clone();
+        self.send_claiming(
+            &cmd,
+            move |line| is_section_fetch_response(line, uid, &section),
+            move |line, literal| {
+                if is_section_fetch_response(line, uid, &section_for_untagged) {
+                    if let Some(lit) = literal {
+                        on_chunk(lit);
+                    }
+                }
+            },
+            move |ok, raw| {
+                if ok {
+                    on_complete(Ok(()));
+                } else {
+                    on_complete(Err(ImapClientError::new(raw.to_string())));
+                }
+            },
+        );
+    }
+
     /// APPEND raw message bytes to mailbox.
     pub fn append_message(
         &self,
@@ -1524,3 +1804,97 @@ impl ImapConnection {
         });
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn parses_atom_and_quoted_mailbox_names() {
+        assert_eq!(parse_mailbox_name("INBOX (MESSAGES 1)"), Some(("INBOX".to_string(), " (MESSAGES 1)")));
+        let (name, rest) = parse_mailbox_name(r#" "Sent Items" (MESSAGES 1)"#).unwrap();
+        assert_eq!(name, "Sent Items");
+        assert_eq!(rest, " (MESSAGES 1)");
+        let (name, _) = parse_mailbox_name(r#""a \"b\" \\c""#).unwrap();
+        assert_eq!(name, r#"a "b" \c"#);
+        assert_eq!(parse_mailbox_name("   "), None);
+    }
+
+    #[test]
+    fn parses_status_line() {
+        let s = parse_status_line(r#"* STATUS "Sent Items" (MESSAGES 231 UNSEEN 4)"#).unwrap();
+        assert_eq!(s.name, "Sent Items");
+        assert_eq!(s.messages, Some(231));
+        assert_eq!(s.unseen, Some(4));
+        let s = parse_status_line("* STATUS INBOX (UNSEEN 2 MESSAGES 17)").unwrap();
+        assert_eq!(s.name, "INBOX");
+        assert_eq!(s.messages, Some(17));
+        assert_eq!(s.unseen, Some(2));
+    }
+
+    #[test]
+    fn status_attributes_may_be_missing() {
+        let s = parse_status_line("* STATUS INBOX (MESSAGES 5)").unwrap();
+        assert_eq!(s.messages, Some(5));
+        assert_eq!(s.unseen, None);
+        let s = parse_status_line("* STATUS Drafts ()").unwrap();
+        assert_eq!(s.name, "Drafts");
+        assert_eq!(s.messages, None);
+        assert_eq!(s.unseen, None);
+        assert!(parse_status_line("* STATUS INBOX").is_none());
+    }
+
+    #[test]
+    fn parses_literal_mailbox_name() {
+        let s = parse_status_response("* STATUS {7} (MESSAGES 3 UNSEEN 1)", Some(b"foo bar")).unwrap();
+        assert_eq!(s.name, "foo bar");
+        assert_eq!(s.messages, Some(3));
+        assert_eq!(s.unseen, Some(1));
+    }
+
+    #[tokio::test]
+    async fn reads_the_rest_of_a_response_after_its_literal() {
+        let mut stream: &[u8] = b"* STATUS {7}\r\nfoo bar (MESSAGES 3 UNSEEN 1)\r\n\
+            * 1 FETCH (BODY[HEADER] {4}\r\nab\r\n UID 9)\r\n\
+            A1 OK done\r\n";
+        let mut buf = Vec::new();
+        let (line, literal) = read_imap_line(&mut stream, &mut buf).await.unwrap();
+        assert_eq!(line, "* STATUS {7} (MESSAGES 3 UNSEEN 1)");
+        let s = parse_status_response(&line, literal.as_deref()).unwrap();
+        assert_eq!(s.name, "foo bar");
+        assert_eq!(s.messages, Some(3));
+        assert_eq!(s.unseen, Some(1));
+        let (line, literal) = read_imap_line(&mut stream, &mut buf).await.unwrap();
+        assert_eq!(line, "* 1 FETCH (BODY[HEADER] {4} UID 9)");
+        assert_eq!(literal.as_deref(), Some(&b"ab\r\n"[..]));
+        let (line, literal) = read_imap_line(&mut stream, &mut buf).await.unwrap();
+        assert_eq!(line, "A1 OK done");
+        assert!(literal.is_none());
+    }
+
+    #[test]
+    fn picks_status_out_of_other_untagged_responses() {
+        let lines: [(&str, Option<&[u8]>); 5] = [
+            (r#"* LIST (\HasNoChildren) "/" "Sent Items""#, None),
+            (r#"* STATUS "Sent Items" (MESSAGES 10 UNSEEN 0)"#, None),
+            ("* 3 EXISTS", None),
+            ("* STATUS {4} (MESSAGES 7)", Some(b"a(b)")),
+            ("* OK [UNSEEN 1] still here", None),
+        ];
+        let found: Vec<MailboxStatus> =
+            lines.iter().filter_map(|(line, literal)| parse_status_response(line, *literal)).collect();
+        assert_eq!(found.len(), 2);
+        assert_eq!(found[0].name, "Sent Items");
+        assert_eq!(found[0].messages, Some(10));
+        assert_eq!(found[0].unseen, Some(0));
+        assert_eq!(found[1].name, "a(b)");
+        assert_eq!(found[1].messages, Some(7));
+        assert_eq!(found[1].unseen, None);
+    }
+
+    #[test]
+    fn literal_name_without_status_items_is_ignored() {
+        assert!(parse_status_response("* STATUS {3}", Some(b"abc")).is_none());
+        assert!(parse_status_response("* 4 EXISTS", None).is_none());
+    }
+}
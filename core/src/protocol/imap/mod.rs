@@ -23,21 +23,26 @@
 //!
 //! All trait methods are fully callback-driven and return immediately.
 
+mod bodystructure;
 mod client;
 
 pub use client::{
     connect_and_authenticate, connect_and_start_pipeline, AuthenticatedSession, FetchSummary,
-    ImapClientError, ImapConnection, ImapLine, ImapLineWithLiteral, ListEntry, SelectEvent,
-    SelectResult,
+    ImapClientError, ImapConnection, ImapLine, ImapLineWithLiteral, ListEntry, MailboxStatus,
+    SelectEvent, SelectResult,
 };
+pub use bodystructure::{parse_bodystructure, BodyPart};
+
+use bodystructure::{deferred_parts, fetch_plan, finish_header, header_spec_for_section, whole_message_plan, FetchStep};
 
 use crate::message_id::{imap_message_id, MessageId};
 use crate::mime::{parse_envelope, parse_thread_headers, EmailAddress, EnvelopeHeaders};
-use crate::store::{Address, ConversationSummary, DateTime, Envelope, Flag};
-use crate::store::{Folder, FolderInfo, OpenFolderEvent, Store, StoreError, StoreKind};
+use crate::store::{Address, ConversationSummary, DateTime, DeferredPart, Envelope, Flag};
+use crate::store::{Folder, FolderInfo, FolderStatus, OpenFolderEvent, Store, StoreError, StoreKind};
 use crate::store::{ThreadId, ThreadSummary};
 use crate::sasl::SaslMechanism;
 use std::ops::Range;
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::{Arc, Mutex, RwLock};
 
 /// IMAP delete mode: how the delete button works for IMAP folders.
@@ -61,6 +66,8 @@ struct ImapStoreState {
     runtime_handle: tokio::runtime::Handle,
     /// Live connection to the IMAP server (pipeline task).
     connection: Mutex<Option<ImapConnection>>,
+    /// Second connection for folder status polling, and whether it supports LIST-STATUS.
+    status_connection: Mutex<Option<(ImapConnection, bool)>>,
     /// Cached hierarchy delimiter from LIST responses.
     cached_delimiter: Mutex<Option<char>>,
     /// Registered callbacks for folder list events.
@@ -69,6 +76,20 @@ struct ImapStoreState {
     delete_mode: RwLock<ImapDeleteMode>,
     /// Trash folder name for move-to-trash deletion (e.g. "Trash").
     trash_folder: RwLock<String>,
+    /// SELECT made by warm_up, for the first open_folder to reuse.
+    warm_selection: Mutex<Option<WarmSelection>>,
+    /// SELECTs sent on the main connection; a warm-up selection is stale once another follows it.
+    selects: AtomicU64,
+}
+
+/// A mailbox selected by warm_up: its SELECT items, replayed to whoever opens it.
+struct WarmSelection {
+    mailbox: String,
+    connection: ImapConnection,
+    /// Value of `selects` when the SELECT was sent.
+    select_number: u64,
+    events: Vec<SelectEvent>,
+    result: SelectResult,
 }
 
 /// Internal folder list callbacks stored in ImapStoreState.
@@ -87,7 +108,98 @@ impl ImapStoreState {
                 return Ok(conn.clone());
             }
         }
-        // Need to connect: build auth and spawn the pipeline
+        let conn = self.connect()?;
+        *guard = Some(conn.clone());
+        Ok(conn)
+    }
+
+    /// Open the main connection if there is none and select `mailbox` on it. The SELECT is
+    /// queued before the connection is published, so it cannot land after a folder the user
+    /// opened meanwhile; if a connection already exists there is nothing to do. The selection
+    /// is kept for open_folder, which then need not SELECT again.
+    fn warm_up(self: &Arc<Self>, mailbox: &str, on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>) {
+        let mut guard = match self.connection.lock() {
+            Ok(g) => g,
+            Err(e) => {
+                on_complete(Err(StoreError::new(e.to_string())));
+                return;
+            }
+        };
+        if let Some(ref conn) = *guard {
+            if conn.is_alive() {
+                drop(guard);
+                on_complete(Ok(()));
+                return;
+            }
+        }
+        let conn = match self.connect() {
+            Ok(c) => c,
+            Err(e) => {
+                drop(guard);
+                on_complete(Err(e));
+                return;
+            }
+        };
+        let select_number = self.selects.fetch_add(1, Ordering::SeqCst) + 1;
+        let events: Arc<Mutex<Vec<SelectEvent>>> = Arc::new(Mutex::new(Vec::new()));
+        let events_for_select = events.clone();
+        let state = Arc::clone(self);
+        let mailbox_owned = mailbox.to_string();
+        let conn_for_selection = conn.clone();
+        conn.select_streaming(
+            mailbox,
+            move |ev| events_for_select.lock().unwrap().push(ev),
+            move |result| match result {
+                Ok(result) => {
+                    *state.warm_selection.lock().unwrap() = Some(WarmSelection {
+                        mailbox: mailbox_owned,
+                        connection: conn_for_selection,
+                        select_number,
+                        events: std::mem::take(&mut *events.lock().unwrap()),
+                        result,
+                    });
+                    on_complete(Ok(()));
+                }
+                Err(e) => on_complete(Err(StoreError::new(e.to_string()))),
+            },
+        );
+        *guard = Some(conn);
+    }
+
+    /// The warm-up selection of `mailbox`, if it is still the selected mailbox of `conn`.
+    /// Either way the caller is about to select: later calls get nothing.
+    fn take_warm_selection(&self, mailbox: &str, conn: &ImapConnection) -> Option<WarmSelection> {
+        let warm = self.warm_selection.lock().unwrap().take();
+        let last_select = self.selects.fetch_add(1, Ordering::SeqCst);
+        warm.filter(|w| {
+            w.mailbox == mailbox && w.select_number == last_select && w.connection.same_connection(conn)
+        })
+    }
+
+    /// Like ensure_connection, for the status polling connection. Also reports whether the
+    /// server supports LIST-STATUS (asked once per connection).
+    fn ensure_status_connection(&self) -> Result<(ImapConnection, bool), StoreError> {
+        let mut guard = self.status_connection.lock().map_err(|e| StoreError::new(e.to_string()))?;
+        if let Some((ref conn, list_status)) = *guard {
+            if conn.is_alive() {
+                return Ok((conn.clone(), list_status));
+            }
+        }
+        let conn = self.connect()?;
+        let (tx, rx) = tokio::sync::oneshot::channel();
+        conn.capabilities(move |result| {
+            let _ = tx.send(result);
+        });
+        let list_status = match self.runtime_handle.block_on(rx) {
+            Ok(Ok(caps)) => caps.iter().any(|c| c == "LIST-STATUS"),
+            _ => false,
+        };
+        *guard = Some((conn.clone(), list_status));
+        Ok((conn, list_status))
+    }
+
+    /// Connect, authenticate and spawn a pipeline task.
+    fn connect(&self) -> Result<ImapConnection, StoreError> {
         let host = self.host.clone();
         let port = self.port;
         let use_implicit_tls = *self.use_implicit_tls.read().map_err(|e| StoreError::new(e.to_string()))?;
@@ -103,7 +215,7 @@ impl ImapStoreState {
         // Use block_on on the shared runtime to connect and authenticate.
         // This is called from the FFI layer (UI thread) but only once per store
         // when the connection needs to be established.
-        let conn = self.runtime_handle.block_on(async move {
+        self.runtime_handle.block_on(async move {
             connect_and_start_pipeline(
                 &host,
                 port,
@@ -113,9 +225,7 @@ impl ImapStoreState {
             )
             .await
             .map_err(|e| StoreError::new(e.to_string()))
-        })?;
-        *guard = Some(conn.clone());
-        Ok(conn)
+        })
     }
 }
 
@@ -142,10 +252,13 @@ impl ImapStore {
             username: RwLock::new(String::new()),
             runtime_handle: handle,
             connection: Mutex::new(None),
+            status_connection: Mutex::new(None),
             cached_delimiter: Mutex::new(None),
             folder_list_callbacks: RwLock::new(None),
             delete_mode: RwLock::new(ImapDeleteMode::MoveToTrash),
             trash_folder: RwLock::new("Trash".to_string()),
+            warm_selection: Mutex::new(None),
+            selects: AtomicU64::new(0),
         };
         Self {
             state: Arc::new(state),
@@ -254,10 +367,13 @@ impl Store for ImapStore {
             token.to_string(),
             SaslMechanism::XOAuth2,
         ));
-        // Drop stale connection so next operation reconnects with the new token.
+        // Drop stale connections so next operation reconnects with the new token.
         if let Ok(mut guard) = self.state.connection.lock() {
             *guard = None;
         }
+        if let Ok(mut guard) = self.state.status_connection.lock() {
+            *guard = None;
+        }
     }
 
     fn list_folders(
@@ -296,6 +412,91 @@ impl Store for ImapStore {
         );
     }
 
+    fn poll_folder_status(
+        &self,
+        on_status: Box<dyn Fn(FolderStatus) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        let (conn, list_status) = match self.state.ensure_status_connection() {
+            Ok(c) => c,
+            Err(e) => {
+                on_complete(Err(e));
+                return;
+            }
+        };
+        let on_status: Arc<dyn Fn(FolderStatus) + Send + Sync> = Arc::from(on_status);
+        let report = move |s: MailboxStatus| {
+            if let Some(total) = s.messages {
+                on_status(FolderStatus {
+                    name: s.name,
+                    total,
+                    unread: s.unseen.unwrap_or(0),
+                });
+            }
+        };
+        if list_status {
+            conn.list_status(
+                |_| {},
+                report,
+                move |result| {
+                    on_complete(result.map_err(|e| StoreError::new(e.to_string())));
+                },
+            );
+            return;
+        }
+        // No LIST-STATUS: list, then send one STATUS per selectable folder without waiting
+        // for each reply, so the whole round costs about two round trips.
+        let names: Arc<Mutex<Vec<String>>> = Arc::new(Mutex::new(Vec::new()));
+        let names_for_entry = Arc::clone(&names);
+        let status_conn = conn.clone();
+        conn.list_folders_streaming(
+            move |entry| {
+                let unselectable = entry.attributes.iter().any(|a| {
+                    a.eq_ignore_ascii_case("\\Noselect") || a.eq_ignore_ascii_case("\\NonExistent")
+                });
+                if !unselectable {
+                    names_for_entry.lock().unwrap().push(entry.name);
+                }
+            },
+            move |result| {
+                if let Err(e) = result {
+                    on_complete(Err(StoreError::new(e.to_string())));
+                    return;
+                }
+                let names = std::mem::take(&mut *names.lock().unwrap());
+                if names.is_empty() {
+                    on_complete(Ok(()));
+                    return;
+                }
+                let report = Arc::new(report);
+                let remaining = Arc::new(std::sync::atomic::AtomicUsize::new(names.len()));
+                let on_complete = Arc::new(Mutex::new(Some(on_complete)));
+                for name in &names {
+                    let report = Arc::clone(&report);
+                    let remaining = Arc::clone(&remaining);
+                    let on_complete = Arc::clone(&on_complete);
+                    let alive_conn = status_conn.clone();
+                    // A folder that cannot be examined is skipped; only a lost connection fails the round
+                    status_conn.status(name, move |s| report(s), move |_| {
+                        if remaining.fetch_sub(1, std::sync::atomic::Ordering::AcqRel) == 1 {
+                            if let Some(cb) = on_complete.lock().unwrap().take() {
+                                cb(if alive_conn.is_alive() {
+                                    Ok(())
+                                } else {
+                                    Err(StoreError::new("connection lost"))
+                                });
+                            }
+                        }
+                    });
+                }
+            },
+        );
+    }
+
+    fn warm_up(&self, on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>) {
+        self.state.warm_up("INBOX", on_complete);
+    }
+
     fn open_folder(
         &self,
         name: &str,
@@ -329,20 +530,54 @@ impl Store for ImapStore {
             format!("{}@{}", username, host)
         };
 
+        let on_event = move |ev: SelectEvent| {
+            let open_ev = match ev {
+                SelectEvent::Exists(n) => OpenFolderEvent::Exists(n),
+                SelectEvent::Recent(n) => OpenFolderEvent::Recent(n),
+                SelectEvent::Flags(f) => OpenFolderEvent::Flags(f),
+                SelectEvent::UidValidity(n) => OpenFolderEvent::UidValidity(n),
+                SelectEvent::UidNext(n) => OpenFolderEvent::UidNext(n),
+                SelectEvent::PermanentFlags(f) => OpenFolderEvent::Flags(f),
+                SelectEvent::Other(s) => OpenFolderEvent::Other(s),
+            };
+            on_event(open_ev);
+        };
+
+        if let Some(warm) = self.state.take_warm_selection(name, &conn) {
+            // Already selected by warm_up: replay its items, then NOOP for what arrived since.
+            for ev in warm.events {
+                on_event(ev);
+            }
+            let exists = Arc::new(std::sync::atomic::AtomicU32::new(warm.result.exists));
+            let exists_for_noop = Arc::clone(&exists);
+            conn.noop_streaming(
+                move |ev| {
+                    if let SelectEvent::Exists(n) = ev {
+                        exists_for_noop.store(n, Ordering::SeqCst);
+                    }
+                    on_event(ev);
+                },
+                move |result| match result {
+                    Ok(()) => {
+                        let folder = Box::new(ImapFolder {
+                            state,
+                            user_at_host,
+                            mailbox: name_owned,
+                            exists: exists.load(Ordering::SeqCst),
+                        }) as Box<dyn Folder>;
+                        on_complete(Ok(folder));
+                    }
+                    Err(e) => {
+                        on_complete(Err(StoreError::new(e.to_string())));
+                    }
+                },
+            );
+            return;
+        }
+
         conn.select_streaming(
             name,
-            move |ev| {
-                let open_ev = match ev {
-                    SelectEvent::Exists(n) => OpenFolderEvent::Exists(n),
-                    SelectEvent::Recent(n) => OpenFolderEvent::Recent(n),
-                    SelectEvent::Flags(f) => OpenFolderEvent::Flags(f),
-                    SelectEvent::UidValidity(n) => OpenFolderEvent::UidValidity(n),
-                    SelectEvent::UidNext(n) => OpenFolderEvent::UidNext(n),
-                    SelectEvent::PermanentFlags(f) => OpenFolderEvent::Flags(f),
-                    SelectEvent::Other(s) => OpenFolderEvent::Other(s),
-                };
-                on_event(open_ev);
-            },
+            on_event,
             move |result| {
                 match result {
                     Ok(select_result) => {
@@ -623,6 +858,75 @@ impl Folder for ImapFolder {
         );
     }
 
+    /// Structure-first fetch: BODYSTRUCTURE, then the header, part headers, and the bodies
+    /// of displayable parts only. Attachment bodies are deferred to `get_message_part`.
+    fn get_message_for_display(
+        &self,
+        id: &MessageId,
+        on_metadata: Box<dyn Fn(Envelope) + Send + Sync>,
+        on_deferred_parts: Box<dyn FnOnce(Vec<DeferredPart>) + Send>,
+        on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        let uid = match parse_uid_from_imap_id(id) {
+            Some(u) => u,
+            None => {
+                on_complete(Err(StoreError::new("invalid message id")));
+                return;
+            }
+        };
+        let conn = match self.state.ensure_connection() {
+            Ok(c) => c,
+            Err(e) => {
+                on_complete(Err(e));
+                return;
+            }
+        };
+        let conn_for_plan = conn.clone();
+        conn.fetch_bodystructure_by_uid(uid, move |result| {
+            let plan = match result {
+                Ok(structure) => structure
+                    .as_ref()
+                    .and_then(fetch_plan)
+                    .unwrap_or_else(whole_message_plan),
+                Err(e) => {
+                    on_complete(Err(StoreError::new(e.to_string())));
+                    return;
+                }
+            };
+            on_deferred_parts(deferred_parts(&plan));
+            run_fetch_plan(&conn_for_plan, uid, plan, true, Some(on_metadata), on_content_chunk, on_complete);
+        });
+    }
+
+    fn get_message_part(
+        &self,
+        id: &MessageId,
+        section: &str,
+        on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        let uid = match parse_uid_from_imap_id(id) {
+            Some(u) => u,
+            None => {
+                on_complete(Err(StoreError::new("invalid message id")));
+                return;
+            }
+        };
+        let conn = match self.state.ensure_connection() {
+            Ok(c) => c,
+            Err(e) => {
+                on_complete(Err(e));
+                return;
+            }
+        };
+        let plan = vec![
+            FetchStep::Header { spec: header_spec_for_section(section), deferred: None },
+            FetchStep::Body { spec: section.to_string() },
+        ];
+        run_fetch_plan(&conn, uid, plan, false, None, on_content_chunk, on_complete);
+    }
+
     fn delete_message(
         &self,
         id: &MessageId,
@@ -1021,6 +1325,164 @@ impl Folder for ImapFolder {
     }
 }
 
+/// Puts the output of pipelined fetch steps back in plan order, whatever order the
+/// responses come in: the step being emitted streams straight through, later steps are
+/// held until every step before them has finished.
+struct PlanAssembler {
+    emit: Box<dyn Fn(&[u8]) + Send + Sync>,
+    next: usize,
+    done: Vec<bool>,
+    held: Vec<Vec<u8>>,
+    remaining: usize,
+    error: Option<String>,
+}
+
+impl PlanAssembler {
+    fn new(steps: usize, emit: Box<dyn Fn(&[u8]) + Send + Sync>) -> Self {
+        PlanAssembler {
+            emit,
+            next: 0,
+            done: vec![false; steps],
+            held: vec![Vec::new(); steps],
+            remaining: steps,
+            error: None,
+        }
+    }
+
+    fn write(&mut self, step: usize, bytes: &[u8]) {
+        if bytes.is_empty() {
+            return;
+        }
+        if step == self.next {
+            (self.emit)(bytes);
+        } else {
+            self.held[step].extend_from_slice(bytes);
+        }
+    }
+
+    /// Step finished; returns true when it was the last one outstanding.
+    fn finish(&mut self, step: usize, result: Result<(), ImapClientError>) -> bool {
+        if let Err(e) = result {
+            self.error.get_or_insert(e.to_string());
+        }
+        self.done[step] = true;
+        self.remaining -= 1;
+        while self.next < self.done.len() && self.done[self.next] {
+            self.next += 1;
+            if self.next < self.held.len() {
+                let held = std::mem::take(&mut self.held[self.next]);
+                if !held.is_empty() {
+                    (self.emit)(&held);
+                }
+            }
+        }
+        self.remaining == 0
+    }
+}
+
+/// Pipeline every fetch in `plan` at once and emit the results in plan order.
+/// Each response is matched to its fetch by UID and section, and `PlanAssembler` orders the
+/// output, so the server may answer in any order. The first header fetch supplies the
+/// envelope; with `mark_seen` it is fetched without PEEK so the message is flagged \Seen
+/// as with BODY[].
+fn run_fetch_plan(
+    conn: &ImapConnection,
+    uid: u32,
+    plan: Vec<FetchStep>,
+    mark_seen: bool,
+    on_metadata: Option<Box<dyn Fn(Envelope) + Send + Sync>>,
+    on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync>,
+    on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+) {
+    let mut steps: Vec<(Vec<u8>, FetchStep)> = Vec::new();
+    let mut pending: Vec<u8> = Vec::new();
+    for step in plan {
+        match step {
+            FetchStep::Bytes(b) => pending.extend_from_slice(&b),
+            other => steps.push((std::mem::take(&mut pending), other)),
+        }
+    }
+    let trailer = Arc::new(pending);
+    if steps.is_empty() {
+        on_content_chunk(&trailer);
+        on_complete(Ok(()));
+        return;
+    }
+    let assembler = Arc::new(Mutex::new(PlanAssembler::new(steps.len(), on_content_chunk)));
+    let on_metadata = Arc::new(Mutex::new(on_metadata));
+    let on_complete = Arc::new(Mutex::new(Some(on_complete)));
+    for (i, (prefix, step)) in steps.into_iter().enumerate() {
+        let on_complete = on_complete.clone();
+        let trailer = trailer.clone();
+        // Shared tail for every step: the last one to finish ends the stream.
+        let finish = move |assembler: &mut PlanAssembler, result: Result<(), ImapClientError>| {
+            if !assembler.finish(i, result) {
+                return;
+            }
+            if !trailer.is_empty() {
+                (assembler.emit)(&trailer);
+            }
+            if let Some(cb) = on_complete.lock().unwrap().take() {
+                cb(match assembler.error.take() {
+                    Some(e) => Err(StoreError::new(e)),
+                    None => Ok(()),
+                });
+            }
+        };
+        match step {
+            FetchStep::Header { spec, .. } => {
+                let buf = Arc::new(Mutex::new(Vec::new()));
+                let buf_for_chunk = buf.clone();
+                let on_metadata = if i == 0 { on_metadata.lock().unwrap().take() } else { None };
+                let assembler = assembler.clone();
+                conn.fetch_section_by_uid_streaming(
+                    uid,
+                    &spec,
+                    !(mark_seen && i == 0),
+                    move |chunk| buf_for_chunk.lock().unwrap().extend_from_slice(chunk),
+                    move |result| {
+                        let raw = std::mem::take(&mut *buf.lock().unwrap());
+                        // Step 0 is emitted first, so the envelope precedes any content
+                        if let Some(on_metadata) = on_metadata {
+                            on_metadata(envelope_from_raw(&raw).unwrap_or_else(|_| default_envelope()));
+                        }
+                        let mut assembler = assembler.lock().unwrap();
+                        assembler.write(i, &prefix);
+                        assembler.write(i, &finish_header(&raw));
+                        finish(&mut assembler, result);
+                    },
+                );
+            }
+            FetchStep::Body { spec } => {
+                let prefix = Arc::new(Mutex::new(Some(prefix)));
+                let prefix_for_chunk = prefix.clone();
+                let assembler_for_chunk = assembler.clone();
+                let assembler = assembler.clone();
+                conn.fetch_section_by_uid_streaming(
+                    uid,
+                    &spec,
+                    true,
+                    move |chunk| {
+                        let mut assembler = assembler_for_chunk.lock().unwrap();
+                        if let Some(p) = prefix_for_chunk.lock().unwrap().take() {
+                            assembler.write(i, &p);
+                        }
+                        assembler.write(i, chunk);
+                    },
+                    move |result| {
+                        let mut assembler = assembler.lock().unwrap();
+                        if let Some(p) = prefix.lock().unwrap().take() {
+                            assembler.write(i, &p);
+                        }
+                        finish(&mut assembler, result);
+                    },
+                );
+            }
+            FetchStep::Bytes(_) => unreachable!(),
+        }
+    }
+}
+
 fn parse_uid_from_imap_id(id: &MessageId) -> Option<u32> {
     let s = id.as_str();
     let rest = s.strip_prefix("imap://")?;
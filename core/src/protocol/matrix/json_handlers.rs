@@ -31,6 +31,7 @@ use super::types::{
     DeviceKeysResponse, KeyClaimResult, KeyQueryResult,
     KeyUploadCounts, LoginResponse, Profile, RoomEvent, RoomSummary, WellKnown,
     EVENT_ROOM_AVATAR, EVENT_ROOM_ENCRYPTED, EVENT_ROOM_MESSAGE, EVENT_ROOM_NAME, EVENT_ROOM_TOPIC,
+    REL_TYPE_REPLACE,
 };
 use std::collections::HashMap;
 
@@ -377,12 +378,67 @@ struct EventFields {
     session_id: Option<String>,
     ciphertext: Option<String>,
     device_id: Option<String>,
+    /// `m.relates_to` of the content: relation type and related event
+    rel_type: Option<String>,
+    relates_to: Option<String>,
+    /// Body inside `m.new_content`: the replacement text of an edit
+    new_body: Option<String>,
+    /// Depth of the `m.new_content` object while inside it, else 0
+    new_content_depth: usize,
 }
 
 impl EventFields {
     fn reset(&mut self) {
         *self = Self::default();
     }
+
+    /// An object starts at `depth` inside the event content, under `key`.
+    fn content_object_start(&mut self, key: Option<&str>, depth: usize) {
+        if key == Some("m.new_content") {
+            self.new_content_depth = depth;
+        }
+    }
+
+    /// An object at `depth` inside the event content ends.
+    fn content_object_end(&mut self, depth: usize) {
+        if self.new_content_depth == depth {
+            self.new_content_depth = 0;
+        }
+    }
+
+    /// A string value inside the event content.
+    fn content_string(&mut self, key: Option<&str>, value: &str) {
+        if self.new_content_depth > 0 {
+            if key == Some("body") {
+                self.new_body = Some(value.to_string());
+            }
+            return;
+        }
+        match key {
+            Some("body") => self.body = Some(value.to_string()),
+            Some("msgtype") => self.msgtype = Some(value.to_string()),
+            Some("url") => self.url = Some(value.to_string()),
+            Some("algorithm") => self.algorithm = Some(value.to_string()),
+            Some("sender_key") => self.sender_key = Some(value.to_string()),
+            Some("session_id") => self.session_id = Some(value.to_string()),
+            Some("ciphertext") => self.ciphertext = Some(value.to_string()),
+            Some("device_id") => self.device_id = Some(value.to_string()),
+            Some("rel_type") => self.rel_type = Some(value.to_string()),
+            Some("event_id") => self.relates_to = Some(value.to_string()),
+            _ => {}
+        }
+    }
+
+    /// The event an edit replaces (`rel_type` `m.replace`), and the body to show: the
+    /// replacement text rather than the "* ..." fallback.
+    fn take_replaces_and_body(&mut self) -> (Option<String>, Option<String>) {
+        if self.rel_type.as_deref() == Some(REL_TYPE_REPLACE) {
+            if let Some(replaces) = self.relates_to.take() {
+                return (Some(replaces), self.new_body.take().or_else(|| self.body.take()));
+            }
+        }
+        (None, self.body.take())
+    }
 }
 
 impl SyncResponseHandler {
@@ -469,12 +525,13 @@ impl SyncResponseHandler {
         // Emit timeline message events (both plaintext and encrypted)
         if event_type == EVENT_ROOM_MESSAGE || event_type == EVENT_ROOM_ENCRYPTED {
             if let Some(event_id) = self.event_fields.event_id.take() {
+                let (replaces, body) = self.event_fields.take_replaces_and_body();
                 let event = RoomEvent {
                     event_id,
                     event_type,
                     sender: self.event_fields.sender.take().unwrap_or_default(),
                     origin_server_ts: self.event_fields.origin_server_ts,
-                    body: self.event_fields.body.take(),
+                    body,
                     msgtype: self.event_fields.msgtype.take(),
                     url: self.event_fields.url.take(),
                     room_id,
@@ -483,6 +540,7 @@ impl SyncResponseHandler {
                     session_id: self.event_fields.session_id.take(),
                     ciphertext: self.event_fields.ciphertext.take(),
                     device_id: self.event_fields.device_id.take(),
+                    replaces,
                 };
                 (self.on_event)(event);
             }
@@ -563,6 +621,9 @@ impl JsonContentHandler for SyncResponseHandler {
         }
 
         // "content" at depth 7 inside an event
+        if self.in_content && self.depth > self.event_content_depth {
+            self.event_fields.content_object_start(self.current_key.as_deref(), self.depth);
+        }
         if self.depth == 7 && self.in_events_array && self.current_key.as_deref() == Some("content") {
             self.in_content = true;
             self.event_content_depth = self.depth;
@@ -596,9 +657,11 @@ impl JsonContentHandler for SyncResponseHandler {
             self.in_to_device = false;
         }
 
-        // Leaving "content"
+        // Leaving "content", or an object inside it
         if self.in_content && self.depth == self.event_content_depth {
             self.in_content = false;
+        } else if self.in_content {
+            self.event_fields.content_object_end(self.depth);
         }
 
         // End of an event object at depth 6
@@ -742,19 +805,11 @@ impl JsonContentHandler for SyncResponseHandler {
             }
         }
 
-        // Content fields at depth 7
+        // Content fields at depth 7 (room name and topic state events keep theirs in body)
         if self.in_content {
             match self.current_key.as_deref() {
-                Some("body") | Some("name") => self.event_fields.body = Some(value.to_string()),
-                Some("msgtype") => self.event_fields.msgtype = Some(value.to_string()),
-                Some("url") => self.event_fields.url = Some(value.to_string()),
-                Some("topic") => self.event_fields.body = Some(value.to_string()),
-                Some("algorithm") => self.event_fields.algorithm = Some(value.to_string()),
-                Some("sender_key") => self.event_fields.sender_key = Some(value.to_string()),
-                Some("session_id") => self.event_fields.session_id = Some(value.to_string()),
-                Some("ciphertext") => self.event_fields.ciphertext = Some(value.to_string()),
-                Some("device_id") => self.event_fields.device_id = Some(value.to_string()),
-                _ => {}
+                Some("name") | Some("topic") => self.event_fields.body = Some(value.to_string()),
+                key => self.event_fields.content_string(key, value),
             }
         }
 
@@ -852,12 +907,13 @@ impl RoomMessagesHandler {
         if let (Some(event_id), Some(event_type)) =
             (self.event_fields.event_id.take(), self.event_fields.event_type.take())
         {
+            let (replaces, body) = self.event_fields.take_replaces_and_body();
             let event = RoomEvent {
                 event_id,
                 event_type,
                 sender: self.event_fields.sender.take().unwrap_or_default(),
                 origin_server_ts: self.event_fields.origin_server_ts,
-                body: self.event_fields.body.take(),
+                body,
                 msgtype: self.event_fields.msgtype.take(),
                 url: self.event_fields.url.take(),
                 room_id: self.room_id.clone(),
@@ -866,6 +922,7 @@ impl RoomMessagesHandler {
                 session_id: self.event_fields.session_id.take(),
                 ciphertext: self.event_fields.ciphertext.take(),
                 device_id: self.event_fields.device_id.take(),
+                replaces,
             };
             (self.on_event)(event);
         }
@@ -879,6 +936,9 @@ impl JsonContentHandler for RoomMessagesHandler {
         if self.in_chunk && self.depth == 2 {
             self.event_fields.reset();
         }
+        if self.in_content && self.depth > 3 {
+            self.event_fields.content_object_start(self.current_key.as_deref(), self.depth);
+        }
         if self.in_chunk && self.depth == 3 && self.current_key.as_deref() == Some("content") {
             self.in_content = true;
         }
@@ -887,6 +947,8 @@ impl JsonContentHandler for RoomMessagesHandler {
     fn end_object(&mut self) {
         if self.in_content && self.depth == 3 {
             self.in_content = false;
+        } else if self.in_content {
+            self.event_fields.content_object_end(self.depth);
         }
         if self.in_chunk && self.depth == 2 {
             self.emit_event();
@@ -929,17 +991,7 @@ impl JsonContentHandler for RoomMessagesHandler {
         }
 
         if self.in_content {
-            match self.current_key.as_deref() {
-                Some("body") => self.event_fields.body = Some(value.to_string()),
-                Some("msgtype") => self.event_fields.msgtype = Some(value.to_string()),
-                Some("url") => self.event_fields.url = Some(value.to_string()),
-                Some("algorithm") => self.event_fields.algorithm = Some(value.to_string()),
-                Some("sender_key") => self.event_fields.sender_key = Some(value.to_string()),
-                Some("session_id") => self.event_fields.session_id = Some(value.to_string()),
-                Some("ciphertext") => self.event_fields.ciphertext = Some(value.to_string()),
-                Some("device_id") => self.event_fields.device_id = Some(value.to_string()),
-                _ => {}
-            }
+            self.event_fields.content_string(self.current_key.as_deref(), value);
         }
 
         self.current_key = None;
@@ -986,6 +1038,9 @@ impl SingleEventHandler {
 impl JsonContentHandler for SingleEventHandler {
     fn start_object(&mut self) {
         self.depth += 1;
+        if self.in_content && self.depth > 2 {
+            self.event_fields.content_object_start(self.current_key.as_deref(), self.depth);
+        }
         if self.depth == 2 && self.current_key.as_deref() == Some("content") {
             self.in_content = true;
         }
@@ -994,17 +1049,20 @@ impl JsonContentHandler for SingleEventHandler {
     fn end_object(&mut self) {
         if self.in_content && self.depth == 2 {
             self.in_content = false;
+        } else if self.in_content {
+            self.event_fields.content_object_end(self.depth);
         }
         if self.depth == 1 {
             if let (Some(event_id), Some(event_type)) =
                 (self.event_fields.event_id.take(), self.event_fields.event_type.take())
             {
+                let (replaces, body) = self.event_fields.take_replaces_and_body();
                 let event = RoomEvent {
                     event_id,
                     event_type,
                     sender: self.event_fields.sender.take().unwrap_or_default(),
                     origin_server_ts: self.event_fields.origin_server_ts,
-                    body: self.event_fields.body.take(),
+                    body,
                     msgtype: self.event_fields.msgtype.take(),
                     url: self.event_fields.url.take(),
                     room_id: self.room_id.clone(),
@@ -1013,6 +1071,7 @@ impl JsonContentHandler for SingleEventHandler {
                     session_id: self.event_fields.session_id.take(),
                     ciphertext: self.event_fields.ciphertext.take(),
                     device_id: self.event_fields.device_id.take(),
+                    replaces,
                 };
                 if let Ok(mut o) = self.out.lock() {
                     *o = Some(event);
@@ -1041,17 +1100,7 @@ impl JsonContentHandler for SingleEventHandler {
         }
 
         if self.in_content {
-            match self.current_key.as_deref() {
-                Some("body") => self.event_fields.body = Some(value.to_string()),
-                Some("msgtype") => self.event_fields.msgtype = Some(value.to_string()),
-                Some("url") => self.event_fields.url = Some(value.to_string()),
-                Some("algorithm") => self.event_fields.algorithm = Some(value.to_string()),
-                Some("sender_key") => self.event_fields.sender_key = Some(value.to_string()),
-                Some("session_id") => self.event_fields.session_id = Some(value.to_string()),
-                Some("ciphertext") => self.event_fields.ciphertext = Some(value.to_string()),
-                Some("device_id") => self.event_fields.device_id = Some(value.to_string()),
-                _ => {}
-            }
+            self.event_fields.content_string(self.current_key.as_deref(), value);
         }
 
         self.current_key = None;
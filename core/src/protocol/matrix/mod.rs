@@ -54,7 +54,7 @@ use connection::{connect_and_start_pipeline, MatrixCommand, MatrixConnection};
 use crypto::CryptoMachine;
 use device::DeviceTracker;
 use types::{
-    RoomEvent, RoomSummary, EVENT_ROOM_ENCRYPTED, EVENT_ROOM_MESSAGE,
+    RoomEvent, RoomSummary, EVENT_ROOM_ENCRYPTED, EVENT_ROOM_MESSAGE, REL_TYPE_REPLACE,
     ALGORITHM_MEGOLM,
 };
 
@@ -81,6 +81,8 @@ pub struct MatrixStore {
     encrypted_rooms: Arc<RwLock<std::collections::HashSet<String>>>,
     /// Active key backup: (version, recovery_key) — set after restore or setup.
     backup_info: Arc<RwLock<Option<(String, key_backup::RecoveryKey)>>>,
+    /// Folders subscribed to new events, and the long-poll sync loop serving them.
+    live: Arc<LiveSync>,
 }
 
 impl MatrixStore {
@@ -105,6 +107,7 @@ impl MatrixStore {
             device_tracker: Arc::new(DeviceTracker::new()),
             encrypted_rooms: Arc::new(RwLock::new(std::collections::HashSet::new())),
             backup_info: Arc::new(RwLock::new(None)),
+            live: Arc::new(LiveSync::default()),
         })
     }
 
@@ -204,6 +207,19 @@ impl MatrixStore {
         self.ensure_connection()
     }
 
+    fn sync_context(&self, conn: MatrixConnection, token: String) -> SyncContext {
+        SyncContext {
+            conn,
+            token,
+            room_cache: self.room_cache.clone(),
+            sync_token: self.sync_token.clone(),
+            crypto: self.get_crypto(),
+            device_tracker: self.device_tracker.clone(),
+            backup_info: self.backup_info.clone(),
+            live: self.live.clone(),
+        }
+    }
+
     /// Restore Megolm session keys from server-side backup using a recovery key.
     /// Returns the number of sessions restored.
     pub fn restore_backup(&self, recovery_key_b58: &str) -> Result<usize, StoreError> {
@@ -363,103 +379,18 @@ impl Store for MatrixStore {
             Err(e) => { on_complete(Err(e)); return; }
         };
 
-        let room_cache = self.room_cache.clone();
-        let sync_token = self.sync_token.clone();
-        let since = sync_token.lock().unwrap().clone();
-
-        let on_room: Arc<dyn Fn(RoomSummary) + Send + Sync> = Arc::new({
-            let room_cache = room_cache.clone();
-            move |room: RoomSummary| {
-                let info = FolderInfo {
-                    name: room.room_id.clone(),
-                    delimiter: None,
-                    attributes: if room.name.is_some() {
-                        vec![format!("display_name={}", room.name.as_deref().unwrap_or(""))]
-                    } else {
-                        Vec::new()
-                    },
-                };
-                on_folder(info);
-                if let Ok(mut cache) = room_cache.write() {
-                    cache.insert(room.room_id.clone(), room);
-                }
-            }
-        });
-        let on_event: Arc<dyn Fn(RoomEvent) + Send + Sync> = Arc::new(|_| {});
-
-        // E2EE: capture to-device events and OTK counts from sync
-        let crypto = self.get_crypto();
-        let crypto_for_to_device = crypto.clone();
-        let backup_for_td = self.backup_info.clone();
-        let conn_for_td = conn.clone();
-        let token_for_td = token.clone();
-        let on_to_device: Arc<dyn Fn(String, String, String) + Send + Sync> = Arc::new(move |event_type, sender, content_json| {
-            if let Some(ref cm) = crypto_for_to_device {
-                process_to_device_event(cm, &event_type, &sender, &content_json,
-                    &backup_for_td, &conn_for_td, &token_for_td);
-            }
-        });
-
-        let otk_count: Arc<Mutex<Option<usize>>> = Arc::new(Mutex::new(None));
-        let device_lists_changed: Arc<Mutex<Vec<String>>> = Arc::new(Mutex::new(Vec::new()));
-
-        let conn_for_keys = conn.clone();
-        let token_for_keys = token.clone();
-        let crypto_for_keys = crypto.clone();
-        let device_tracker = self.device_tracker.clone();
-        let otk_count_clone = otk_count.clone();
-        let device_lists_clone = device_lists_changed.clone();
-
-        conn.send(MatrixCommand::Sync {
-            token,
-            since,
-            on_room,
-            on_event,
-            otk_count,
-            device_lists_changed,
-            on_to_device,
-            on_complete: Box::new(move |result| {
-                match result {
-                    Ok(next_batch) => {
-                        if let Some(nb) = next_batch {
-                            if let Ok(mut st) = sync_token.lock() {
-                                *st = Some(nb);
-                            }
-                        }
-
-                        // E2EE: process device list changes
-                        if let Ok(changed) = device_lists_clone.lock() {
-                            if !changed.is_empty() {
-                                device_tracker.mark_users_dirty(&changed);
-                            }
-                        }
-
-                        // E2EE: upload keys if needed
-                        if let Some(ref cm) = crypto_for_keys {
-                            let count = otk_count_clone.lock().unwrap().take();
-                            let otk = cm.generate_one_time_keys_if_needed(count.unwrap_or(0));
-                            if !otk.is_empty() {
-                                let otk_json = cm.one_time_keys_json(&otk);
-                                let body = device::build_keys_upload_body(None, Some(&otk_json));
-                                let cm_clone = cm.clone();
-                                conn_for_keys.send(MatrixCommand::UploadKeys {
-                                    token: token_for_keys.clone(),
-                                    body,
-                                    on_complete: Box::new(move |result| {
-                                        if result.is_ok() {
-                                            cm_clone.mark_keys_as_published();
-                                        }
-                                    }),
-                                });
-                            }
-                        }
-
-                        on_complete(Ok(()));
-                    }
-                    Err(e) => on_complete(Err(e)),
-                }
-            }),
+        let on_room: Arc<dyn Fn(RoomSummary) + Send + Sync> = Arc::new(move |room: RoomSummary| {
+            on_folder(FolderInfo {
+                name: room.room_id.clone(),
+                delimiter: None,
+                attributes: if room.name.is_some() {
+                    vec![format!("display_name={}", room.name.as_deref().unwrap_or(""))]
+                } else {
+                    Vec::new()
+                },
+            });
         });
+        self.sync_context(conn, token).sync(Some(on_room), on_complete);
     }
 
     fn open_folder(
@@ -485,6 +416,14 @@ impl Store for MatrixStore {
             token,
             connection: conn,
             crypto: self.get_crypto(),
+            history: Arc::new(Mutex::new(None)),
+            runtime_handle: self.runtime_handle.clone(),
+            room_cache: self.room_cache.clone(),
+            sync_token: self.sync_token.clone(),
+            device_tracker: self.device_tracker.clone(),
+            backup_info: self.backup_info.clone(),
+            live: self.live.clone(),
+            subscription: Mutex::new(None),
         });
         on_complete(Ok(folder));
     }
@@ -502,6 +441,210 @@ impl Store for MatrixStore {
     }
 }
 
+// ── Sync ─────────────────────────────────────────────────────────────
+
+/// A folder subscribed to new events of its room.
+struct LiveSubscriber {
+    room_id: String,
+    on_added: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+    on_updated: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+}
+
+/// The store's live sync: one long-poll loop per store, whose room events are fanned out to
+/// the subscribed folders. The first subscriber starts the loop and the last one stops it.
+#[derive(Default)]
+struct LiveSync {
+    subscribers: Mutex<HashMap<u64, Arc<LiveSubscriber>>>,
+    next_id: std::sync::atomic::AtomicU64,
+    task: Mutex<Option<tokio::task::JoinHandle<()>>>,
+}
+
+impl LiveSync {
+    fn subscribe(&self, subscriber: LiveSubscriber) -> u64 {
+        let id = self.next_id.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+        self.subscribers.lock().unwrap().insert(id, Arc::new(subscriber));
+        id
+    }
+
+    fn unsubscribe(&self, id: u64) {
+        let mut subscribers = self.subscribers.lock().unwrap();
+        subscribers.remove(&id);
+        if subscribers.is_empty() {
+            if let Some(task) = self.task.lock().unwrap().take() {
+                task.abort();
+            }
+        }
+    }
+
+    /// Deliver a new room event to the folders of its room: messages to `on_added`, edits to
+    /// `on_updated` under the id of the message they replace.
+    fn dispatch(&self, crypto: &Option<Arc<CryptoMachine>>, event: &RoomEvent) {
+        let subscribers: Vec<Arc<LiveSubscriber>> = self.subscribers.lock().unwrap()
+            .values()
+            .filter(|s| s.room_id == event.room_id)
+            .cloned()
+            .collect();
+        if subscribers.is_empty() {
+            return;
+        }
+        let display = match message_event_display(crypto, &event.room_id, event) {
+            Some(d) => d,
+            None => return,
+        };
+        let mut summary = room_event_to_summary(&display);
+        match display.replaces {
+            Some(original) => {
+                summary.id = message_id::matrix_message_id(&display.room_id, &original);
+                summary.envelope.message_id = Some(original);
+                for subscriber in subscribers {
+                    (subscriber.on_updated)(summary.clone());
+                }
+            }
+            None => {
+                for subscriber in subscribers {
+                    (subscriber.on_added)(summary.clone());
+                }
+            }
+        }
+    }
+}
+
+/// Store state a /sync updates. `list_folders` and the live loop both sync through this, from
+/// and to the store's one next_batch token, so every event reaches the subscribers once
+/// whichever of them fetched it.
+struct SyncContext {
+    conn: MatrixConnection,
+    token: String,
+    room_cache: Arc<RwLock<HashMap<String, RoomSummary>>>,
+    sync_token: Arc<Mutex<Option<String>>>,
+    crypto: Option<Arc<CryptoMachine>>,
+    device_tracker: Arc<DeviceTracker>,
+    backup_info: BackupInfoRef,
+    live: Arc<LiveSync>,
+}
+
+impl SyncContext {
+    /// One /sync from the store's token. Rooms update the cache and go to `on_room`. Room
+    /// events, to-device events and key counts are applied on completion, and only if the
+    /// token is still the one this sync started from: a concurrent sync that advanced it first
+    /// has applied them already, and the next sync continues from there. The timeline of the
+    /// initial sync (no token) is recent history, not new events, and is not dispatched.
+    fn sync(
+        &self,
+        on_room: Option<Arc<dyn Fn(RoomSummary) + Send + Sync>>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        let since = self.sync_token.lock().unwrap().clone();
+
+        let on_room: Arc<dyn Fn(RoomSummary) + Send + Sync> = Arc::new({
+            let room_cache = self.room_cache.clone();
+            move |room: RoomSummary| {
+                if let Some(ref on_room) = on_room {
+                    on_room(room.clone());
+                }
+                if let Ok(mut cache) = room_cache.write() {
+                    cache.insert(room.room_id.clone(), room);
+                }
+            }
+        });
+        let events: Arc<Mutex<Vec<RoomEvent>>> = Arc::new(Mutex::new(Vec::new()));
+        let on_event: Arc<dyn Fn(RoomEvent) + Send + Sync> = if since.is_some() {
+            let events = events.clone();
+            Arc::new(move |event| events.lock().unwrap().push(event))
+        } else {
+            Arc::new(|_| {})
+        };
+        let to_device: Arc<Mutex<Vec<(String, String, String)>>> = Arc::new(Mutex::new(Vec::new()));
+        let on_to_device: Arc<dyn Fn(String, String, String) + Send + Sync> = {
+            let to_device = to_device.clone();
+            Arc::new(move |event_type, sender, content_json| {
+                to_device.lock().unwrap().push((event_type, sender, content_json));
+            })
+        };
+        let otk_count: Arc<Mutex<Option<usize>>> = Arc::new(Mutex::new(None));
+        let device_lists_changed: Arc<Mutex<Vec<String>>> = Arc::new(Mutex::new(Vec::new()));
+
+        let conn = self.conn.clone();
+        let token = self.token.clone();
+        let sync_token = self.sync_token.clone();
+        let crypto = self.crypto.clone();
+        let device_tracker = self.device_tracker.clone();
+        let backup_info = self.backup_info.clone();
+        let live = self.live.clone();
+        let otk_count_clone = otk_count.clone();
+        let device_lists_clone = device_lists_changed.clone();
+
+        self.conn.send(MatrixCommand::Sync {
+            token: self.token.clone(),
+            since: since.clone(),
+            on_room,
+            on_event,
+            otk_count,
+            device_lists_changed,
+            on_to_device,
+            on_complete: Box::new(move |result| {
+                let next_batch = match result {
+                    Ok(nb) => nb,
+                    Err(e) => {
+                        on_complete(Err(e));
+                        return;
+                    }
+                };
+                {
+                    let mut st = sync_token.lock().unwrap();
+                    if *st != since {
+                        on_complete(Ok(()));
+                        return;
+                    }
+                    if let Some(nb) = next_batch {
+                        *st = Some(nb);
+                    }
+                }
+
+                if let Some(ref cm) = crypto {
+                    for (event_type, sender, content_json) in to_device.lock().unwrap().drain(..) {
+                        process_to_device_event(cm, &event_type, &sender, &content_json,
+                            &backup_info, &conn, &token);
+                    }
+                }
+                // After to-device events, so room keys sent with the messages can decrypt them
+                for event in events.lock().unwrap().drain(..) {
+                    live.dispatch(&crypto, &event);
+                }
+
+                // E2EE: process device list changes
+                if let Ok(changed) = device_lists_clone.lock() {
+                    if !changed.is_empty() {
+                        device_tracker.mark_users_dirty(&changed);
+                    }
+                }
+
+                // E2EE: upload keys if needed
+                if let Some(ref cm) = crypto {
+                    let count = otk_count_clone.lock().unwrap().take();
+                    let otk = cm.generate_one_time_keys_if_needed(count.unwrap_or(0));
+                    if !otk.is_empty() {
+                        let otk_json = cm.one_time_keys_json(&otk);
+                        let body = device::build_keys_upload_body(None, Some(&otk_json));
+                        let cm_clone = cm.clone();
+                        conn.send(MatrixCommand::UploadKeys {
+                            token: token.clone(),
+                            body,
+                            on_complete: Box::new(move |result| {
+                                if result.is_ok() {
+                                    cm_clone.mark_keys_as_published();
+                                }
+                            }),
+                        });
+                    }
+                }
+
+                on_complete(Ok(()));
+            }),
+        });
+    }
+}
+
 // ── MatrixFolder ─────────────────────────────────────────────────────
 
 /// Folder = one Matrix room. Messages = room events (m.room.message).
@@ -516,11 +659,65 @@ struct MatrixFolder {
     token: String,
     connection: MatrixConnection,
     crypto: Option<Arc<CryptoMachine>>,
+    /// Backward pagination token from the last history page, with the number of messages
+    /// delivered up to that point (the `skip` the next page will ask for).
+    history: Arc<Mutex<Option<(u64, String)>>>,
+    runtime_handle: tokio::runtime::Handle,
+    /// Store state the live sync loop updates, shared with the store.
+    room_cache: Arc<RwLock<HashMap<String, RoomSummary>>>,
+    sync_token: Arc<Mutex<Option<String>>>,
+    device_tracker: Arc<DeviceTracker>,
+    backup_info: BackupInfoRef,
+    live: Arc<LiveSync>,
+    /// This folder's subscriber id in `live`; removed when the folder is dropped.
+    subscription: Mutex<Option<u64>>,
+}
+
+impl Drop for MatrixFolder {
+    fn drop(&mut self) {
+        if let Some(id) = self.subscription.lock().unwrap().take() {
+            self.live.unsubscribe(id);
+        }
+    }
 }
 
 unsafe impl Send for MatrixFolder {}
 unsafe impl Sync for MatrixFolder {}
 
+/// A room message event as displayed: m.room.encrypted decrypted where possible, otherwise
+/// a placeholder. None for events that are not messages (state, reactions, ...).
+fn message_event_display(
+    crypto: &Option<Arc<CryptoMachine>>,
+    room_id: &str,
+    event: &RoomEvent,
+) -> Option<RoomEvent> {
+    if event.event_type == EVENT_ROOM_MESSAGE {
+        Some(event.clone())
+    } else if event.event_type == EVENT_ROOM_ENCRYPTED {
+        try_decrypt_room_event(crypto, room_id, event).or_else(|| {
+            let mut fallback = event.clone();
+            fallback.body = Some("[Encrypted message]".to_string());
+            fallback.event_type = EVENT_ROOM_MESSAGE.to_string();
+            Some(fallback)
+        })
+    } else {
+        None
+    }
+}
+
+/// Summary of a room message event for history pages. Edits are skipped: they reach open
+/// conversations through the live sync's `on_updated`, and listed here they would show up
+/// as messages of their own.
+fn message_event_summary(
+    crypto: &Option<Arc<CryptoMachine>>,
+    room_id: &str,
+    event: &RoomEvent,
+) -> Option<ConversationSummary> {
+    message_event_display(crypto, room_id, event)
+        .filter(|display| display.replaces.is_none())
+        .map(|display| room_event_to_summary(&display))
+}
+
 fn room_event_to_summary(event: &RoomEvent) -> ConversationSummary {
     let (local_part, domain) = split_matrix_user_id(&event.sender);
     let from = Address {
@@ -559,6 +756,41 @@ fn split_matrix_user_id(user_id: &str) -> (String, String) {
     }
 }
 
+/// One history page of a room: `/messages` requests repeated from each returned token until
+/// `wanted` messages have been seen or the start of the room is reached. The request limit
+/// counts events of every type while `wanted` counts messages, so a page of messages in a
+/// room busy with state changes or reactions can take several requests.
+struct HistoryRequest {
+    connection: MatrixConnection,
+    token: String,
+    room_id: String,
+    on_event: Arc<dyn Fn(RoomEvent) + Send + Sync>,
+    seen: Arc<std::sync::atomic::AtomicU64>,
+    wanted: u64,
+    limit: u64,
+}
+
+fn request_history(
+    request: Arc<HistoryRequest>,
+    from: Option<String>,
+    on_complete: Box<dyn FnOnce(Result<Option<String>, StoreError>) + Send>,
+) {
+    let next = request.clone();
+    request.connection.send(MatrixCommand::RoomMessages {
+        token: request.token.clone(),
+        room_id: request.room_id.clone(),
+        limit: request.limit,
+        from,
+        on_event: request.on_event.clone(),
+        on_complete: Box::new(move |result| match result {
+            Ok(Some(end)) if next.seen.load(std::sync::atomic::Ordering::Relaxed) < next.wanted => {
+                request_history(next, Some(end), on_complete)
+            }
+            other => on_complete(other),
+        }),
+    });
+}
+
 impl Folder for MatrixFolder {
     fn list_conversations(
         &self,
@@ -574,17 +806,8 @@ impl Folder for MatrixFolder {
         let crypto = self.crypto.clone();
         let room_id = self.room_id.clone();
         let on_event: Arc<dyn Fn(RoomEvent) + Send + Sync> = Arc::new(move |event| {
-            if event.event_type == EVENT_ROOM_MESSAGE {
-                on_summary(room_event_to_summary(&event));
-            } else if event.event_type == EVENT_ROOM_ENCRYPTED {
-                if let Some(decrypted) = try_decrypt_room_event(&crypto, &room_id, &event) {
-                    on_summary(room_event_to_summary(&decrypted));
-                } else {
-                    let mut fallback = event.clone();
-                    fallback.body = Some("[Encrypted message]".to_string());
-                    fallback.event_type = EVENT_ROOM_MESSAGE.to_string();
-                    on_summary(room_event_to_summary(&fallback));
-                }
+            if let Some(summary) = message_event_summary(&crypto, &room_id, &event) {
+                on_summary(summary);
             }
         });
 
@@ -600,6 +823,119 @@ impl Folder for MatrixFolder {
         });
     }
 
+    fn list_conversation_history(
+        &self,
+        skip: u64,
+        count: u64,
+        on_summary: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<bool, StoreError>) + Send>,
+    ) {
+        if count == 0 {
+            on_complete(Ok(true));
+            return;
+        }
+        // Continue from the token of the previous page if it ended where this one starts;
+        // otherwise page back from the newest event and drop the first `skip` messages.
+        let (from, drop) = match self.history.lock().unwrap().clone() {
+            Some((loaded, token)) if loaded == skip && skip > 0 => (Some(token), 0),
+            _ => (None, skip),
+        };
+        let seen = Arc::new(std::sync::atomic::AtomicU64::new(0));
+        let seen_event = seen.clone();
+        let crypto = self.crypto.clone();
+        let room_id = self.room_id.clone();
+        let on_event: Arc<dyn Fn(RoomEvent) + Send + Sync> = Arc::new(move |event| {
+            if let Some(summary) = message_event_summary(&crypto, &room_id, &event) {
+                let n = seen_event.fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+                if n >= drop {
+                    on_summary(summary);
+                }
+            }
+        });
+
+        let history = self.history.clone();
+        let request = Arc::new(HistoryRequest {
+            connection: self.connection.clone(),
+            token: self.token.clone(),
+            room_id: self.room_id.clone(),
+            on_event,
+            seen: seen.clone(),
+            wanted: drop + count,
+            limit: count,
+        });
+        request_history(
+            request,
+            from,
+            Box::new(move |result| match result {
+                Ok(end) => {
+                    let delivered = seen.load(std::sync::atomic::Ordering::Relaxed).saturating_sub(drop);
+                    let more = end.is_some();
+                    *history.lock().unwrap() = end.map(|token| (skip + delivered, token));
+                    on_complete(Ok(more));
+                }
+                Err(e) => on_complete(Err(e)),
+            }),
+        );
+    }
+
+    fn subscribe(
+        &self,
+        on_added: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+        on_updated: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+    ) {
+        let id = self.live.subscribe(LiveSubscriber {
+            room_id: self.room_id.clone(),
+            on_added,
+            on_updated,
+        });
+        if let Some(previous) = self.subscription.lock().unwrap().replace(id) {
+            self.live.unsubscribe(previous);
+        }
+        let mut task = self.live.task.lock().unwrap();
+        if task.as_ref().map_or(true, |t| t.is_finished()) {
+            let homeserver = self.homeserver.clone();
+            let token = self.token.clone();
+            let room_cache = self.room_cache.clone();
+            let sync_token = self.sync_token.clone();
+            let crypto = self.crypto.clone();
+            let device_tracker = self.device_tracker.clone();
+            let backup_info = self.backup_info.clone();
+            let live = self.live.clone();
+            *task = Some(self.runtime_handle.spawn(async move {
+                // Own connection: a 30 s long poll would otherwise hold up the folders' requests
+                let conn = match connect_and_start_pipeline(&homeserver).await {
+                    Ok(c) => c,
+                    Err(e) => {
+                        eprintln!("[matrix] live sync connect failed: {}", e);
+                        return;
+                    }
+                };
+                let context = SyncContext {
+                    conn,
+                    token,
+                    room_cache,
+                    sync_token,
+                    crypto,
+                    device_tracker,
+                    backup_info,
+                    live,
+                };
+                loop {
+                    let (tx, rx) = tokio::sync::oneshot::channel();
+                    context.sync(None, Box::new(move |result| { let _ = tx.send(result); }));
+                    match rx.await {
+                        Ok(Ok(())) => {}
+                        Ok(Err(e)) => {
+                            eprintln!("[matrix] live sync failed: {}", e);
+                            tokio::time::sleep(std::time::Duration::from_secs(30)).await;
+                        }
+                        Err(_) => return,
+                    }
+                }
+            }));
+        }
+    }
+
     fn message_count(
         &self,
         on_complete: Box<dyn FnOnce(Result<u64, StoreError>) + Send>,
@@ -989,7 +1325,21 @@ fn try_decrypt_room_event(
     match cm.megolm_decrypt(room_id, session_id, ciphertext) {
         Ok(decrypted) => {
             let plaintext = String::from_utf8_lossy(&decrypted.plaintext);
-            let body = extract_json_string(&plaintext, "body");
+            // An edit carries its replacement text in "m.new_content"; the outer body is a fallback.
+            let replaces = if extract_json_string(&plaintext, "rel_type").as_deref()
+                == Some(REL_TYPE_REPLACE)
+            {
+                plaintext
+                    .find("\"m.relates_to\"")
+                    .and_then(|pos| extract_json_string(&plaintext[pos..], "event_id"))
+            } else {
+                None
+            };
+            let body = match (&replaces, plaintext.find("\"m.new_content\"")) {
+                (Some(_), Some(pos)) => extract_json_string(&plaintext[pos..], "body"),
+                _ => None,
+            }
+            .or_else(|| extract_json_string(&plaintext, "body"));
             let msgtype = extract_json_string(&plaintext, "msgtype");
             let url = extract_json_string(&plaintext, "url");
             Some(RoomEvent {
@@ -1007,6 +1357,7 @@ fn try_decrypt_room_event(
                 session_id: None,
                 ciphertext: None,
                 device_id: None,
+                replaces,
             })
         }
         Err(e) => {
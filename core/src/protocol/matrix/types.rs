@@ -187,6 +187,8 @@ pub const EVENT_ROOM_AVATAR: &str = "m.room.avatar";
 pub const EVENT_ROOM_TOPIC: &str = "m.room.topic";
 pub const EVENT_ROOM_MEMBER: &str = "m.room.member";
 pub const EVENT_ROOM_CREATE: &str = "m.room.create";
+/// `rel_type` of an edit: the event's `m.new_content` replaces the related event.
+pub const REL_TYPE_REPLACE: &str = "m.replace";
 
 pub const EVENT_ROOM_ENCRYPTED: &str = "m.room.encrypted";
 pub const EVENT_ROOM_ENCRYPTION: &str = "m.room.encryption";
@@ -261,6 +263,8 @@ pub struct RoomEvent {
     pub session_id: Option<String>,
     pub ciphertext: Option<String>,
     pub device_id: Option<String>,
+    /// Event id this event edits (`m.replace` relation); its body is the replacement text.
+    pub replaces: Option<String>,
 }
 
 /// A parsed Matrix error response: `{"errcode": "...", "error": "..."}`.
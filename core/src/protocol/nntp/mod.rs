@@ -293,6 +293,11 @@ impl Store for NntpStore {
         *self.state.auth.write().unwrap() = Some((u, password.to_string()));
     }
 
+    fn warm_up(&self, on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>) {
+        // No default group to select: GROUP is issued when the user opens one
+        on_complete(self.state.ensure_connection().map(|_| ()));
+    }
+
     fn list_folders(
         &self,
         on_folder: Box<dyn Fn(FolderInfo) + Send + Sync>,
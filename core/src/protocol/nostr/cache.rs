@@ -144,60 +144,159 @@ pub fn get_messages(
     let mut seen_ids: HashSet<String> = HashSet::new();
 
     for event in &events {
-        match event.kind {
-            KIND_DM => {
-                let id_lower = event.id.to_lowercase();
-                if !seen_ids.insert(id_lower) {
-                    continue;
-                }
-                let is_outgoing = event.pubkey.to_lowercase() == our;
-                let sender_pubkey = if is_outgoing { other.as_str() } else { event.pubkey.as_str() };
-                let plaintext = crypto::nip04_decrypt(&event.content, our_secret_hex, sender_pubkey)
-                    .unwrap_or_else(|_| String::from("[unable to decrypt]"));
-                messages.push(DecryptedMessage {
-                    id: event.id.clone(),
-                    pubkey: event.pubkey.clone(),
-                    created_at: event.created_at,
-                    content: plaintext,
-                    is_outgoing,
-                });
+        if event.kind != KIND_DM && event.kind != KIND_GIFT_WRAP {
+            continue;
+        }
+        if !seen_ids.insert(event.id.to_lowercase()) {
+            continue;
+        }
+        if let Some(msg) = decrypt_event(event, our_secret_hex, &our, &other) {
+            // A gift wrap's rumor may arrive wrapped more than once
+            if msg.id != event.id && !seen_ids.insert(msg.id.to_lowercase()) {
+                continue;
+            }
+            messages.push(msg);
+        }
+    }
+    messages.sort_by_key(|m| m.created_at);
+    Ok(messages)
+}
+
+/// How far back NIP-59 lets a gift wrap's created_at be randomized from its rumor's.
+pub const GIFT_WRAP_BACKDATE: u64 = 2 * 86400;
+
+/// Pages through a conversation newest first, decrypting only the events a page needs.
+///
+/// The cached events are indexed (still encrypted) by their own created_at. A kind 4 event
+/// carries the message time; a gift wrap's rumor may be up to `GIFT_WRAP_BACKDATE` later
+/// than the wrap, so a page also decrypts the older events that could still sort into it.
+/// Decrypted messages not returned yet are kept for the next page.
+pub struct HistoryPager {
+    our_secret_hex: String,
+    our: String,
+    other: String,
+    /// Deduplicated DM events, by created_at ascending; `events[..next]` are not decrypted yet.
+    events: Vec<Event>,
+    next: usize,
+    /// Largest difference between a message time and its event's created_at.
+    slack: u64,
+    /// Decrypted but not yet returned, by created_at ascending.
+    pending: Vec<DecryptedMessage>,
+    seen_ids: HashSet<String>,
+    returned: u64,
+}
+
+impl HistoryPager {
+    /// Index the conversation file; nothing is decrypted until `next_page`.
+    pub fn open(
+        config_dir: &str,
+        our_secret_hex: &str,
+        our_pubkey_hex: &str,
+        other_pubkey_hex: &str,
+    ) -> Result<Self, String> {
+        let path = conversation_file_path(config_dir, our_pubkey_hex, other_pubkey_hex);
+        let contents = match fs::read_to_string(&path) {
+            Ok(c) => c,
+            Err(e) if e.kind() == io::ErrorKind::NotFound => String::new(),
+            Err(e) => return Err(format!("Read conversation file: {}", e)),
+        };
+        let mut seen_ids: HashSet<String> = HashSet::new();
+        let mut events = if contents.is_empty() { Vec::new() } else { parse_event_array(&contents)? };
+        events.retain(|e| (e.kind == KIND_DM || e.kind == KIND_GIFT_WRAP) && seen_ids.insert(e.id.to_lowercase()));
+        events.sort_by_key(|e| e.created_at);
+        let slack = if events.iter().any(|e| e.kind == KIND_GIFT_WRAP) { GIFT_WRAP_BACKDATE } else { 0 };
+        Ok(Self {
+            our_secret_hex: our_secret_hex.to_string(),
+            our: normalize_hex(our_pubkey_hex),
+            other: normalize_hex(other_pubkey_hex),
+            next: events.len(),
+            events,
+            slack,
+            pending: Vec::new(),
+            seen_ids,
+            returned: 0,
+        })
+    }
+
+    /// Number of messages returned by `next_page` so far.
+    pub fn returned(&self) -> u64 {
+        self.returned
+    }
+
+    /// Number of messages in the conversation, counted from the index without decrypting:
+    /// a rumor wrapped more than once counts once per wrap.
+    pub fn indexed(&self) -> u64 {
+        self.events.len() as u64
+    }
+
+    /// The next `count` messages older than those already returned, oldest first, and
+    /// whether older messages remain.
+    pub fn next_page(&mut self, count: usize) -> (Vec<DecryptedMessage>, bool) {
+        while self.next > 0 && count > 0 {
+            // An undecrypted event can sort into the page only if its message time may be
+            // later than the oldest message the page would hold now
+            let newest_possible = self.events[self.next - 1].created_at + self.slack;
+            if self.pending.len() >= count && self.pending[self.pending.len() - count].created_at >= newest_possible {
+                break;
             }
-            KIND_GIFT_WRAP => {
-                let id_lower = event.id.to_lowercase();
-                if !seen_ids.insert(id_lower) {
+            self.next -= 1;
+            let event = &self.events[self.next];
+            if let Some(msg) = decrypt_event(event, &self.our_secret_hex, &self.our, &self.other) {
+                // A gift wrap's rumor may arrive wrapped more than once
+                if msg.id != event.id && !self.seen_ids.insert(msg.id.to_lowercase()) {
                     continue;
                 }
-                match crypto::unwrap_gift_wrap(event, our_secret_hex) {
-                    Ok((_seal, rumor)) => {
-                        let rumor_id = rumor.id.to_lowercase();
-                        if !seen_ids.insert(rumor_id) {
-                            continue;
-                        }
-                        let is_outgoing = rumor.pubkey.to_lowercase() == our;
-                        messages.push(DecryptedMessage {
-                            id: rumor.id.clone(),
-                            pubkey: rumor.pubkey.clone(),
-                            created_at: rumor.created_at,
-                            content: rumor.content.clone(),
-                            is_outgoing,
-                        });
-                    }
-                    Err(_) => {
-                        messages.push(DecryptedMessage {
-                            id: event.id.clone(),
-                            pubkey: event.pubkey.clone(),
-                            created_at: event.created_at,
-                            content: String::from("[unable to decrypt]"),
-                            is_outgoing: false,
-                        });
-                    }
-                }
+                let at = self.pending.partition_point(|m| m.created_at <= msg.created_at);
+                self.pending.insert(at, msg);
             }
-            _ => continue,
         }
+        let take = count.min(self.pending.len());
+        let page = self.pending.split_off(self.pending.len() - take);
+        self.returned += take as u64;
+        (page, self.next > 0 || !self.pending.is_empty())
+    }
+}
+
+/// Decrypt one kind 4 or kind 1059 event of the conversation between `our` and `other`
+/// (lowercase hex). None for other kinds; undecryptable content becomes a placeholder.
+pub fn decrypt_event(
+    event: &Event,
+    our_secret_hex: &str,
+    our: &str,
+    other: &str,
+) -> Option<DecryptedMessage> {
+    match event.kind {
+        KIND_DM => {
+            let is_outgoing = event.pubkey.to_lowercase() == our;
+            let sender_pubkey = if is_outgoing { other } else { event.pubkey.as_str() };
+            let plaintext = crypto::nip04_decrypt(&event.content, our_secret_hex, sender_pubkey)
+                .unwrap_or_else(|_| String::from("[unable to decrypt]"));
+            Some(DecryptedMessage {
+                id: event.id.clone(),
+                pubkey: event.pubkey.clone(),
+                created_at: event.created_at,
+                content: plaintext,
+                is_outgoing,
+            })
+        }
+        KIND_GIFT_WRAP => match crypto::unwrap_gift_wrap(event, our_secret_hex) {
+            Ok((_seal, rumor)) => Some(DecryptedMessage {
+                is_outgoing: rumor.pubkey.to_lowercase() == our,
+                id: rumor.id,
+                pubkey: rumor.pubkey,
+                created_at: rumor.created_at,
+                content: rumor.content,
+            }),
+            Err(_) => Some(DecryptedMessage {
+                id: event.id.clone(),
+                pubkey: event.pubkey.clone(),
+                created_at: event.created_at,
+                content: String::from("[unable to decrypt]"),
+                is_outgoing: false,
+            }),
+        },
+        _ => None,
     }
-    messages.sort_by_key(|m| m.created_at);
-    Ok(messages)
 }
 
 /// Append a raw kind 4 or kind 1059 event to the conversation file (dedup by event id).
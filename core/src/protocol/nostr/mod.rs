@@ -42,10 +42,11 @@ pub use crypto::{get_public_key_from_secret, create_signed_dm, create_nip17_dm,
                  sha256_hex, create_blossom_auth_event, create_nip98_auth_event, nostr_auth_header};
 pub use keys::{secret_key_to_hex, public_key_to_hex, hex_to_npub, hex_to_nsec,
                nsec_to_hex, npub_to_hex, is_nsec, is_npub, is_valid_hex_key};
-pub use types::{ProfileMetadata, parse_profile, filter_profile_by_author,
+pub use types::{ProfileMetadata, parse_profile, filter_profile_by_author, filter_profiles_by_authors,
                 filter_relay_list_by_author, parse_relay_list, KIND_METADATA, KIND_RELAY_LIST,
                 KIND_CONTACTS, filter_contacts_by_author, parse_contacts_relay_list};
 pub use relay::{fetch_notes_from_relay, fetch_profile_from_relay, fetch_profile_from_relays,
+                fetch_profiles_from_relays, PROFILE_FILTER_AUTHORS,
                 fetch_relay_list_from_relay, fetch_relay_list_from_relays,
                 fetch_contacts_relay_list_from_relays};
 
@@ -74,6 +75,8 @@ pub struct NostrStore {
     secret_key_hex: Arc<RwLock<Option<String>>>,
     config_dir: Option<String>,
     runtime_handle: tokio::runtime::Handle,
+    /// Relays the last DM sync used; open folders listen for new messages on these.
+    dm_relays: Arc<RwLock<Vec<String>>>,
 }
 
 impl NostrStore {
@@ -91,6 +94,7 @@ impl NostrStore {
             secret_key_hex: Arc::new(RwLock::new(None)),
             config_dir,
             runtime_handle,
+            dm_relays: Arc::new(RwLock::new(Vec::new())),
         })
     }
 
@@ -157,6 +161,7 @@ impl Store for NostrStore {
         };
         let pubkey_hex = self.pubkey_hex.clone();
         let bootstrap_relays = self.relays.clone();
+        let dm_relays = self.dm_relays.clone();
         eprintln!("[nostr] list_folders: pubkey={}, bootstrap_relays={:?}, config_dir={}", pubkey_hex, bootstrap_relays, config_dir);
 
         self.runtime_handle.spawn(async move {
@@ -266,6 +271,9 @@ impl Store for NostrStore {
                 .filter(|r| !dead_relays.contains(r.as_str()))
                 .collect();
             eprintln!("[nostr] list_folders: starting DM sync with {} relays: {:?}", relays.len(), relays);
+            if let Ok(mut guard) = dm_relays.write() {
+                *guard = relays.clone();
+            }
             let filter_recv = types::filter_dms_received(&pubkey_hex, 500, None);
             let filter_sent = types::filter_dms_sent(&pubkey_hex, 500, None);
             let filter_gw = types::filter_gift_wraps_received(&pubkey_hex, 500, None);
@@ -293,30 +301,7 @@ impl Store for NostrStore {
                         event_count += 1;
                         let event_json = types::event_to_json_compact(&event);
 
-                        let other_pk = match event.kind {
-                            types::KIND_DM => {
-                                types::other_pubkey_in_dm(&event, &pubkey_hex)
-                            }
-                            types::KIND_GIFT_WRAP => {
-                                match crypto::unwrap_gift_wrap(&event, &secret_hex) {
-                                    Ok((_seal, rumor)) => {
-                                        let rumor_pk = rumor.pubkey.to_lowercase();
-                                        if rumor_pk == pubkey_hex.to_lowercase() {
-                                            rumor.tags.iter()
-                                                .find(|t| t.len() >= 2 && t[0] == "p")
-                                                .map(|t| t[1].to_lowercase())
-                                        } else {
-                                            Some(rumor_pk)
-                                        }
-                                    }
-                                    Err(e) => {
-                                        eprintln!("[nostr] list_folders: unwrap gift wrap failed: {}", e);
-                                        None
-                                    }
-                                }
-                            }
-                            _ => None,
-                        };
+                        let other_pk = dm_partner(&event, &pubkey_hex, &secret_hex);
 
                         if let Some(other) = other_pk {
                             let _ = cache::append_raw_event(
@@ -370,11 +355,20 @@ impl Store for NostrStore {
             }
         };
 
+        let relays = match self.dm_relays.read() {
+            Ok(guard) if !guard.is_empty() => guard.clone(),
+            _ => self.relays.clone(),
+        };
+
         let folder = NostrFolder {
             our_secret_hex: secret_hex,
             our_pubkey_hex: self.pubkey_hex.clone(),
             other_pubkey_hex: name.to_lowercase(),
             config_dir,
+            relays,
+            runtime_handle: self.runtime_handle.clone(),
+            live: std::sync::Mutex::new(Vec::new()),
+            history: Arc::new(std::sync::Mutex::new(None)),
         };
         on_complete(Ok(Box::new(folder)));
     }
@@ -398,6 +392,98 @@ struct NostrFolder {
     our_pubkey_hex: String,
     other_pubkey_hex: String,
     config_dir: String,
+    relays: Vec<String>,
+    runtime_handle: tokio::runtime::Handle,
+    /// Relay streams started by `subscribe`; aborted when the folder is dropped.
+    live: std::sync::Mutex<Vec<tokio::task::JoinHandle<()>>>,
+    /// Cursor of `list_conversation_history`, kept between pages.
+    history: Arc<std::sync::Mutex<Option<cache::HistoryPager>>>,
+}
+
+impl Drop for NostrFolder {
+    fn drop(&mut self) {
+        if let Ok(tasks) = self.live.lock() {
+            for task in tasks.iter() {
+                task.abort();
+            }
+        }
+    }
+}
+
+/// Conversation partner of a kind 4 or kind 1059 event, as lowercase hex.
+fn dm_partner(event: &Event, our_pubkey_hex: &str, our_secret_hex: &str) -> Option<String> {
+    match event.kind {
+        types::KIND_DM => types::other_pubkey_in_dm(event, our_pubkey_hex),
+        types::KIND_GIFT_WRAP => match crypto::unwrap_gift_wrap(event, our_secret_hex) {
+            Ok((_seal, rumor)) => {
+                let rumor_pk = rumor.pubkey.to_lowercase();
+                if rumor_pk == our_pubkey_hex.to_lowercase() {
+                    rumor.tags.iter()
+                        .find(|t| t.len() >= 2 && t[0] == "p")
+                        .map(|t| t[1].to_lowercase())
+                } else {
+                    Some(rumor_pk)
+                }
+            }
+            Err(e) => {
+                eprintln!("[nostr] unwrap gift wrap failed: {}", e);
+                None
+            }
+        },
+        _ => None,
+    }
+}
+
+fn dm_summary(msg: &cache::DecryptedMessage, our_pubkey_hex: &str, other_pubkey_hex: &str) -> ConversationSummary {
+    let from_addr = Address {
+        display_name: None,
+        local_part: msg.pubkey.clone(),
+        domain: None,
+    };
+    let to_addr = Address {
+        display_name: None,
+        local_part: if msg.is_outgoing {
+            other_pubkey_hex.to_string()
+        } else {
+            our_pubkey_hex.to_string()
+        },
+        domain: None,
+    };
+
+    let envelope = Envelope {
+        from: vec![from_addr],
+        to: vec![to_addr],
+        cc: Vec::new(),
+        date: Some(DateTime {
+            timestamp: msg.created_at as i64,
+            tz_offset_secs: Some(0),
+        }),
+        subject: Some(msg.content.clone()),
+        message_id: Some(msg.id.clone()),
+    };
+
+    ConversationSummary {
+        id: crate::message_id::nostr_dm_message_id(&msg.id),
+        envelope,
+        flags: std::collections::HashSet::new(),
+        size: msg.content.len() as u64,
+    }
+}
+
+impl NostrFolder {
+    fn load_messages(&self) -> Result<Vec<cache::DecryptedMessage>, StoreError> {
+        cache::get_messages(
+            &self.config_dir,
+            &self.our_secret_hex,
+            &self.our_pubkey_hex,
+            &self.other_pubkey_hex,
+        )
+        .map_err(StoreError::new)
+    }
+
+    fn summary(&self, msg: &cache::DecryptedMessage) -> ConversationSummary {
+        dm_summary(msg, &self.our_pubkey_hex, &self.other_pubkey_hex)
+    }
 }
 
 impl Folder for NostrFolder {
@@ -407,15 +493,10 @@ impl Folder for NostrFolder {
         on_summary: Box<dyn Fn(ConversationSummary) + Send + Sync>,
         on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
     ) {
-        let messages = match cache::get_messages(
-            &self.config_dir,
-            &self.our_secret_hex,
-            &self.our_pubkey_hex,
-            &self.other_pubkey_hex,
-        ) {
+        let messages = match self.load_messages() {
             Ok(m) => m,
             Err(e) => {
-                on_complete(Err(StoreError::new(e)));
+                on_complete(Err(e));
                 return;
             }
         };
@@ -423,62 +504,147 @@ impl Folder for NostrFolder {
         let start = range.start as usize;
         let end = (range.end as usize).min(messages.len());
 
-        if start < messages.len() {
+        if start < end {
             for msg in &messages[start..end] {
-                let from_addr = Address {
-                    display_name: None,
-                    local_part: msg.pubkey.clone(),
-                    domain: None,
-                };
-                let to_addr = Address {
-                    display_name: None,
-                    local_part: if msg.is_outgoing {
-                        self.other_pubkey_hex.clone()
-                    } else {
-                        self.our_pubkey_hex.clone()
-                    },
-                    domain: None,
-                };
+                on_summary(self.summary(msg));
+            }
+        }
 
-                let envelope = Envelope {
-                    from: vec![from_addr],
-                    to: vec![to_addr],
-                    cc: Vec::new(),
-                    date: Some(DateTime {
-                        timestamp: msg.created_at as i64,
-                        tz_offset_secs: Some(0),
-                    }),
-                    subject: Some(msg.content.clone()),
-                    message_id: Some(msg.id.clone()),
-                };
+        on_complete(Ok(()));
+    }
 
-                let message_id = crate::message_id::nostr_dm_message_id(&msg.id);
-                on_summary(ConversationSummary {
-                    id: message_id,
-                    envelope,
-                    flags: std::collections::HashSet::new(),
-                    size: msg.content.len() as u64,
-                });
+    fn list_conversation_history(
+        &self,
+        skip: u64,
+        count: u64,
+        on_summary: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<bool, StoreError>) + Send>,
+    ) {
+        let history = self.history.clone();
+        let config_dir = self.config_dir.clone();
+        let our_secret_hex = self.our_secret_hex.clone();
+        let our = self.our_pubkey_hex.clone();
+        let other = self.other_pubkey_hex.clone();
+        // Reading and decrypting the cache is blocking work; keep it off the caller's thread
+        let _ = self.runtime_handle.spawn_blocking(move || {
+            let mut history = history.lock().unwrap();
+            if history.as_ref().map_or(true, |pager| pager.returned() != skip) {
+                // A first page, or one out of sequence: index the cache again from the newest message
+                let mut pager = match cache::HistoryPager::open(&config_dir, &our_secret_hex, &our, &other) {
+                    Ok(p) => p,
+                    Err(e) => {
+                        *history = None;
+                        on_complete(Err(StoreError::new(e)));
+                        return;
+                    }
+                };
+                if skip > 0 {
+                    pager.next_page(skip as usize);
+                }
+                *history = Some(pager);
+            }
+            let (page, more) = history.as_mut().unwrap().next_page(count as usize);
+            for msg in &page {
+                on_summary(dm_summary(msg, &our, &other));
             }
+            on_complete(Ok(more));
+        });
+    }
+
+    fn subscribe(
+        &self,
+        on_added: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+        // NIP-04 and NIP-17 direct messages cannot be edited: nothing to update
+        _on_updated: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+    ) {
+        let now = std::time::SystemTime::now()
+            .duration_since(std::time::UNIX_EPOCH)
+            .unwrap_or_default()
+            .as_secs();
+        // Gift wraps carry a randomized created_at up to two days in the past (NIP-59)
+        let filter_recv = types::filter_dms_received(&self.our_pubkey_hex, 50, Some(now));
+        let filter_sent = types::filter_dms_sent(&self.our_pubkey_hex, 50, Some(now));
+        let filter_gw = types::filter_gift_wraps_received(&self.our_pubkey_hex, 50, Some(now.saturating_sub(cache::GIFT_WRAP_BACKDATE)));
+        let sk = Some(self.our_secret_hex.clone());
+
+        let (tx, mut rx) = tokio::sync::mpsc::unbounded_channel();
+        let mut tasks = Vec::new();
+        for relay_url in &self.relays {
+            let url = relay_url.clone();
+            let (fr, fs, fg) = (filter_recv.clone(), filter_sent.clone(), filter_gw.clone());
+            let tx = tx.clone();
+            let sk = sk.clone();
+            tasks.push(self.runtime_handle.spawn(async move {
+                // The stream ends on disconnect or after its lifetime; reconnect until aborted
+                loop {
+                    relay::run_relay_dm_stream_nip17(url.clone(), fr.clone(), fs.clone(), fg.clone(), false, tx.clone(), sk.clone()).await;
+                    tokio::time::sleep(std::time::Duration::from_secs(30)).await;
+                }
+            }));
         }
+        drop(tx);
 
-        on_complete(Ok(()));
+        let config_dir = self.config_dir.clone();
+        let our_secret_hex = self.our_secret_hex.clone();
+        let our = self.our_pubkey_hex.to_lowercase();
+        let other = self.other_pubkey_hex.to_lowercase();
+        tasks.push(self.runtime_handle.spawn(async move {
+            while let Some(msg) = rx.recv().await {
+                let event = match msg {
+                    StreamMessage::Event(event) => event,
+                    _ => continue,
+                };
+                if dm_partner(&event, &our, &our_secret_hex).as_deref() != Some(other.as_str()) {
+                    continue;
+                }
+                // Several relays deliver the same event; only the first copy is new to the cache
+                let event_json = types::event_to_json_compact(&event);
+                match cache::append_raw_event(&config_dir, &our, &other, &event_json) {
+                    Ok(true) => {}
+                    Ok(false) => continue,
+                    Err(e) => {
+                        eprintln!("[nostr] subscribe: cache append failed: {}", e);
+                        continue;
+                    }
+                }
+                if let Some(decrypted) = cache::decrypt_event(&event, &our_secret_hex, &our, &other) {
+                    on_added(dm_summary(&decrypted, &our, &other));
+                }
+            }
+        }));
+
+        if let Ok(mut live) = self.live.lock() {
+            live.extend(tasks);
+        }
     }
 
     fn message_count(
         &self,
         on_complete: Box<dyn FnOnce(Result<u64, StoreError>) + Send>,
     ) {
-        let count = match cache::get_messages(
-            &self.config_dir,
-            &self.our_secret_hex,
-            &self.our_pubkey_hex,
-            &self.other_pubkey_hex,
-        ) {
-            Ok(m) => m.len() as u64,
-            Err(_) => 0,
-        };
-        on_complete(Ok(count));
+        let history = self.history.clone();
+        let config_dir = self.config_dir.clone();
+        let our_secret_hex = self.our_secret_hex.clone();
+        let our = self.our_pubkey_hex.clone();
+        let other = self.other_pubkey_hex.clone();
+        // Count from the index of the still encrypted events: the caller is the GUI thread
+        let _ = self.runtime_handle.spawn_blocking(move || {
+            let pager = match cache::HistoryPager::open(&config_dir, &our_secret_hex, &our, &other) {
+                Ok(p) => p,
+                Err(_) => {
+                    on_complete(Ok(0));
+                    return;
+                }
+            };
+            let count = pager.indexed();
+            // The first history page can start from this index rather than reading the file again
+            let mut history = history.lock().unwrap();
+            if history.as_ref().map_or(true, |p| p.returned() == 0) {
+                *history = Some(pager);
+            }
+            drop(history);
+            on_complete(Ok(count));
+        });
     }
 
     fn get_message(
@@ -620,6 +786,10 @@ impl Transport for NostrTransport {
         TransportKind::Nostr
     }
 
+    fn set_credential(&self, _username: Option<&str>, password: &str) {
+        self.set_secret_key(password);
+    }
+
     fn send(
         &self,
         payload: &SendPayload,
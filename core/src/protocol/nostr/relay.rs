@@ -393,6 +393,19 @@ pub async fn run_relay_feed_stream(
     timeout_seconds: u32,
     tx: mpsc::UnboundedSender<StreamMessage>,
     secret_key: Option<String>,
+) {
+    run_relay_feed_stream_reqs(relay_url, vec![vec![filter]], timeout_seconds, tx, secret_key).await;
+}
+
+/// As `run_relay_feed_stream`, with several subscriptions on the one connection: one REQ
+/// (and subscription) per element of `reqs`, each with its filters. Ends once every
+/// subscription has reached EOSE or been closed.
+pub async fn run_relay_feed_stream_reqs(
+    relay_url: String,
+    reqs: Vec<Vec<Filter>>,
+    timeout_seconds: u32,
+    tx: mpsc::UnboundedSender<StreamMessage>,
+    secret_key: Option<String>,
 ) {
     let conn = match connect_to_relay(&relay_url).await {
         Ok(c) => c,
@@ -403,20 +416,34 @@ pub async fn run_relay_feed_stream(
         }
     };
 
-    let subscription_id = format!(
+    let subscription_prefix = format!(
         "tc_{}",
         std::time::SystemTime::now()
             .duration_since(std::time::UNIX_EPOCH)
             .unwrap_or_default()
             .as_millis()
     );
-    let filter_json = filter_to_json(&filter);
-    let req_message = format!("[\"REQ\",\"{}\",{}]", subscription_id, filter_json);
-    eprintln!("[nostr] REQ to {}: {}", relay_url, req_message);
+    let req_messages: Vec<String> = reqs
+        .iter()
+        .enumerate()
+        .map(|(i, filters)| {
+            let filters_json: Vec<String> = filters.iter().map(filter_to_json).collect();
+            format!("[\"REQ\",\"{}_{}\",{}]", subscription_prefix, i, filters_json.join(","))
+        })
+        .collect();
+    eprintln!(
+        "[nostr] REQ to {}: {} subscription(s), {} bytes",
+        relay_url,
+        req_messages.len(),
+        req_messages.iter().map(|r| r.len()).sum::<usize>()
+    );
 
     let mut conn = conn;
-    if conn.send_text(req_message.as_bytes()).await.is_err() {
-        return;
+    for req_message in &req_messages {
+        if conn.send_text(req_message.as_bytes()).await.is_err() {
+            let _ = tx.send(StreamMessage::Eose);
+            return;
+        }
     }
 
     let mut handler = NostrRelayHandler {
@@ -428,7 +455,8 @@ pub async fn run_relay_feed_stream(
         secret_key,
         auth_state: AuthState::None,
         auth_event_id: None,
-        req_message: Some(req_message),
+        open_subscriptions: req_messages.len(),
+        req_messages,
         pending_out: Vec::new(),
     };
 
@@ -480,7 +508,8 @@ pub async fn run_relay_dm_stream(
         secret_key,
         auth_state: AuthState::None,
         auth_event_id: None,
-        req_message: Some(req_message),
+        req_messages: vec![req_message],
+        open_subscriptions: 1,
         pending_out: Vec::new(),
     };
     let _ = conn.run(&mut handler).await;
@@ -537,7 +566,8 @@ pub async fn run_relay_dm_stream_nip17(
         secret_key,
         auth_state: AuthState::None,
         auth_event_id: None,
-        req_message: Some(req_message),
+        req_messages: vec![req_message],
+        open_subscriptions: 1,
         pending_out: Vec::new(),
     };
     let timeout_duration = Duration::from_secs(if exit_on_eose { 30 } else { 3600 });
@@ -641,13 +671,23 @@ struct NostrRelayHandler {
     auth_state: AuthState,
     /// Event ID of our AUTH response (to match against OK).
     auth_event_id: Option<String>,
-    /// Original REQ message to re-send after successful auth.
-    req_message: Option<String>,
+    /// Original REQ messages to re-send after successful auth.
+    req_messages: Vec<String>,
+    /// Subscriptions not yet at EOSE or closed; the stream ends when none remain.
+    open_subscriptions: usize,
     /// Text frames to send back to the relay (drained by the connection run loop).
     pending_out: Vec<Vec<u8>>,
 }
 
 impl NostrRelayHandler {
+    /// One subscription reached EOSE or was closed; stop when it was the last.
+    fn subscription_ended(&mut self) {
+        self.open_subscriptions = self.open_subscriptions.saturating_sub(1);
+        if self.open_subscriptions == 0 {
+            self.should_stop = true;
+        }
+    }
+
     /// Build and queue a NIP-42 AUTH response for the given challenge.
     fn respond_to_auth(&mut self, challenge: &str) {
         let secret = match &self.secret_key {
@@ -714,7 +754,7 @@ impl WebSocketHandler for NostrRelayHandler {
             Ok(RelayMessage::EndOfStoredEvents { .. }) => {
                 eprintln!("[nostr] {} EOSE", self.relay_url);
                 if self.exit_on_eose {
-                    self.should_stop = true;
+                    self.subscription_ended();
                 }
             }
             Ok(RelayMessage::Notice { message }) => {
@@ -731,8 +771,9 @@ impl WebSocketHandler for NostrRelayHandler {
                         // Auth succeeded but relay denied access (private/restricted).
                         eprintln!("[nostr] {} relay rejected after auth, marking as dead", self.relay_url);
                         let _ = self.tx.send(StreamMessage::AuthRequired(self.relay_url.clone()));
+                        self.should_stop = true;
                     }
-                    self.should_stop = true;
+                    self.subscription_ended();
                 }
             }
             Ok(RelayMessage::Auth { challenge }) => {
@@ -751,9 +792,12 @@ impl WebSocketHandler for NostrRelayHandler {
                         eprintln!("[nostr] {} AUTH accepted", self.relay_url);
                         self.auth_state = AuthState::Authenticated;
                         // Re-send the original subscription now that we're authenticated.
-                        if let Some(req) = self.req_message.take() {
+                        if !self.req_messages.is_empty() {
                             eprintln!("[nostr] {} re-sending REQ after auth", self.relay_url);
-                            self.pending_out.push(req.into_bytes());
+                            self.open_subscriptions = self.req_messages.len();
+                            for req in self.req_messages.drain(..) {
+                                self.pending_out.push(req.into_bytes());
+                            }
                         }
                     } else {
                         eprintln!("[nostr] {} AUTH rejected: {}", self.relay_url, message);
@@ -906,6 +950,79 @@ pub async fn fetch_profile_from_relays(
     (result, dead)
 }
 
+/// Most authors in one kind 0 filter. Relays reject oversized filters (strfry and
+/// nostr-rs-relay both cap a filter's authors at a few hundred).
+pub const PROFILE_FILTER_AUTHORS: usize = 100;
+/// Most filters in one REQ (NIP-11 `max_filters` is commonly 10 or more).
+pub const PROFILE_REQ_FILTERS: usize = 10;
+
+/// Fetch profile metadata (kind 0) for many pubkeys at once: per relay, one connection with
+/// one subscription for each PROFILE_FILTER_AUTHORS * PROFILE_REQ_FILTERS authors, all
+/// relays in parallel.
+/// `on_profile(pubkey, profile)` is called as profiles arrive, and again whenever a newer
+/// version of one turns up on another relay. Returns the relay URLs that required authentication.
+pub async fn fetch_profiles_from_relays(
+    relay_urls: &[String],
+    pubkeys: &[String],
+    timeout_seconds: u32,
+    secret_key: Option<String>,
+    mut on_profile: impl FnMut(&str, ProfileMetadata),
+) -> Vec<String> {
+    let wanted: std::collections::HashSet<&str> = pubkeys.iter().map(|s| s.as_str()).collect();
+    if wanted.is_empty() || relay_urls.is_empty() {
+        return Vec::new();
+    }
+    let filters: Vec<Filter> = pubkeys
+        .chunks(PROFILE_FILTER_AUTHORS)
+        .map(types::filter_profiles_by_authors)
+        .collect();
+
+    let reqs: Vec<Vec<Filter>> = filters.chunks(PROFILE_REQ_FILTERS).map(|c| c.to_vec()).collect();
+
+    let (tx, mut rx) = mpsc::unbounded_channel();
+    for relay_url in relay_urls {
+        let url = relay_url.clone();
+        let reqs = reqs.clone();
+        let tx = tx.clone();
+        let sk = secret_key.clone();
+        tokio::spawn(async move {
+            run_relay_feed_stream_reqs(url, reqs, timeout_seconds, tx, sk).await;
+        });
+    }
+    drop(tx);
+
+    // Newest created_at delivered per pubkey, so stale copies from slower relays are ignored
+    let mut delivered: HashMap<String, u64> = HashMap::new();
+    let mut dead: Vec<String> = Vec::new();
+    while let Some(msg) = rx.recv().await {
+        match msg {
+            StreamMessage::Event(event) => {
+                if event.kind != types::KIND_METADATA || !wanted.contains(event.pubkey.as_str()) {
+                    continue;
+                }
+                if delivered.get(&event.pubkey).map_or(false, |&at| at >= event.created_at) {
+                    continue;
+                }
+                match types::parse_profile(&event.content) {
+                    Ok(mut profile) => {
+                        profile.created_at = Some(event.created_at);
+                        delivered.insert(event.pubkey.clone(), event.created_at);
+                        on_profile(&event.pubkey, profile);
+                    }
+                    Err(e) => eprintln!("[nostr] bad profile for {}: {}", event.pubkey, e),
+                }
+            }
+            StreamMessage::AuthRequired(url) => {
+                if !dead.contains(&url) {
+                    dead.push(url);
+                }
+            }
+            StreamMessage::Eose | StreamMessage::Notice(_) => {}
+        }
+    }
+    dead
+}
+
 /// Fetch a user's relay list (kind 10002) from a single relay.
 pub async fn fetch_relay_list_from_relay(
     relay_url: &str,
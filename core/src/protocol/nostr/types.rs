@@ -363,6 +363,16 @@ pub fn filter_profile_by_author(author_pubkey: &str) -> Filter {
     }
 }
 
+/// Kind 0 profile metadata for several authors (newest per author; relays keep only the latest).
+pub fn filter_profiles_by_authors(author_pubkeys: &[String]) -> Filter {
+    Filter {
+        authors: Some(author_pubkeys.to_vec()),
+        kinds: Some(vec![KIND_METADATA]),
+        limit: Some(author_pubkeys.len() as u32),
+        ..Default::default()
+    }
+}
+
 /// Kind 10002 relay list by author.
 pub fn filter_relay_list_by_author(author_pubkey: &str) -> Filter {
     Filter {
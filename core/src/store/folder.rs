@@ -47,6 +47,19 @@ pub struct ThreadSummary {
     pub message_count: u64,
 }
 
+/// A part whose body `Folder::get_message_for_display` left out. Reported apart from the
+/// message stream, so nothing in the message itself can pass for one.
+#[derive(Debug, Clone, PartialEq)]
+pub struct DeferredPart {
+    /// Index of the part's entity in the stream, in the order a MIME parser starts them
+    /// (0 is the message itself).
+    pub entity: usize,
+    /// Section to pass to `Folder::get_message_part`.
+    pub section: String,
+    /// Approximate decoded size in bytes.
+    pub size: u64,
+}
+
 /// Metadata for a folder in a Store.
 #[derive(Debug, Clone)]
 pub struct FolderInfo {
@@ -55,6 +68,14 @@ pub struct FolderInfo {
     pub attributes: Vec<String>,
 }
 
+/// Message counts for a folder in a Store, from `Store::poll_folder_status`.
+#[derive(Debug, Clone)]
+pub struct FolderStatus {
+    pub name: String,
+    pub total: u64,
+    pub unread: u64,
+}
+
 /// A Folder contains Messages (e.g. IMAP mailbox, Maildir directory).
 ///
 /// All operations are non-blocking: methods accept callbacks and return immediately.
@@ -89,6 +110,30 @@ pub trait Folder: Send + Sync {
         on_complete: Box<dyn FnOnce(Result<u64, StoreError>) + Send>,
     );
 
+    /// Page backwards through a conversation (chat folders): deliver up to `count` messages
+    /// preceding the `skip` newest, in any order. `on_complete` gets `true` if older messages
+    /// may remain. Lets the UI show the newest messages first and backfill on demand.
+    /// Default: not supported (use `list_conversations`).
+    fn list_conversation_history(
+        &self,
+        _skip: u64,
+        _count: u64,
+        _on_summary: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<bool, StoreError>) + Send>,
+    ) {
+        on_complete(Err(StoreError::new("conversation history not supported for this folder")));
+    }
+
+    /// Push live changes (chat folders): `on_added` for each message that arrives after this
+    /// call, `on_updated` when an already delivered message changes (edit, decryption).
+    /// Runs until the folder is dropped. Default: no live updates.
+    fn subscribe(
+        &self,
+        _on_added: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+        _on_updated: Box<dyn Fn(ConversationSummary) + Send + Sync>,
+    ) {
+    }
+
     /// Get a single message by stable id.
     /// Calls `on_metadata` with the envelope when available,
     /// `on_content_chunk` for each chunk of raw message data,
@@ -101,6 +146,45 @@ pub trait Folder: Send + Sync {
         on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
     );
 
+    /// Get a message for display. Like `get_message`, but a backend that can fetch parts
+    /// separately may leave out the bodies of attachments: each such part is emitted with
+    /// its headers only, and listed in `on_deferred_parts`, which is called before the
+    /// first content chunk. Default delegates to `get_message` (nothing deferred).
+    fn get_message_for_display(
+        &self,
+        id: &MessageId,
+        on_metadata: Box<dyn Fn(crate::store::Envelope) + Send + Sync>,
+        _on_deferred_parts: Box<dyn FnOnce(Vec<DeferredPart>) + Send>,
+        on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        self.get_message(id, on_metadata, on_content_chunk, on_complete);
+    }
+
+    /// Get one deferred part of a message, by the section reported for it.
+    /// Calls `on_content_chunk` with the part's MIME headers followed by its
+    /// (still transfer-encoded) body, then `on_complete`. Default: not supported.
+    fn get_message_part(
+        &self,
+        _id: &MessageId,
+        _section: &str,
+        _on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        on_complete(Err(StoreError::new("part fetch not supported for this folder")));
+    }
+
+    /// Get the raw RFC 822 source of a message, exactly as stored, in chunks.
+    /// Default delegates to `get_message` and ignores the envelope.
+    fn get_message_source(
+        &self,
+        id: &MessageId,
+        on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        self.get_message(id, Box::new(|_| {}), on_content_chunk, on_complete);
+    }
+
     /// Delete a message by id. Calls `on_complete` when done.
     fn delete_message(
         &self,
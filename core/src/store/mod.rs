@@ -36,4 +36,5 @@ pub use send_session::SendSession;
 pub use store::{OpenFolderEvent, Store};
 pub use transport::Transport;
 
-pub use folder::{FolderInfo, ThreadId, ThreadSummary};
+pub use folder::{FolderInfo, FolderStatus, ThreadId, ThreadSummary};
+pub use folder::DeferredPart;
@@ -28,7 +28,7 @@ use std::any::Any;
 use crate::store::error::StoreError;
 use crate::store::folder::Folder;
 use crate::store::kinds::StoreKind;
-use crate::store::FolderInfo;
+use crate::store::{FolderInfo, FolderStatus};
 
 /// Event emitted during streaming open folder (e.g. IMAP SELECT response items).
 #[derive(Debug, Clone)]
@@ -70,6 +70,28 @@ pub trait Store: Send + Sync {
         on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
     );
 
+    /// Count messages in every folder without opening them (IMAP STATUS, Maildir directory
+    /// entries). Calls `on_status` for each folder, then `on_complete`. Meant to be called
+    /// periodically; network backends use a connection of their own so that polling never
+    /// queues behind folder operations. Default: not supported.
+    fn poll_folder_status(
+        &self,
+        _on_status: Box<dyn Fn(FolderStatus) + Send + Sync>,
+        on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>,
+    ) {
+        on_complete(Err(StoreError::new("folder status not supported for this store")));
+    }
+
+    /// Connect and authenticate ahead of use, and select the default folder where the
+    /// protocol has one, so that the first real request finds an idle connection. Meant for
+    /// stores the user has not opened yet; never prompts, so a store still waiting for a
+    /// password reports `NeedsCredential`. Default: nothing to prepare. Matrix and Nostr keep
+    /// it: Matrix's first sync is the folder listing itself, and Nostr opens its relay
+    /// connections per request, so there is no session to hold open.
+    fn warm_up(&self, on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send>) {
+        on_complete(Ok(()));
+    }
+
     /// Open a folder by name. Calls `on_event` for each status event (e.g. IMAP SELECT items),
     /// then `on_complete` with the opened Folder or an error. Returns immediately.
     fn open_folder(
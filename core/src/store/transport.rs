@@ -53,4 +53,8 @@ pub trait Transport: Send + Sync {
     fn set_oauth_credential(&self, _email: &str, _token: &str) {
         // Default: no-op
     }
+
+    /// Set the credential of a transport that shares its store's secret (e.g. a Nostr key),
+    /// when the UI provides it to the store. Default: no-op.
+    fn set_credential(&self, _username: Option<&str>, _password: &str) {}
 }
@@ -122,6 +122,18 @@ char *tagliacarte_transport_graph_new(const char *email);
 char *tagliacarte_store_maildir_new(const char *root_path);  /* caller frees with tagliacarte_free_string */
 char *tagliacarte_store_imap_new(const char *user_at_host, const char *host, uint16_t port);  /* imaps: for 993, imap: otherwise; caller frees URI */
 char *tagliacarte_store_pop3_new(const char *user_at_host, const char *host, uint16_t port);  /* pop3s for 995; auth via Authenticate flow; caller frees URI */
+/* URIs the _new functions above (and tagliacarte_transport_smtp_new) give for the same arguments,
+ * without creating anything, e.g. for a config entry's id. Caller frees; NULL if an argument is NULL. */
+char *tagliacarte_store_imap_uri(const char *user_at_host, const char *host, uint16_t port);
+char *tagliacarte_store_pop3_uri(const char *user_at_host, const char *host, uint16_t port);
+char *tagliacarte_transport_smtp_uri(const char *host, uint16_t port);
+char *tagliacarte_store_maildir_uri(const char *root_path);
+char *tagliacarte_store_nostr_uri(const char *pubkey_hex);  /* hex or npub; NULL if the key is invalid */
+char *tagliacarte_store_matrix_uri(const char *homeserver, const char *user_id);
+char *tagliacarte_store_nntp_uri(const char *user_at_host, const char *host, uint16_t port);
+char *tagliacarte_transport_nntp_uri(const char *user_at_host, const char *host, uint16_t port);
+char *tagliacarte_store_gmail_uri(const char *email);
+char *tagliacarte_store_graph_uri(const char *email);
 char *tagliacarte_store_nostr_new(const char *relays_comma_separated, const char *pubkey_hex);  /* pubkey_hex = 64-char hex or npub; nsec from credential store; caller frees URI */
 char *tagliacarte_store_matrix_new(const char *homeserver, const char *user_id, const char *access_token);  /* access_token NULL = must log in; caller frees URI */
 char *tagliacarte_store_nntp_new(const char *user_at_host, const char *host, uint16_t port);  /* nntps: for 563, nntp: otherwise; caller frees URI */
@@ -161,9 +173,26 @@ void tagliacarte_store_set_folder_list_callbacks(
 );
 void tagliacarte_store_refresh_folders(const char *store_uri);  /* returns immediately */
 
+/* Folder counts without opening folders (IMAP STATUS / LIST-STATUS on a connection of its own, Maildir
+ * directory entries). Polls now and then every interval_secs (minimum 30), calling on_folder_status for
+ * each folder on a backend thread. Calling again replaces the previous polling; interval_secs 0 stops it.
+ * Stops when the store is freed. Stores without folder counts never call back. */
+typedef void (*TagliacarteOnFolderStatus)(const char *store_uri, const char *folder_name, uint64_t total,
+    uint64_t unread, void *user_data);
+void tagliacarte_store_start_status_polling(const char *store_uri, uint32_t interval_secs,
+    TagliacarteOnFolderStatus on_folder_status, void *user_data);
+
+/* Connect, authenticate and select the default folder in the background, so that switching to the store
+ * later finds an idle connection. Returns immediately. Never requests credentials; failures are logged. */
+void tagliacarte_store_warm_up(const char *store_uri);
+
 /* Hierarchy delimiter for a store. Returns '\0' if unknown or not applicable. */
 char tagliacarte_store_hierarchy_delimiter(const char *store_uri);
 
+/* Name of a store's default folder (e.g. "INBOX"), or NULL if it has none (chat and news stores).
+ * Caller frees with tagliacarte_free_string. */
+char *tagliacarte_store_default_folder(const char *store_uri);
+
 /* Folder management: returns immediately; on success the existing on_folder_found / on_folder_removed
  * callback fires from a backend thread. On error, on_error(message, user_data) is called. */
 typedef void (*TagliacarteOnFolderOpError)(const char *message, void *user_data);
@@ -218,8 +247,28 @@ void tagliacarte_folder_set_message_list_callbacks(
     TagliacarteOnMessageListComplete on_complete,
     void *user_data
 );
+/* Forget the message list callbacks if they are still the ones set with user_data, so that
+ * user_data can be freed. Requests already made still finish with them. */
+void tagliacarte_folder_clear_message_list_callbacks(const char *folder_uri, void *user_data);
 void tagliacarte_folder_request_message_list(const char *folder_uri, uint64_t start, uint64_t end);  /* returns immediately */
 
+/* Chat folders (Nostr, Matrix): load up to count messages older than the skip newest, for showing the
+ * newest page first and backfilling on scroll. Summaries go to on_message_summary above (in any order);
+ * then on_complete(error, more, user_data) with the message list user_data. more != 0 if older messages
+ * may remain; error -1 if the folder does not support paging. Returns immediately. */
+typedef void (*TagliacarteOnConversationHistoryComplete)(int error, int more, void *user_data);
+void tagliacarte_folder_request_conversation_history(const char *folder_uri, uint64_t skip, uint64_t count,
+    TagliacarteOnConversationHistoryComplete on_complete);
+
+/* Chat folders: push messages that arrive after this call. on_message_added for each new message,
+ * on_message_updated when an already delivered message changes (a Matrix edit: same id, new text);
+ * same arguments as on_message_summary. A Matrix store runs one sync for all its subscribed folders.
+ * Runs until the folder is freed. Callbacks may run on a backend thread. */
+void tagliacarte_folder_subscribe(const char *folder_uri,
+    TagliacarteOnMessageSummary on_message_added,
+    TagliacarteOnMessageSummary on_message_updated,
+    void *user_data);
+
 /* Folder: event-driven get message.
  * Flow: on_metadata(envelope), then MIME entity events mirroring MimeHandler:
  *   on_start_entity, on_content_type, on_content_disposition, on_content_id, on_end_headers,
@@ -249,6 +298,44 @@ void tagliacarte_folder_set_message_callbacks(
 );
 void tagliacarte_folder_request_message(const char *folder_uri, const char *message_id);  /* returns immediately */
 
+/* Deferred parts: stores that fetch structure-first (IMAP) leave attachment bodies out of
+ * tagliacarte_folder_request_message. For each such entity, on_deferred_part(section, size) fires
+ * just before on_end_headers and the entity has no body content. Set after
+ * tagliacarte_folder_set_message_callbacks (which clears it); uses the same user_data. */
+typedef void (*TagliacarteOnDeferredPart)(const char *section, uint64_t size, void *user_data);
+void tagliacarte_folder_set_deferred_part_callback(const char *folder_uri, TagliacarteOnDeferredPart on_deferred_part);
+
+/* Owned body buffers: when set, replaces on_body_content for tagliacarte_folder_request_message.
+ * Body bytes are copied once, coalesced into buffers of up to 64 KiB; ownership of each buffer
+ * then passes to the receiver without another copy,
+ * which may read data until it calls tagliacarte_body_buffer_release(buffer) exactly once.
+ * Set after tagliacarte_folder_set_message_callbacks (which clears it); uses the same user_data. */
+typedef void (*TagliacarteOnBodyBuffer)(const uint8_t *data, size_t len, void *buffer, void *user_data);
+void tagliacarte_folder_set_body_buffer_callback(const char *folder_uri, TagliacarteOnBodyBuffer on_body_buffer);
+void tagliacarte_body_buffer_release(void *buffer);
+
+/* Fetch a deferred part: on_body_content receives the decoded body in chunks, then on_complete(0 or -1).
+ * Returns immediately; callbacks run on a background thread. */
+void tagliacarte_folder_request_message_part(
+    const char *folder_uri,
+    const char *message_id,
+    const char *section,
+    TagliacarteOnBodyContent on_body_content,
+    TagliacarteOnMessageComplete on_complete,
+    void *user_data
+);
+
+/* Fetch the raw RFC 822 source of a message, exactly as stored (memory-mapped for Maildir and mbox,
+ * which deliver it as a single chunk). on_chunk receives the bytes in order, then on_complete(0 or -1).
+ * Returns immediately; callbacks run on a background thread. */
+void tagliacarte_folder_request_message_source(
+    const char *folder_uri,
+    const char *message_id,
+    TagliacarteOnBodyContent on_chunk,
+    TagliacarteOnMessageComplete on_complete,
+    void *user_data
+);
+
 /* Async message count. Calls on_complete(count, error_code, user_data). error_code: 0 = success, -1 = error. */
 typedef void (*TagliacarteOnMessageCountComplete)(uint64_t count, int error, void *user_data);
 void tagliacarte_folder_message_count(
@@ -314,6 +401,22 @@ TagliacarteNostrProfile *tagliacarte_nostr_fetch_profile(
     const char *secret_key_hex /* NULL to skip NIP-42 auth */
 );
 
+/* Batch profile fetch: one subscription per relay for all pubkeys (hex or npub, comma-separated).
+ * Returns immediately. on_profile is called from a background thread as each kind 0 profile arrives
+ * (again if a newer version turns up on another relay); fields are NULL if absent. Then on_complete(0, user_data);
+ * on_complete(-1, user_data) if no valid pubkeys or relays were given. */
+typedef void (*TagliacarteOnNostrProfile)(const char *pubkey_hex, const char *display_name, const char *nip05,
+    const char *picture, void *user_data);
+typedef void (*TagliacarteOnNostrProfilesComplete)(int error, void *user_data);
+void tagliacarte_nostr_fetch_profiles(
+    const char *pubkeys_comma_separated,
+    const char *relays_comma_separated,
+    const char *secret_key_hex, /* NULL to skip NIP-42 auth */
+    TagliacarteOnNostrProfile on_profile,
+    TagliacarteOnNostrProfilesComplete on_complete,
+    void *user_data
+);
+
 /* Nostr media upload / delete (Blossom / NIP-96). */
 typedef void (*TagliacarteMediaUploadComplete)(const char *url, const char *file_hash, void *user_data);
 void tagliacarte_nostr_media_upload_async(
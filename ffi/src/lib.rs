@@ -43,15 +43,15 @@ use tagliacarte_core::config::{
 };
 use tagliacarte_core::mime::MimeParser;
 use tagliacarte_core::store::{
-    Address, Attachment, ConversationSummary, Envelope, Flag, Folder, FolderInfo, OpenFolderEvent,
-    SendPayload, SendSession, Store, StoreError, Transport,
+    Address, Attachment, ConversationSummary, Envelope, Flag, Folder, FolderInfo, FolderStatus,
+    DeferredPart, OpenFolderEvent, SendPayload, SendSession, Store, StoreError, Transport,
 };
 use tagliacarte_core::oauth::{
     GoogleOAuthProvider, MicrosoftOAuthProvider, OAuthProvider,
     OAuthTokenEntry, get_valid_access_token, save_oauth_token, start_oauth_flow,
 };
 use tagliacarte_core::protocol::graph::{GraphStore, GraphTransport};
-use tagliacarte_core::uri::{folder_uri, gmail_store_uri, gmail_smtp_transport_uri, imap_store_uri, maildir_store_uri, nntp_store_uri, nntp_transport_uri, pop3_store_uri, smtp_transport_uri};
+use tagliacarte_core::uri::{folder_uri, gmail_store_uri, gmail_smtp_transport_uri, graph_store_uri, imap_store_uri, maildir_store_uri, matrix_store_uri, nntp_store_uri, nntp_transport_uri, nostr_store_uri, pop3_store_uri, smtp_transport_uri};
 
 /// Wrapper so *mut c_void can be moved into Send closures (e.g. thread::spawn). C callbacks are invoked from worker threads.
 struct SendableUserData(*mut c_void);
@@ -103,6 +103,11 @@ type OnEndHeaders = extern "C" fn(*mut c_void);
 type OnBodyContent = extern "C" fn(*const u8, size_t, *mut c_void);
 type OnEndEntity = extern "C" fn(*mut c_void);
 type OnMessageComplete = extern "C" fn(c_int, *mut c_void);
+/// Body bytes handed over with ownership: (data, len, buffer, user_data). The receiver must pass
+/// buffer to tagliacarte_body_buffer_release once it no longer reads data.
+type OnBodyBuffer = extern "C" fn(*const u8, size_t, *mut c_void, *mut c_void);
+/// Deferred part announced while loading a message: section (for tagliacarte_folder_request_message_part), approximate size.
+type OnDeferredPart = extern "C" fn(*const c_char, u64, *mut c_void);
 
 #[allow(dead_code)]
 struct MessageCallbacks {
@@ -194,6 +199,8 @@ struct MessageCallbacksSend {
     on_body_content: OnBodyContent,
     on_end_entity: OnEndEntity,
     on_complete: OnMessageComplete,
+    on_deferred_part: Option<OnDeferredPart>,
+    on_body_buffer: Option<OnBodyBuffer>,
     user_data: usize,
 }
 
@@ -208,6 +215,8 @@ struct Registry {
     send_session_counter: std::sync::atomic::AtomicU64,
     /// NNTP shared state keyed by store URI, for read-state persistence.
     nntp_states: RwLock<HashMap<String, Arc<tagliacarte_core::protocol::nntp::NntpStoreState>>>,
+    /// Folder status polling tasks keyed by store URI.
+    status_pollers: RwLock<HashMap<String, tokio::task::JoinHandle<()>>>,
 }
 
 fn registry() -> &'static Registry {
@@ -226,6 +235,7 @@ fn registry() -> &'static Registry {
             send_sessions: RwLock::new(HashMap::new()),
             send_session_counter: std::sync::atomic::AtomicU64::new(0),
             nntp_states: RwLock::new(HashMap::new()),
+            status_pollers: RwLock::new(HashMap::new()),
         }
     })
 }
@@ -938,6 +948,107 @@ pub unsafe extern "C" fn tagliacarte_store_pop3_new(
     CString::new(uri).unwrap().into_raw()
 }
 
+/// URIs tagliacarte_store_imap_new, tagliacarte_store_pop3_new and tagliacarte_transport_smtp_new
+/// give for the same arguments, without creating anything (e.g. for a config entry's id).
+/// Caller frees with tagliacarte_free_string; NULL if an argument is null or not valid UTF-8.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_imap_uri(
+    user_at_host: *const c_char,
+    host: *const c_char,
+    port: u16,
+) -> *mut c_char {
+    match (ptr_to_str(user_at_host), ptr_to_str(host)) {
+        (Some(user), Some(host)) => CString::new(imap_store_uri(&user, &host, port)).unwrap().into_raw(),
+        _ => ptr::null_mut(),
+    }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_pop3_uri(
+    user_at_host: *const c_char,
+    host: *const c_char,
+    port: u16,
+) -> *mut c_char {
+    match (ptr_to_str(user_at_host), ptr_to_str(host)) {
+        (Some(user), Some(host)) => CString::new(pop3_store_uri(&user, &host, port)).unwrap().into_raw(),
+        _ => ptr::null_mut(),
+    }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_transport_smtp_uri(host: *const c_char, port: u16) -> *mut c_char {
+    match ptr_to_str(host) {
+        Some(host) => CString::new(smtp_transport_uri(&host, port)).unwrap().into_raw(),
+        None => ptr::null_mut(),
+    }
+}
+
+/// URIs of the other stores and of the NNTP transport, as for tagliacarte_store_imap_uri.
+/// tagliacarte_store_nostr_uri also accepts an npub, and gives NULL for an invalid key.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_maildir_uri(root_path: *const c_char) -> *mut c_char {
+    match ptr_to_str(root_path) {
+        Some(path) => CString::new(maildir_store_uri(&path)).unwrap().into_raw(),
+        None => ptr::null_mut(),
+    }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_nostr_uri(pubkey_hex: *const c_char) -> *mut c_char {
+    match ptr_to_str(pubkey_hex).and_then(|pk| tagliacarte_core::protocol::nostr::public_key_to_hex(&pk).ok()) {
+        Some(pk) => CString::new(nostr_store_uri(&pk)).unwrap().into_raw(),
+        None => ptr::null_mut(),
+    }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_matrix_uri(homeserver: *const c_char, user_id: *const c_char) -> *mut c_char {
+    match (ptr_to_str(homeserver), ptr_to_str(user_id)) {
+        (Some(home), Some(user)) => CString::new(matrix_store_uri(&home, &user)).unwrap().into_raw(),
+        _ => ptr::null_mut(),
+    }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_nntp_uri(
+    user_at_host: *const c_char,
+    host: *const c_char,
+    port: u16,
+) -> *mut c_char {
+    match (ptr_to_str(user_at_host), ptr_to_str(host)) {
+        (Some(user), Some(host)) => CString::new(nntp_store_uri(&user, &host, port)).unwrap().into_raw(),
+        _ => ptr::null_mut(),
+    }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_transport_nntp_uri(
+    user_at_host: *const c_char,
+    host: *const c_char,
+    port: u16,
+) -> *mut c_char {
+    match (ptr_to_str(user_at_host), ptr_to_str(host)) {
+        (Some(user), Some(host)) => CString::new(nntp_transport_uri(&user, &host, port)).unwrap().into_raw(),
+        _ => ptr::null_mut(),
+    }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_gmail_uri(email: *const c_char) -> *mut c_char {
+    match ptr_to_str(email) {
+        Some(email) => CString::new(gmail_store_uri(&email)).unwrap().into_raw(),
+        None => ptr::null_mut(),
+    }
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_graph_uri(email: *const c_char) -> *mut c_char {
+    match ptr_to_str(email) {
+        Some(email) => CString::new(graph_store_uri(&email)).unwrap().into_raw(),
+        None => ptr::null_mut(),
+    }
+}
+
 /// Create a Nostr store. relays_comma_separated: e.g. "wss://relay.damus.io,wss://relay.nostr.info". pubkey_hex: 64-char hex public key (or npub). The nsec is loaded from the credential store. Returns store URI (caller frees with tagliacarte_free_string), or NULL on error.
 #[no_mangle]
 pub unsafe extern "C" fn tagliacarte_store_nostr_new(
@@ -1054,6 +1165,13 @@ pub unsafe extern "C" fn tagliacarte_credential_provide(store_uri: *const c_char
         }
     };
     holder.store.set_credential(None, &password_str);
+    // A Nostr transport signs with the store's key; it loaded it (if any) when it was created
+    if let Some(id) = uri.strip_prefix("nostr:store:") {
+        let transport_uri = tagliacarte_core::uri::nostr_transport_uri(id);
+        if let Some(t) = registry().transports.read().ok().and_then(|g| g.get(&transport_uri).cloned()) {
+            t.0.set_credential(None, &password_str);
+        }
+    }
     // For Matrix, set_credential performs login and stores the access_token.
     // Persist the negotiated token (not the raw password) to credential storage.
     let persist_value = if let Some(matrix) = holder.store.as_any().downcast_ref::<MatrixStore>() {
@@ -1240,6 +1358,9 @@ pub unsafe extern "C" fn tagliacarte_store_free(store_uri: *const c_char) {
         Some(s) => s,
         None => return,
     };
+    if let Some(poller) = registry().status_pollers.write().ok().and_then(|mut g| g.remove(&uri)) {
+        poller.abort();
+    }
     let _ = registry().stores.write().map(|mut g| g.remove(&uri));
 }
 
@@ -1327,6 +1448,99 @@ pub unsafe extern "C" fn tagliacarte_store_refresh_folders(store_uri: *const c_c
     });
 }
 
+/// Folder counts from status polling: store URI, folder name, total messages, unread messages.
+type OnFolderStatus = extern "C" fn(*const c_char, *const c_char, u64, u64, *mut c_void);
+
+/// Shortest polling interval accepted by tagliacarte_store_start_status_polling.
+const MIN_STATUS_POLL_SECS: u32 = 30;
+
+/// Count the messages in every folder of a store now and then every interval_secs (at least 30),
+/// calling on_folder_status for each folder, from a background thread. Replaces any earlier
+/// polling for the store; interval_secs 0 just stops it. Polling also stops when the store is
+/// freed. Stores without folder status never call back. A round that fails is retried at the
+/// next interval; it never asks for credentials.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_start_status_polling(
+    store_uri: *const c_char,
+    interval_secs: u32,
+    on_folder_status: OnFolderStatus,
+    user_data: *mut c_void,
+) {
+    let uri = match ptr_to_str(store_uri) {
+        Some(s) => s,
+        None => return,
+    };
+    if let Some(old) = registry().status_pollers.write().ok().and_then(|mut g| g.remove(&uri)) {
+        old.abort();
+    }
+    if interval_secs == 0 {
+        return;
+    }
+    let weak = match registry().stores.read() {
+        Ok(g) => match g.get(&uri) {
+            Some(h) => Arc::downgrade(h),
+            None => return,
+        },
+        Err(_) => return,
+    };
+    let interval = std::time::Duration::from_secs(u64::from(interval_secs.max(MIN_STATUS_POLL_SECS)));
+    let user = Arc::new(SendableUserData(user_data));
+    let uri_c = Arc::new(CString::new(uri.as_str()).unwrap_or_default());
+    let poller = registry().runtime.spawn(async move {
+        loop {
+            // Stop once the store is gone
+            let holder = match weak.upgrade() {
+                Some(h) => h,
+                None => return,
+            };
+            let (tx, rx) = tokio::sync::oneshot::channel();
+            let user = user.clone();
+            let uri_c = uri_c.clone();
+            let on_status: Box<dyn Fn(FolderStatus) + Send + Sync> = Box::new(move |s: FolderStatus| {
+                if let Ok(name) = CString::new(s.name) {
+                    on_folder_status(uri_c.as_ptr(), name.as_ptr(), s.total, s.unread, user.0);
+                }
+            });
+            let on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send> = Box::new(move |result| {
+                let _ = tx.send(result);
+            });
+            // Connecting blocks (block_on), so keep it off the runtime's worker threads
+            let _ = tokio::task::spawn_blocking(move || holder.store.poll_folder_status(on_status, on_complete));
+            if let Ok(Err(e)) = rx.await {
+                eprintln!("[status] folder status poll failed: {}", e);
+            }
+            tokio::time::sleep(interval).await;
+        }
+    });
+    if let Ok(mut g) = registry().status_pollers.write() {
+        g.insert(uri, poller);
+    }
+}
+
+/// Connect a store in the background ahead of use (connect, authenticate, select the default
+/// folder) so that switching to it later is quick. Returns immediately. Never asks for
+/// credentials: a store still waiting for a password is skipped, other failures are logged.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_warm_up(store_uri: *const c_char) {
+    let uri = match ptr_to_str(store_uri) {
+        Some(s) => s,
+        None => return,
+    };
+    let holder = match registry().stores.read() {
+        Ok(g) => match g.get(&uri) {
+            Some(h) => Arc::clone(h),
+            None => return,
+        },
+        Err(_) => return,
+    };
+    let on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send> = Box::new(move |result| match result {
+        Ok(()) | Err(StoreError::NeedsCredential { .. }) => {}
+        Err(e) => eprintln!("[warm-up] {}: {}", uri, e),
+    });
+    // Connecting blocks (block_on), so keep it off the runtime's worker threads
+    let _ = registry().runtime.spawn_blocking(move || holder.store.warm_up(on_complete));
+}
+
 /// Start opening a folder by name. Returns immediately; on_select_event (if non-NULL), on_folder_ready, or on_error are invoked from a background thread.
 /// On success, on_folder_ready receives folder_uri (caller must free with tagliacarte_free_string). Do not free the store until the operation completes.
 #[no_mangle]
@@ -1457,6 +1671,51 @@ pub unsafe extern "C" fn tagliacarte_folder_set_message_list_callbacks(
     }
 }
 
+/// Forget the message list callbacks if they are still the ones set with user_data (another
+/// view may have set its own since), so that the caller can free user_data. Requests already
+/// made keep their copy and still complete.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_folder_clear_message_list_callbacks(folder_uri: *const c_char, user_data: *mut c_void) {
+    let uri = match ptr_to_str(folder_uri) {
+        Some(s) => s,
+        None => return,
+    };
+    if let Some(holder) = registry().folders.read().ok().and_then(|g| g.get(&uri).cloned()) {
+        let mut guard = holder.message_list_callbacks.write().unwrap();
+        if guard.as_ref().map_or(false, |c| c.user_data == user_data as usize) {
+            *guard = None;
+        }
+    }
+}
+
+/// Forward conversation summaries to an OnMessageSummary callback.
+fn summary_forwarder(
+    on_message_summary: OnMessageSummary,
+    user: Arc<SendableUserData>,
+) -> Box<dyn Fn(ConversationSummary) + Send + Sync> {
+    Box::new(move |s: ConversationSummary| {
+        let id = CString::new(s.id.as_str()).unwrap();
+        let subject = s
+            .envelope
+            .subject
+            .as_ref()
+            .map(|x| CString::new(x.as_str()).unwrap())
+            .unwrap_or_else(|| CString::new("").unwrap());
+        let from = CString::new(format_address_display(&s.envelope.from)).unwrap();
+        let date_secs = s.envelope.date.as_ref().map(|d| d.timestamp).unwrap_or(-1);
+        let flags_mask = flags_to_bitmask(&s.flags);
+        (on_message_summary)(
+            id.as_ptr(),
+            subject.as_ptr(),
+            from.as_ptr(),
+            date_secs,
+            s.size,
+            flags_mask,
+            user.0,
+        );
+    })
+}
+
 /// Start loading message list for range [start, end). Returns immediately; callbacks invoked from a background thread. Do not free the folder until on_complete has been called.
 #[no_mangle]
 pub unsafe extern "C" fn tagliacarte_folder_request_message_list(
@@ -1493,29 +1752,7 @@ pub unsafe extern "C" fn tagliacarte_folder_request_message_list(
             callbacks.on_complete,
             user.clone(),
         ));
-        let cb_state_for_summary = cb_state.clone();
-        let on_summary: Box<dyn Fn(ConversationSummary) + Send + Sync> =
-            Box::new(move |s: ConversationSummary| {
-                let id = CString::new(s.id.as_str()).unwrap();
-                let subject = s
-                    .envelope
-                    .subject
-                    .as_ref()
-                    .map(|x| CString::new(x.as_str()).unwrap())
-                    .unwrap_or_else(|| CString::new("").unwrap());
-                let from = CString::new(format_address_display(&s.envelope.from)).unwrap();
-                let date_secs = s.envelope.date.as_ref().map(|d| d.timestamp).unwrap_or(-1);
-                let flags_mask = flags_to_bitmask(&s.flags);
-                (cb_state_for_summary.0)(
-                    id.as_ptr(),
-                    subject.as_ptr(),
-                    from.as_ptr(),
-                    date_secs,
-                    s.size,
-                    flags_mask,
-                    cb_state_for_summary.2.0,
-                );
-            });
+        let on_summary = summary_forwarder(callbacks.on_message_summary, user.clone());
         let on_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send> = Box::new(move |result| {
             let code = if result.is_ok() { 0 } else { -1 };
             (cb_state.1)(code, cb_state.2.0);
@@ -1524,6 +1761,61 @@ pub unsafe extern "C" fn tagliacarte_folder_request_message_list(
     }
 }
 
+/// Callback for a conversation history page: (error, more, user_data). more != 0 if older messages may remain.
+type OnConversationHistoryComplete = extern "C" fn(c_int, c_int, *mut c_void);
+
+/// Load up to `count` conversation messages older than the `skip` newest (chat folders).
+/// Summaries go to the message list callback (tagliacarte_folder_set_message_list_callbacks);
+/// then on_complete(error, more, user_data) with that callback's user_data. error -1 if the
+/// folder does not support paging. Returns immediately; callbacks run on a background thread.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_folder_request_conversation_history(
+    folder_uri: *const c_char,
+    skip: u64,
+    count: u64,
+    on_complete: OnConversationHistoryComplete,
+) {
+    let holder = match ptr_to_str(folder_uri).and_then(|uri| registry().folders.read().ok().and_then(|g| g.get(&uri).cloned())) {
+        Some(h) => h,
+        None => return,
+    };
+    let callbacks = match holder.message_list_callbacks.read().ok().and_then(|g| g.clone()) {
+        Some(c) => c,
+        None => return,
+    };
+    let user = Arc::new(SendableUserData(callbacks.user_data as *mut c_void));
+    let on_summary = summary_forwarder(callbacks.on_message_summary, user.clone());
+    let on_history_complete: Box<dyn FnOnce(Result<bool, StoreError>) + Send> = Box::new(move |result| {
+        match result {
+            Ok(more) => (on_complete)(0, more as c_int, user.0),
+            Err(_) => (on_complete)(-1, 0, user.0),
+        }
+    });
+    holder.folder.list_conversation_history(skip, count, on_summary, on_history_complete);
+}
+
+/// Receive messages that arrive in an open chat folder (Nostr, Matrix) after this call:
+/// on_message_added for each new message, on_message_updated when a delivered one changes.
+/// Same arguments as the message summary callback. Runs until the folder is freed; callbacks
+/// run on a background thread. Folders without live updates never call back.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_folder_subscribe(
+    folder_uri: *const c_char,
+    on_message_added: OnMessageSummary,
+    on_message_updated: OnMessageSummary,
+    user_data: *mut c_void,
+) {
+    let holder = match ptr_to_str(folder_uri).and_then(|uri| registry().folders.read().ok().and_then(|g| g.get(&uri).cloned())) {
+        Some(h) => h,
+        None => return,
+    };
+    let user = Arc::new(SendableUserData(user_data));
+    holder.folder.subscribe(
+        summary_forwarder(on_message_added, user.clone()),
+        summary_forwarder(on_message_updated, user),
+    );
+}
+
 /// Set callbacks for get message. Call tagliacarte_folder_request_message to start; callbacks may run on a background thread.
 #[no_mangle]
 pub unsafe extern "C" fn tagliacarte_folder_set_message_callbacks(
@@ -1555,13 +1847,71 @@ pub unsafe extern "C" fn tagliacarte_folder_set_message_callbacks(
                 on_body_content,
                 on_end_entity,
                 on_complete,
+                on_deferred_part: None,
+                on_body_buffer: None,
                 user_data: user_data as usize,
             });
         }
     }
 }
 
+/// Set the deferred-part callback for get message (same user_data as the message callbacks).
+/// Call after tagliacarte_folder_set_message_callbacks, which clears it.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_folder_set_deferred_part_callback(
+    folder_uri: *const c_char,
+    on_deferred_part: OnDeferredPart,
+) {
+    let uri = match ptr_to_str(folder_uri) {
+        Some(s) => s,
+        None => return,
+    };
+    if let Ok(guard) = registry().folders.read() {
+        if let Some(holder) = guard.get(&uri) {
+            if let Some(ref mut cbs) = *holder.message_callbacks.write().unwrap() {
+                cbs.on_deferred_part = Some(on_deferred_part);
+            }
+        }
+    }
+}
+
+/// Set the owned-buffer body callback for get message (same user_data as the message callbacks).
+/// When set it replaces on_body_content: body bytes are copied once, into coalescing buffers,
+/// whose ownership then passes to the receiver without a further copy.
+/// Call after tagliacarte_folder_set_message_callbacks, which clears it.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_folder_set_body_buffer_callback(
+    folder_uri: *const c_char,
+    on_body_buffer: OnBodyBuffer,
+) {
+    let uri = match ptr_to_str(folder_uri) {
+        Some(s) => s,
+        None => return,
+    };
+    if let Ok(guard) = registry().folders.read() {
+        if let Some(holder) = guard.get(&uri) {
+            if let Some(ref mut cbs) = *holder.message_callbacks.write().unwrap() {
+                cbs.on_body_buffer = Some(on_body_buffer);
+            }
+        }
+    }
+}
+
+/// Release a buffer received through the body buffer callback. No-op if buffer is NULL.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_body_buffer_release(buffer: *mut c_void) {
+    if !buffer.is_null() {
+        drop(Box::from_raw(buffer as *mut Vec<u8>));
+    }
+}
+
+/// Body bytes are coalesced up to this size before crossing the FFI boundary.
+const BODY_CHUNK_SIZE: usize = 64 * 1024;
+
 /// MimeHandler that forwards events to C callbacks (used for streaming MIME parsing).
+/// The parser reports body content line by line, borrowed from its input; the handler copies
+/// it into one buffer and flushes at BODY_CHUNK_SIZE, at entity end, and after each receive()
+/// (see flush_body). That copy is the only one on the way to the UI's owned-buffer callback.
 struct FfiMimeHandler {
     on_start_entity: OnStartEntity,
     on_content_type: OnContentType,
@@ -1570,13 +1920,47 @@ struct FfiMimeHandler {
     on_end_headers: OnEndHeaders,
     on_body_content: OnBodyContent,
     on_end_entity: OnEndEntity,
+    on_deferred_part: Option<OnDeferredPart>,
+    on_body_buffer: Option<OnBodyBuffer>,
+    /// Body bytes not yet delivered.
+    body: Vec<u8>,
+    /// Parts the folder left out, as it reported them (never from the message's own headers).
+    deferred: Vec<DeferredPart>,
+    /// Entities started so far; the current one's index is this minus one.
+    entities: usize,
+    /// The current entity, if it is a deferred part.
+    current_deferred: Option<DeferredPart>,
     user_data: *mut c_void,
 }
 
 unsafe impl Send for FfiMimeHandler {}
 
+impl FfiMimeHandler {
+    /// Deliver pending body bytes: ownership moves to the UI with on_body_buffer, else on_body_content.
+    fn flush_body(&mut self) {
+        if self.body.is_empty() {
+            return;
+        }
+        match self.on_body_buffer {
+            Some(cb) => {
+                let buf = Box::new(std::mem::take(&mut self.body));
+                let (data, len) = (buf.as_ptr(), buf.len());
+                cb(data, len, Box::into_raw(buf) as *mut c_void, self.user_data);
+            }
+            None => {
+                (self.on_body_content)(self.body.as_ptr(), self.body.len(), self.user_data);
+                self.body.clear();
+            }
+        }
+    }
+}
+
 impl tagliacarte_core::mime::MimeHandler for FfiMimeHandler {
     fn start_entity(&mut self, _boundary: Option<&str>) -> Result<(), tagliacarte_core::mime::MimeParseError> {
+        self.flush_body();
+        let entity = self.entities;
+        self.entities += 1;
+        self.current_deferred = self.deferred.iter().find(|d| d.entity == entity).cloned();
         (self.on_start_entity)(self.user_data);
         Ok(())
     }
@@ -1610,18 +1994,28 @@ impl tagliacarte_core::mime::MimeHandler for FfiMimeHandler {
     }
 
     fn end_headers(&mut self) -> Result<(), tagliacarte_core::mime::MimeParseError> {
+        if let (Some(cb), Some(part)) = (self.on_deferred_part, self.current_deferred.take()) {
+            if let Ok(c) = CString::new(part.section) {
+                cb(c.as_ptr(), part.size, self.user_data);
+            }
+        }
         (self.on_end_headers)(self.user_data);
         Ok(())
     }
 
     fn body_content(&mut self, data: &[u8]) -> Result<(), tagliacarte_core::mime::MimeParseError> {
-        if !data.is_empty() {
-            (self.on_body_content)(data.as_ptr(), data.len(), self.user_data);
+        if self.body.capacity() == 0 {
+            self.body.reserve(BODY_CHUNK_SIZE);
+        }
+        self.body.extend_from_slice(data);
+        if self.body.len() >= BODY_CHUNK_SIZE {
+            self.flush_body();
         }
         Ok(())
     }
 
     fn end_entity(&mut self, _boundary: Option<&str>) -> Result<(), tagliacarte_core::mime::MimeParseError> {
+        self.flush_body();
         (self.on_end_entity)(self.user_data);
         Ok(())
     }
@@ -1687,15 +2081,32 @@ pub unsafe extern "C" fn tagliacarte_folder_request_message(
             on_end_headers: cbs.on_end_headers,
             on_body_content: cbs.on_body_content,
             on_end_entity: cbs.on_end_entity,
+            on_deferred_part: cbs.on_deferred_part,
+            on_body_buffer: cbs.on_body_buffer,
+            body: Vec::new(),
+            deferred: Vec::new(),
+            entities: 0,
+            current_deferred: None,
             user_data,
         };
         let parser = Arc::new(std::sync::Mutex::new(Some(MimeParser::new(handler))));
+        // Comes before the first chunk, so every entity is checked against the full list
+        let parser_deferred = parser.clone();
+        let on_deferred_parts: Box<dyn FnOnce(Vec<DeferredPart>) + Send> = Box::new(move |parts| {
+            if let Ok(mut guard) = parser_deferred.lock() {
+                if let Some(ref mut p) = *guard {
+                    p.handler_mut().deferred = parts;
+                }
+            }
+        });
         // on_content_chunk: feed directly to MimeParser; events fire synchronously to UI
         let parser_chunk = parser.clone();
         let on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync> = Box::new(move |chunk: &[u8]| {
             if let Ok(mut guard) = parser_chunk.lock() {
                 if let Some(ref mut p) = *guard {
                     let _ = p.receive(chunk);
+                    // Keep display progressive: hand over whatever this chunk decoded
+                    p.handler_mut().flush_body();
                 }
             }
         });
@@ -1711,12 +2122,129 @@ pub unsafe extern "C" fn tagliacarte_folder_request_message(
             if let Ok(mut guard) = parser_complete.lock() {
                 if let Some(mut p) = guard.take() {
                     let _ = p.close();
+                    p.handler_mut().flush_body();
                 }
             }
             (cbs_complete.on_complete)(0, ud);
         });
-        holder.folder.get_message(&id, on_metadata, on_content_chunk, on_complete);
+        holder.folder.get_message_for_display(&id, on_metadata, on_deferred_parts, on_content_chunk, on_complete);
+    }
+}
+
+/// MimeHandler for a single deferred part: forwards the decoded body of the outermost entity only.
+struct PartBodyHandler {
+    on_body_content: OnBodyContent,
+    depth: usize,
+    user_data: *mut c_void,
+}
+
+unsafe impl Send for PartBodyHandler {}
+
+impl tagliacarte_core::mime::MimeHandler for PartBodyHandler {
+    fn start_entity(&mut self, _boundary: Option<&str>) -> Result<(), tagliacarte_core::mime::MimeParseError> {
+        self.depth += 1;
+        Ok(())
     }
+
+    fn body_content(&mut self, data: &[u8]) -> Result<(), tagliacarte_core::mime::MimeParseError> {
+        if self.depth <= 1 && !data.is_empty() {
+            (self.on_body_content)(data.as_ptr(), data.len(), self.user_data);
+        }
+        Ok(())
+    }
+
+    fn end_entity(&mut self, _boundary: Option<&str>) -> Result<(), tagliacarte_core::mime::MimeParseError> {
+        self.depth = self.depth.saturating_sub(1);
+        Ok(())
+    }
+}
+
+/// Fetch one deferred part (section from the deferred-part callback). Returns immediately;
+/// on_body_content receives the decoded part body in chunks, then on_complete(0 or -1).
+/// Callbacks run on a background thread.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_folder_request_message_part(
+    folder_uri: *const c_char,
+    message_id: *const c_char,
+    section: *const c_char,
+    on_body_content: OnBodyContent,
+    on_complete: OnMessageComplete,
+    user_data: *mut c_void,
+) {
+    let holder = match ptr_to_str(folder_uri).and_then(|uri| registry().folders.read().ok().and_then(|g| g.get(&uri).cloned())) {
+        Some(h) => h,
+        None => {
+            on_complete(-1, user_data);
+            return;
+        }
+    };
+    let (id_str, section) = match (ptr_to_str(message_id), ptr_to_str(section)) {
+        (Some(i), Some(s)) => (i, s),
+        _ => {
+            on_complete(-1, user_data);
+            return;
+        }
+    };
+    let handler = PartBodyHandler { on_body_content, depth: 0, user_data };
+    let parser = Arc::new(std::sync::Mutex::new(Some(MimeParser::new(handler))));
+    let parser_chunk = parser.clone();
+    let on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync> = Box::new(move |chunk: &[u8]| {
+        if let Ok(mut guard) = parser_chunk.lock() {
+            if let Some(ref mut p) = *guard {
+                let _ = p.receive(chunk);
+            }
+        }
+    });
+    let user = Arc::new(SendableUserData(user_data));
+    let on_part_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send> = Box::new(move |result| {
+        if let Ok(mut guard) = parser.lock() {
+            if let Some(mut p) = guard.take() {
+                let _ = p.close();
+            }
+        }
+        (on_complete)(if result.is_ok() { 0 } else { -1 }, user.0);
+    });
+    holder.folder.get_message_part(&MessageId::new(&id_str), &section, on_content_chunk, on_part_complete);
+}
+
+/// Fetch the raw RFC 822 source of a message, exactly as stored. Returns immediately;
+/// on_chunk receives the bytes in order, then on_complete(0 or -1). Callbacks run on a background thread.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_folder_request_message_source(
+    folder_uri: *const c_char,
+    message_id: *const c_char,
+    on_chunk: OnBodyContent,
+    on_complete: OnMessageComplete,
+    user_data: *mut c_void,
+) {
+    let holder = match ptr_to_str(folder_uri).and_then(|uri| registry().folders.read().ok().and_then(|g| g.get(&uri).cloned())) {
+        Some(h) => h,
+        None => {
+            on_complete(-1, user_data);
+            return;
+        }
+    };
+    let id_str = match ptr_to_str(message_id) {
+        Some(i) => i,
+        None => {
+            on_complete(-1, user_data);
+            return;
+        }
+    };
+    let user = Arc::new(SendableUserData(user_data));
+    let user_chunk = user.clone();
+    let on_content_chunk: Box<dyn Fn(&[u8]) + Send + Sync> = Box::new(move |chunk: &[u8]| {
+        if !chunk.is_empty() {
+            (on_chunk)(chunk.as_ptr(), chunk.len(), user_chunk.0);
+        }
+    });
+    let on_source_complete: Box<dyn FnOnce(Result<(), StoreError>) + Send> = Box::new(move |result| {
+        (on_complete)(if result.is_ok() { 0 } else { -1 }, user.0);
+    });
+    // Local stores read the source synchronously; keep that off the caller's (GUI) thread.
+    let _ = registry().runtime.spawn_blocking(move || {
+        holder.folder.get_message_source(&MessageId::new(&id_str), on_content_chunk, on_source_complete)
+    });
 }
 
 /// Callback for message count result.
@@ -2222,6 +2750,65 @@ pub unsafe extern "C" fn tagliacarte_nostr_fetch_profile(
     Box::into_raw(result)
 }
 
+/// Callback for each profile of a batch fetch: (pubkey_hex, display_name, nip05, picture, user_data); NULL if absent.
+type OnNostrProfile = extern "C" fn(*const c_char, *const c_char, *const c_char, *const c_char, *mut c_void);
+/// Callback when a batch profile fetch has finished: (error, user_data).
+type OnNostrProfilesComplete = extern "C" fn(c_int, *mut c_void);
+
+/// Fetch profile metadata (kind 0) for many pubkeys over one connection per relay. Async: returns immediately.
+/// pubkeys_comma_separated: hex or npub keys. on_profile is called as each profile arrives (possibly again
+/// with a newer version), then on_complete(0, user_data); on_complete(-1, user_data) on invalid arguments.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_nostr_fetch_profiles(
+    pubkeys_comma_separated: *const c_char,
+    relays_comma_separated: *const c_char,
+    secret_key_hex: *const c_char,
+    on_profile: OnNostrProfile,
+    on_complete: OnNostrProfilesComplete,
+    user_data: *mut c_void,
+) {
+    let split = |p: *const c_char| -> Vec<String> {
+        ptr_to_str(p)
+            .map(|s| s.split(',').map(|s| s.trim().to_string()).filter(|s| !s.is_empty()).collect())
+            .unwrap_or_default()
+    };
+    let pubkeys: Vec<String> = split(pubkeys_comma_separated)
+        .iter()
+        .filter_map(|pk| tagliacarte_core::protocol::nostr::public_key_to_hex(pk).ok())
+        .collect();
+    let relays = split(relays_comma_separated);
+    if pubkeys.is_empty() || relays.is_empty() {
+        set_last_error(&StoreError::new("No pubkeys or no relays provided"));
+        (on_complete)(-1, user_data);
+        return;
+    }
+    let sk: Option<String> = ptr_to_str(secret_key_hex).map(|s| s.to_string());
+
+    let user = Arc::new(SendableUserData(user_data));
+    registry().runtime.spawn(async move {
+        let dead = tagliacarte_core::protocol::nostr::fetch_profiles_from_relays(
+            &relays, &pubkeys, 10, sk,
+            |pubkey, profile| {
+                let pk_c = match CString::new(pubkey) { Ok(c) => c, Err(_) => return };
+                let name_c = profile.name.and_then(|s| CString::new(s).ok());
+                let nip05_c = profile.nip05.and_then(|s| CString::new(s).ok());
+                let picture_c = profile.picture.and_then(|s| CString::new(s).ok());
+                (on_profile)(
+                    pk_c.as_ptr(),
+                    name_c.as_ref().map_or(ptr::null(), |c| c.as_ptr()),
+                    nip05_c.as_ref().map_or(ptr::null(), |c| c.as_ptr()),
+                    picture_c.as_ref().map_or(ptr::null(), |c| c.as_ptr()),
+                    user.0,
+                );
+            },
+        ).await;
+        if !dead.is_empty() {
+            eprintln!("[nostr] profile batch: {} relays required auth: {:?}", dead.len(), dead);
+        }
+        (on_complete)(0, user.0);
+    });
+}
+
 // ---------- Nostr media upload / delete ----------
 
 type OnMediaUploadComplete = extern "C" fn(*const c_char, *const c_char, *mut c_void);
@@ -3159,6 +3746,24 @@ pub unsafe extern "C" fn tagliacarte_store_hierarchy_delimiter(store_uri: *const
     holder.store.hierarchy_delimiter().map(|c| c as c_char).unwrap_or(0)
 }
 
+/// Get the name of a store's default folder (e.g. "INBOX"). Returns NULL if the store has none
+/// (chat and news stores). Caller must free with tagliacarte_free_string.
+#[no_mangle]
+pub unsafe extern "C" fn tagliacarte_store_default_folder(store_uri: *const c_char) -> *mut c_char {
+    let uri = match ptr_to_str(store_uri) {
+        Some(s) => s,
+        None => return ptr::null_mut(),
+    };
+    let holder = match registry().stores.read().ok().and_then(|g| g.get(&uri).cloned()) {
+        Some(h) => h,
+        None => return ptr::null_mut(),
+    };
+    match holder.store.default_folder().and_then(|name| CString::new(name).ok()) {
+        Some(c) => c.into_raw(),
+        None => ptr::null_mut(),
+    }
+}
+
 /// Create a folder in the store. Returns immediately. On success, the existing on_folder_found callback fires.
 /// On error, on_error(message, user_data) is called from a backend thread.
 #[no_mangle]
@@ -0,0 +1,208 @@
+/*
+ * AvatarStore.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AvatarStore.h"
+#include "IconUtils.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPixmapCache>
+#include <QPointer>
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentRun>
+#include <cstdio>
+#include <iterator>
+
+AvatarStore *AvatarStore::instance() {
+    static AvatarStore *s_instance = new AvatarStore(QCoreApplication::instance());
+    return s_instance;
+}
+
+AvatarStore::AvatarStore(QObject *parent)
+    : QObject(parent)
+    , m_nam(new QNetworkAccessManager(this))
+{
+    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    m_dir = cacheDir + QStringLiteral("/avatars");
+    QDir().mkpath(m_dir);
+    auto *cache = new QNetworkDiskCache(this);
+    cache->setCacheDirectory(cacheDir + QStringLiteral("/avatar-http"));
+    cache->setMaximumCacheSize(50 * 1024 * 1024);
+    m_nam->setCache(cache);
+    connect(m_nam, &QNetworkAccessManager::finished, this, &AvatarStore::onFinished);
+}
+
+QString AvatarStore::thumbnailFile(const QString &key, int px) const {
+    return m_dir + QStringLiteral("/") + key + QStringLiteral("_") + QString::number(px) + QStringLiteral(".png");
+}
+
+QString AvatarStore::thumbnailPath(const QString &key, int px) {
+    QString path = thumbnailFile(key, px);
+    if (m_ready.contains(key)) {
+        return path;
+    }
+    if (QFile::exists(path)) {
+        m_ready.insert(key);
+        return path;
+    }
+    // Full-size image from before thumbnails were kept: convert it once
+    QString legacy = m_dir + QStringLiteral("/") + key + QStringLiteral(".img");
+    QFile f(legacy);
+    if (!m_pending.contains(key) && f.open(QIODevice::ReadOnly)) {
+        QByteArray data = f.readAll();
+        f.close();
+        f.remove();
+        m_pending.insert(key, QUrl());
+        makeThumbnails(key, data);
+    }
+    return QString();
+}
+
+QPixmap AvatarStore::pixmap(const QString &key, int px, qreal dpr) {
+    int devicePx = qRound(px * dpr);
+    // The generation retires entries made from replaced thumbnails
+    QString cacheKey = QStringLiteral("avatar:%1:%2:%3").arg(key).arg(devicePx).arg(m_generation.value(key));
+    QPixmap pm;
+    if (QPixmapCache::find(cacheKey, &pm)) {
+        return pm;
+    }
+    // Smallest thumbnail at least as large as needed, so scaling only ever reduces
+    int source = ThumbnailSizes[std::size(ThumbnailSizes) - 1];
+    for (int s : ThumbnailSizes) {
+        if (s >= devicePx) {
+            source = s;
+            break;
+        }
+    }
+    QString path = thumbnailPath(key, source);
+    if (path.isEmpty() || !pm.load(path)) {
+        return QPixmap();
+    }
+    if (pm.width() != devicePx) {
+        pm = pm.scaled(devicePx, devicePx, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+    pm.setDevicePixelRatio(dpr);
+    QPixmapCache::insert(cacheKey, pm);
+    return pm;
+}
+
+QIcon AvatarStore::icon(const QString &key, int px) {
+    QIcon icon;
+    for (qreal dpr : { 1.0, 2.0 }) {
+        QPixmap pm = pixmap(key, px, dpr);
+        if (pm.isNull()) {
+            return QIcon();
+        }
+        icon.addPixmap(pm);
+    }
+    return icon;
+}
+
+void AvatarStore::request(const QString &key, const QUrl &url) {
+    if (key.isEmpty() || !url.isValid() || m_pending.contains(key)) {
+        return;
+    }
+    m_pending.insert(key, url);
+    QString host = url.host().toLower();
+    m_hostQueues[host].enqueue(key);
+    startNext(host);
+}
+
+void AvatarStore::startNext(const QString &host) {
+    auto qit = m_hostQueues.find(host);
+    while (qit != m_hostQueues.end() && !qit->isEmpty() && m_hostActive.value(host) < MaxPerHost) {
+        QString key = qit->dequeue();
+        QNetworkRequest req(m_pending.value(key));
+        // PreferNetwork: fresh entries come from disk, stale ones are revalidated conditionally
+        req.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+        req.setAttribute(QNetworkRequest::CacheSaveControlAttribute, true);
+        req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+        req.setHeader(QNetworkRequest::UserAgentHeader, QStringLiteral("Tagliacarte/1.0"));
+        req.setAttribute(QNetworkRequest::User, key);
+        m_hostActive[host]++;
+        QNetworkReply *reply = m_nam->get(req);
+        // An oversized avatar is dropped as it arrives, or at once from its Content-Length
+        connect(reply, &QNetworkReply::downloadProgress, reply, [reply](qint64 received, qint64 total) {
+            if (received > MaxImageBytes || total > MaxImageBytes) {
+                reply->abort();
+            }
+        });
+    }
+    if (qit != m_hostQueues.end() && qit->isEmpty()) {
+        m_hostQueues.erase(qit);
+    }
+}
+
+void AvatarStore::onFinished(QNetworkReply *reply) {
+    reply->deleteLater();
+    QString key = reply->request().attribute(QNetworkRequest::User).toString();
+    QString host = reply->request().url().host().toLower();
+    if (--m_hostActive[host] <= 0) {
+        m_hostActive.remove(host);
+    }
+    startNext(host);
+
+    bool fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+    if (reply->error() != QNetworkReply::NoError || reply->bytesAvailable() > MaxImageBytes) {
+        fprintf(stderr, "[avatar] download failed for %s: %s\n",
+            qPrintable(key), qPrintable(reply->errorString()));
+        m_pending.remove(key);
+    } else if (fromCache && !thumbnailPath(key, ThumbnailSizes[0]).isEmpty()) {
+        // Not modified since the thumbnails were made
+        m_pending.remove(key);
+    } else {
+        makeThumbnails(key, reply->readAll());
+    }
+}
+
+void AvatarStore::makeThumbnails(const QString &key, const QByteArray &data) {
+    QStringList paths;
+    for (int px : ThumbnailSizes) {
+        paths.append(thumbnailFile(key, px));
+    }
+    QPointer<AvatarStore> self(this);
+    (void)QtConcurrent::run([self, key, data, paths]() {
+        QImage image;
+        bool ok = image.loadFromData(data);
+        if (ok) {
+            int i = 0;
+            for (int px : ThumbnailSizes) {
+                ok = circularAvatarImage(image, px).save(paths.at(i++), "PNG") && ok;
+            }
+        } else {
+            fprintf(stderr, "[avatar] not a valid image for %s (%lld bytes)\n", qPrintable(key), (long long)data.size());
+        }
+        QMetaObject::invokeMethod(qApp, [self, key, ok]() {
+            if (!self) return;
+            self->m_pending.remove(key);
+            if (ok) {
+                self->m_ready.insert(key);
+                self->m_generation[key]++;
+                emit self->avatarReady(key);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
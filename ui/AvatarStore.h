@@ -0,0 +1,91 @@
+/*
+ * AvatarStore.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AVATARSTORE_H
+#define AVATARSTORE_H
+
+#include <QObject>
+#include <QHash>
+#include <QIcon>
+#include <QPixmap>
+#include <QQueue>
+#include <QSet>
+#include <QString>
+#include <QUrl>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/**
+ * Downloads contact avatars and keeps them on disk as small circular thumbnails.
+ *
+ * One shared QNetworkAccessManager with its own QNetworkDiskCache, so a refresh is a
+ * conditional request (ETag / Last-Modified) and an unchanged picture is not re-decoded.
+ * Requests for the same key are merged, and at most MaxPerHost run against one host.
+ * Each picture is decoded once, off the GUI thread, into a PNG per ThumbnailSizes entry;
+ * views load those instead of the full-size image.
+ */
+class AvatarStore : public QObject {
+    Q_OBJECT
+public:
+    static AvatarStore *instance();
+
+    /** Thumbnail edge lengths in pixels: folder tree icon, chat avatar, chat avatar at 2x. */
+    static constexpr int ThumbnailSizes[] = { 24, 40, 80 };
+
+    /** Path of key's thumbnail of px pixels (one of ThumbnailSizes), or empty if there is none yet. */
+    QString thumbnailPath(const QString &key, int px);
+
+    /**
+     * key's avatar, ready to paint at px logical pixels on a device with ratio dpr; null if
+     * there is none yet. Kept in QPixmapCache by key, size and ratio, so painting never
+     * decodes or scales.
+     */
+    QPixmap pixmap(const QString &key, int px, qreal dpr);
+    /** key's avatar as an icon of px logical pixels, at 1x and 2x; null if there is none yet. */
+    QIcon icon(const QString &key, int px);
+
+    /** Fetch url as key's avatar unless already queued or in flight; avatarReady fires when new thumbnails are written. */
+    void request(const QString &key, const QUrl &url);
+
+Q_SIGNALS:
+    void avatarReady(const QString &key);
+
+private:
+    explicit AvatarStore(QObject *parent = nullptr);
+    void startNext(const QString &host);
+    void onFinished(QNetworkReply *reply);
+    /** Decode data and write key's thumbnails in the thread pool, then emit avatarReady. */
+    void makeThumbnails(const QString &key, const QByteArray &data);
+    QString thumbnailFile(const QString &key, int px) const;
+
+    static constexpr int MaxPerHost = 2;
+    static constexpr qint64 MaxImageBytes = 8 * 1024 * 1024;
+
+    QNetworkAccessManager *m_nam = nullptr;
+    QString m_dir;                                // thumbnail directory
+    QSet<QString> m_ready;                        // keys whose thumbnails exist on disk
+    QHash<QString, int> m_generation;             // key -> bumped when its thumbnails change
+    QHash<QString, QUrl> m_pending;               // key -> url queued or in flight
+    QHash<QString, QQueue<QString>> m_hostQueues; // host -> keys waiting for a slot
+    QHash<QString, int> m_hostActive;             // host -> requests in flight
+};
+
+#endif // AVATARSTORE_H
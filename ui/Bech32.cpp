@@ -0,0 +1,96 @@
+/*
+ * Bech32.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Bech32.h"
+
+#include <QVector>
+
+static const char Charset[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+static quint32 polymod(const QVector<quint8> &values) {
+    static const quint32 Generator[5] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa, 0x3d4233dd, 0x2a1462b3};
+    quint32 chk = 1;
+    for (quint8 v : values) {
+        quint32 top = chk >> 25;
+        chk = ((chk & 0x1ffffff) << 5) ^ v;
+        for (int i = 0; i < 5; ++i) {
+            if ((top >> i) & 1) {
+                chk ^= Generator[i];
+            }
+        }
+    }
+    return chk;
+}
+
+QString bech32Encode(const QString &hrp, const QByteArray &data) {
+    QByteArray h = hrp.toLatin1().toLower();
+    // Regroup 8-bit bytes into 5-bit words, zero-padding the last one
+    QVector<quint8> words;
+    words.reserve((data.size() * 8 + 4) / 5);
+    quint32 acc = 0;
+    int bits = 0;
+    for (char c : data) {
+        acc = (acc << 8) | static_cast<quint8>(c);
+        bits += 8;
+        while (bits >= 5) {
+            bits -= 5;
+            words.append((acc >> bits) & 31);
+        }
+    }
+    if (bits > 0) {
+        words.append((acc << (5 - bits)) & 31);
+    }
+
+    // Checksum over the expanded hrp, the data and six zero words
+    QVector<quint8> values;
+    values.reserve(h.size() * 2 + 1 + words.size() + 6);
+    for (char c : h) {
+        values.append(static_cast<quint8>(c) >> 5);
+    }
+    values.append(0);
+    for (char c : h) {
+        values.append(static_cast<quint8>(c) & 31);
+    }
+    values += words;
+    values.append(QVector<quint8>(6, 0));
+    quint32 mod = polymod(values) ^ 1;
+
+    QString out = QString::fromLatin1(h);
+    out.reserve(h.size() + 1 + words.size() + 6);
+    out += QLatin1Char('1');
+    for (quint8 w : words) {
+        out += QLatin1Char(Charset[w]);
+    }
+    for (int i = 0; i < 6; ++i) {
+        out += QLatin1Char(Charset[(mod >> (5 * (5 - i))) & 31]);
+    }
+    return out;
+}
+
+QString hexToNpub(const QString &hex) {
+    if (hex.length() != 64) {
+        return QString();
+    }
+    QByteArray key = QByteArray::fromHex(hex.toLatin1());
+    if (key.size() != 32) {
+        return QString();
+    }
+    return bech32Encode(QStringLiteral("npub"), key);
+}
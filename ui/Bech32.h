@@ -0,0 +1,33 @@
+/*
+ * Bech32.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BECH32_H
+#define BECH32_H
+
+#include <QByteArray>
+#include <QString>
+
+/** Bech32 (BIP-173) encoding of data under the human-readable part hrp, e.g. "npub". */
+QString bech32Encode(const QString &hrp, const QByteArray &data);
+
+/** NIP-19 npub for a 64-character hex public key; empty if hex is not a valid key. */
+QString hexToNpub(const QString &hex);
+
+#endif // BECH32_H
@@ -1,27 +1,33 @@
 #include "Callbacks.h"
 #include "EventBridge.h"
 #include "Config.h"
+#include "SourceViewer.h"
 #include "Tr.h"
 #include "tagliacarte.h"
 
+#include <QCoreApplication>
 #include <QMetaObject>
+#include <QFile>
 #include <QString>
 #include <QDateTime>
 #include <QLocale>
 
+#include <cstdio>
+#include <memory>
+
 void on_folder_found_cb(const char *name, char delimiter, const char *attributes, void *user_data) {
-    EventBridge *b = static_cast<EventBridge*>(user_data);
+    auto *ctx = static_cast<FolderListContext*>(user_data);
     QString n = QString::fromUtf8(name);
     QString delim = delimiter ? QString(QChar(delimiter)) : QString();
     QString attrs = attributes ? QString::fromUtf8(attributes) : QString();
-    QMetaObject::invokeMethod(b, "addFolder", Qt::QueuedConnection,
-        Q_ARG(QString, n), Q_ARG(QString, delim), Q_ARG(QString, attrs));
+    ctx->bridge->queueFolderFound(ctx->storeUri, n, delim, attrs);
 }
 
 void on_folder_removed_cb(const char *name, void *user_data) {
-    EventBridge *b = static_cast<EventBridge*>(user_data);
+    auto *ctx = static_cast<FolderListContext*>(user_data);
     QString n = QString::fromUtf8(name);
-    QMetaObject::invokeMethod(b, "removeFolder", Qt::QueuedConnection, Q_ARG(QString, n));
+    QMetaObject::invokeMethod(ctx->bridge, "onFolderRemoved", Qt::QueuedConnection,
+        Q_ARG(QString, ctx->storeUri), Q_ARG(QString, n));
 }
 
 void on_folder_op_error_cb(const char *message, void *user_data) {
@@ -31,10 +37,17 @@ void on_folder_op_error_cb(const char *message, void *user_data) {
 }
 
 void on_folder_list_complete_cb(int error, const char *error_message, void *user_data) {
-    EventBridge *b = static_cast<EventBridge*>(user_data);
+    auto *ctx = static_cast<FolderListContext*>(user_data);
     QString msg = error_message ? QString::fromUtf8(error_message) : QString();
-    QMetaObject::invokeMethod(b, "onFolderListComplete", Qt::QueuedConnection,
-        Q_ARG(int, error), Q_ARG(QString, msg));
+    QMetaObject::invokeMethod(ctx->bridge, "onFolderListComplete", Qt::QueuedConnection,
+        Q_ARG(QString, ctx->storeUri), Q_ARG(int, error), Q_ARG(QString, msg));
+}
+
+void on_folder_status_cb(const char *store_uri, const char *folder_name, uint64_t total, uint64_t unread, void *user_data) {
+    EventBridge *b = static_cast<EventBridge*>(user_data);
+    QMetaObject::invokeMethod(b, "onFolderStatus", Qt::QueuedConnection,
+        Q_ARG(QString, QString::fromUtf8(store_uri)), Q_ARG(QString, QString::fromUtf8(folder_name)),
+        Q_ARG(quint64, static_cast<quint64>(total)), Q_ARG(quint64, static_cast<quint64>(unread)));
 }
 
 void on_message_summary_cb(const char *id, const char *subject, const char *from_, qint64 date_timestamp_secs, uint64_t size, uint32_t flags, void *user_data) {
@@ -59,6 +72,24 @@ void on_message_summary_cb(const char *id, const char *subject, const char *from
         Q_ARG(quint32, flags));
 }
 
+static void invokeLiveMessage(const char *slot, const char *id, const char *subject, const char *from_, qint64 date_timestamp_secs, void *user_data) {
+    auto *ctx = static_cast<LiveSubscriptionContext *>(user_data);
+    QMetaObject::invokeMethod(ctx->bridge, slot, Qt::QueuedConnection,
+        Q_ARG(QString, ctx->folderUri),
+        Q_ARG(QString, QString::fromUtf8(id)),
+        Q_ARG(QString, subject ? QString::fromUtf8(subject) : QString()),
+        Q_ARG(QString, from_ ? QString::fromUtf8(from_) : QString()),
+        Q_ARG(qint64, date_timestamp_secs));
+}
+
+void on_message_added_cb(const char *id, const char *subject, const char *from_, qint64 date_timestamp_secs, uint64_t, uint32_t, void *user_data) {
+    invokeLiveMessage("onMessageAdded", id, subject, from_, date_timestamp_secs, user_data);
+}
+
+void on_message_updated_cb(const char *id, const char *subject, const char *from_, qint64 date_timestamp_secs, uint64_t, uint32_t, void *user_data) {
+    invokeLiveMessage("onMessageUpdated", id, subject, from_, date_timestamp_secs, user_data);
+}
+
 void on_bulk_complete_cb(int ok, const char *error_message, void *user_data) {
     EventBridge *b = static_cast<EventBridge*>(user_data);
     QString errMsg = (ok != 0 && error_message) ? QString::fromUtf8(error_message) : QString();
@@ -71,6 +102,28 @@ void on_message_list_complete_cb(int error, void *user_data) {
     QMetaObject::invokeMethod(b, "onMessageListComplete", Qt::QueuedConnection, Q_ARG(int, error));
 }
 
+void on_conversation_history_complete_cb(int error, int more, void *user_data) {
+    EventBridge *b = static_cast<EventBridge*>(user_data);
+    QMetaObject::invokeMethod(b, "onConversationHistoryComplete", Qt::QueuedConnection,
+        Q_ARG(int, error), Q_ARG(int, more));
+}
+
+void on_nostr_profile_cb(const char *pubkey_hex, const char *display_name, const char *nip05, const char *picture, void *user_data) {
+    auto *ctx = static_cast<ProfileBatchContext *>(user_data);
+    QMetaObject::invokeMethod(ctx->bridge, "onNostrProfile", Qt::QueuedConnection,
+        Q_ARG(QString, QString::fromUtf8(pubkey_hex)),
+        Q_ARG(QString, display_name ? QString::fromUtf8(display_name) : QString()),
+        Q_ARG(QString, nip05 ? QString::fromUtf8(nip05) : QString()),
+        Q_ARG(QString, picture ? QString::fromUtf8(picture) : QString()));
+}
+
+void on_nostr_profiles_complete_cb(int error, void *user_data) {
+    auto *ctx = static_cast<ProfileBatchContext *>(user_data);
+    QMetaObject::invokeMethod(ctx->bridge, "onNostrProfilesComplete", Qt::QueuedConnection,
+        Q_ARG(QStringList, ctx->pubkeys), Q_ARG(int, error));
+    delete ctx;
+}
+
 void on_message_metadata_cb(const char *subject, const char *from_, const char *to, const char *date, void *user_data) {
     EventBridge *b = static_cast<EventBridge*>(user_data);
     QMetaObject::invokeMethod(b, "showMessageMetadata", Qt::QueuedConnection,
@@ -117,6 +170,16 @@ void on_body_content_cb(const uint8_t *data, size_t len, void *user_data) {
     QMetaObject::invokeMethod(b, "onBodyContent", Qt::QueuedConnection, Q_ARG(QByteArray, ba));
 }
 
+void on_body_buffer_cb(const uint8_t *data, size_t len, void *buffer, void *user_data) {
+    EventBridge *b = static_cast<EventBridge*>(user_data);
+    // The core's buffer is borrowed, not copied: the slot sees a raw view and the buffer is
+    // released when the queued call has run (or been dropped with the bridge).
+    std::shared_ptr<void> owner(buffer, tagliacarte_body_buffer_release);
+    QMetaObject::invokeMethod(b, [b, data, len, owner]() {
+        b->onBodyContent(QByteArray::fromRawData(reinterpret_cast<const char *>(data), static_cast<qsizetype>(len)));
+    }, Qt::QueuedConnection);
+}
+
 void on_end_entity_cb(void *user_data) {
     EventBridge *b = static_cast<EventBridge*>(user_data);
     QMetaObject::invokeMethod(b, "onEndEntity", Qt::QueuedConnection);
@@ -127,6 +190,63 @@ void on_message_complete_cb(int error, void *user_data) {
     QMetaObject::invokeMethod(b, "onMessageComplete", Qt::QueuedConnection, Q_ARG(int, error));
 }
 
+void on_deferred_part_cb(const char *section, uint64_t size, void *user_data) {
+    EventBridge *b = static_cast<EventBridge*>(user_data);
+    QMetaObject::invokeMethod(b, "onDeferredPart", Qt::QueuedConnection,
+        Q_ARG(QString, section ? QString::fromUtf8(section) : QString()),
+        Q_ARG(quint64, size));
+}
+
+void on_part_save_body_cb(const uint8_t *data, size_t len, void *user_data) {
+    auto *ctx = static_cast<PartSaveContext *>(user_data);
+    if (data && len > 0 && !ctx->writeFailed) {
+        if (ctx->file->write(reinterpret_cast<const char *>(data), static_cast<qint64>(len)) != static_cast<qint64>(len)) {
+            fprintf(stderr, "[attachment] write to %s failed: %s\n",
+                ctx->file->fileName().toUtf8().constData(), ctx->file->errorString().toUtf8().constData());
+            ctx->writeFailed = true;
+        }
+    }
+}
+
+void on_part_save_complete_cb(int error, void *user_data) {
+    auto *ctx = static_cast<PartSaveContext *>(user_data);
+    QString path = ctx->file->fileName();
+    // Buffered data is written on close; a failure there is a failed save too
+    if (!ctx->file->flush()) {
+        ctx->writeFailed = true;
+    }
+    ctx->file->close();
+    if (error == 0 && ctx->writeFailed) {
+        error = -1;
+    }
+    QMetaObject::invokeMethod(ctx->bridge, "onPartSaved", Qt::QueuedConnection,
+        Q_ARG(QString, path), Q_ARG(int, error));
+    delete ctx->file;
+    delete ctx;
+}
+
+void on_source_chunk_cb(const uint8_t *data, size_t len, void *user_data) {
+    auto *ctx = static_cast<SourceLoadContext *>(user_data);
+    // The only copy of the source: the viewer adopts this array rather than copying it again
+    QByteArray chunk(reinterpret_cast<const char *>(data), static_cast<qsizetype>(len));
+    // Check the viewer on the GUI thread: it may have been closed in the meantime
+    QMetaObject::invokeMethod(qApp, [ctx, chunk]() {
+        if (ctx->viewer) {
+            ctx->viewer->appendData(chunk);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void on_source_complete_cb(int error, void *user_data) {
+    auto *ctx = static_cast<SourceLoadContext *>(user_data);
+    QMetaObject::invokeMethod(qApp, [ctx, error]() {
+        if (ctx->viewer) {
+            ctx->viewer->setFinished(error == 0);
+        }
+        delete ctx;
+    }, Qt::QueuedConnection);
+}
+
 void on_send_progress_cb(const char *status, void *user_data) {
     EventBridge *b = static_cast<EventBridge*>(user_data);
     QString s = status ? QString::fromUtf8(status) : QString();
@@ -138,6 +258,13 @@ void on_send_complete_cb(int ok, void *user_data) {
     QMetaObject::invokeMethod(b, "onSendComplete", Qt::QueuedConnection, Q_ARG(int, ok));
 }
 
+void on_chat_send_complete_cb(int ok, void *user_data) {
+    auto *ctx = static_cast<ChatSendContext *>(user_data);
+    QMetaObject::invokeMethod(ctx->bridge, "onChatSendComplete", Qt::QueuedConnection,
+        Q_ARG(QString, ctx->conversation), Q_ARG(int, ok));
+    delete ctx;
+}
+
 void on_folder_ready_cb(const char *folder_uri, void *user_data) {
     EventBridge *b = static_cast<EventBridge*>(user_data);
     QString uri = QString::fromUtf8(folder_uri);
@@ -2,9 +2,15 @@
 #define CALLBACKS_H
 
 #include <QtTypes>
+#include <QPointer>
+#include <QStringList>
 #include <cstdint>
 #include <cstddef>
 
+class EventBridge;
+class QFile;
+class SourceViewer;
+
 // C callbacks (run on backend thread); marshal to main thread via EventBridge.
 // These are passed to FFI registration calls.
 
@@ -12,8 +18,14 @@ void on_folder_found_cb(const char *name, char delimiter, const char *attributes
 void on_folder_removed_cb(const char *name, void *user_data);
 void on_folder_op_error_cb(const char *message, void *user_data);
 void on_folder_list_complete_cb(int error, const char *error_message, void *user_data);
+void on_folder_status_cb(const char *store_uri, const char *folder_name, uint64_t total, uint64_t unread, void *user_data);
 void on_message_summary_cb(const char *id, const char *subject, const char *from_, qint64 date_timestamp_secs, uint64_t size, uint32_t flags, void *user_data);
 void on_message_list_complete_cb(int error, void *user_data);
+void on_conversation_history_complete_cb(int error, int more, void *user_data);
+void on_message_added_cb(const char *id, const char *subject, const char *from_, qint64 date_timestamp_secs, uint64_t size, uint32_t flags, void *user_data);
+void on_message_updated_cb(const char *id, const char *subject, const char *from_, qint64 date_timestamp_secs, uint64_t size, uint32_t flags, void *user_data);
+void on_nostr_profile_cb(const char *pubkey_hex, const char *display_name, const char *nip05, const char *picture, void *user_data);
+void on_nostr_profiles_complete_cb(int error, void *user_data);
 void on_bulk_complete_cb(int ok, const char *error_message, void *user_data);
 void on_message_metadata_cb(const char *subject, const char *from_, const char *to, const char *date, void *user_data);
 void on_start_entity_cb(void *user_data);
@@ -22,10 +34,64 @@ void on_content_disposition_cb(const char *value, void *user_data);
 void on_content_id_cb(const char *value, void *user_data);
 void on_end_headers_cb(void *user_data);
 void on_body_content_cb(const uint8_t *data, size_t len, void *user_data);
+void on_body_buffer_cb(const uint8_t *data, size_t len, void *buffer, void *user_data);
 void on_end_entity_cb(void *user_data);
 void on_message_complete_cb(int error, void *user_data);
+void on_deferred_part_cb(const char *section, uint64_t size, void *user_data);
+
+/** user_data for tagliacarte_store_set_folder_list_callbacks. Folders and completions carry
+ *  the store they were listed from, so those of a listing still running when the tree has
+ *  moved to another store are dropped. pending counts the store's listings in flight (main
+ *  thread only): only the last to complete reconciles the tree. Owned by the bridge, one per
+ *  store URI. */
+struct FolderListContext {
+    EventBridge *bridge;
+    QString storeUri;
+    int pending = 0;
+};
+
+/** user_data for tagliacarte_folder_request_message_part when saving a part to disk.
+ *  Chunks are written on the backend thread; on completion the file is closed, the bridge's
+ *  onPartSaved slot is invoked, and the context (and file) is deleted. */
+struct PartSaveContext {
+    EventBridge *bridge;
+    QFile *file;
+    bool writeFailed = false;  // a write came up short (disk full, I/O error): report failure
+};
+void on_part_save_body_cb(const uint8_t *data, size_t len, void *user_data);
+void on_part_save_complete_cb(int error, void *user_data);
+
+/** user_data for tagliacarte_folder_request_message_source. The viewer may be closed while
+ *  the source is still loading; chunks are then dropped. Deleted on completion. */
+struct SourceLoadContext {
+    QPointer<SourceViewer> viewer;
+};
+void on_source_chunk_cb(const uint8_t *data, size_t len, void *user_data);
+void on_source_complete_cb(int error, void *user_data);
+
+/** user_data for tagliacarte_folder_subscribe (on_message_added_cb / on_message_updated_cb).
+ *  Events carry the folder they came from, so ones still queued when the bridge has moved to
+ *  another folder are dropped. Owned by the bridge, one per folder URI. */
+struct LiveSubscriptionContext {
+    EventBridge *bridge;
+    QString folderUri;
+};
 void on_send_progress_cb(const char *status, void *user_data);
 void on_send_complete_cb(int ok, void *user_data);
+
+/** user_data for tagliacarte_nostr_fetch_profiles: the pubkeys asked for, so those without
+ *  a profile can be recorded when the batch completes. Deleted on completion. */
+struct ProfileBatchContext {
+    EventBridge *bridge;
+    QStringList pubkeys;
+};
+
+/** user_data for a chat message send: which conversation's queue to advance. Deleted on completion. */
+struct ChatSendContext {
+    EventBridge *bridge;
+    QString conversation;
+};
+void on_chat_send_complete_cb(int ok, void *user_data);
 void on_folder_ready_cb(const char *folder_uri, void *user_data);
 void on_open_folder_error_cb(const char *message, void *user_data);
 void on_open_folder_select_event_cb(int event_type, uint32_t number_value, const char *string_value, void *user_data);
@@ -0,0 +1,183 @@
+/*
+ * ChatMessageDelegate.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChatMessageDelegate.h"
+#include "ChatTimelineModel.h"
+#include "Tr.h"
+
+#include <QAbstractItemView>
+#include <QPainter>
+#include <QTextLayout>
+#include <QTextOption>
+#include <cmath>
+
+// Row geometry (pixels), matching the earlier HTML conversation layout
+static constexpr int HPad = 16;          // left/right row padding
+static constexpr int VPad = 6;           // top/bottom row padding
+static constexpr int AvatarTop = 4;      // avatar offset below the row padding
+static constexpr int TextLeft = HPad + ChatTimelineModel::AvatarPx + 14;
+static constexpr int TextRight = HPad + 4;
+static constexpr int TextTop = 2;
+static constexpr int TextBottom = 8;
+static constexpr int NameGap = 20;       // between author name and timestamp
+
+static QFont nameFont(const QFont &base) {
+    QFont f(base);
+    f.setBold(true);
+    f.setPixelSize(14);
+    return f;
+}
+
+static QFont timeFont(const QFont &base) {
+    QFont f(base);
+    f.setPixelSize(11);
+    return f;
+}
+
+static QTextOption contentOption() {
+    QTextOption opt;
+    opt.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+    return opt;
+}
+
+/** Height of text wrapped to width, laid out the way paint() draws it. */
+static int contentHeight(const QString &text, const QFont &font, int width) {
+    if (text.isEmpty() || width <= 0) {
+        return 0;
+    }
+    QTextLayout layout(text, font);
+    layout.setTextOption(contentOption());
+    qreal height = 0;
+    layout.beginLayout();
+    for (QTextLine line = layout.createLine(); line.isValid(); line = layout.createLine()) {
+        line.setLineWidth(width);
+        height += line.height();
+    }
+    layout.endLayout();
+    return static_cast<int>(std::ceil(height));
+}
+
+static int viewWidth(const QStyleOptionViewItem &option) {
+    if (auto *view = qobject_cast<const QAbstractItemView *>(option.widget)) {
+        return view->viewport()->width();
+    }
+    return option.rect.width();
+}
+
+ChatMessageDelegate::ChatMessageDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+void ChatMessageDelegate::invalidateHeight(const QString &messageId) {
+    for (auto it = m_heights.begin(); it != m_heights.end(); ++it) {
+        it->remove(messageId);
+    }
+}
+
+void ChatMessageDelegate::clearHeights() {
+    m_heights.clear();
+    m_widths.clear();
+}
+
+QHash<QString, int> &ChatMessageDelegate::heightsAt(int width) const {
+    if (m_widths.isEmpty() || m_widths.last() != width) {
+        m_widths.removeOne(width);
+        m_widths.append(width);
+        if (m_widths.size() > MaxWidths) {
+            m_heights.remove(m_widths.takeFirst());
+        }
+    }
+    return m_heights[width];
+}
+
+QSize ChatMessageDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const {
+    int width = viewWidth(option);
+    QHash<QString, int> &heights = heightsAt(width);
+    QString id = index.data(ChatTimelineModel::MessageIdRole).toString();
+    auto it = heights.constFind(id);
+    if (it != heights.constEnd() && !id.isEmpty()) {
+        return QSize(width, it.value());
+    }
+    int nameHeight = QFontMetrics(nameFont(option.font)).height();
+    int textHeight = contentHeight(index.data(Qt::DisplayRole).toString(), option.font, width - TextLeft - TextRight);
+    int height = 2 * VPad + qMax(AvatarTop + ChatTimelineModel::AvatarPx, TextTop + nameHeight + textHeight + TextBottom);
+    if (!id.isEmpty()) {
+        heights.insert(id, height);
+    }
+    return QSize(width, height);
+}
+
+void ChatMessageDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const {
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+    const QRect r = option.rect;
+    bool isDark = option.palette.color(QPalette::Window).lightness() < 128;
+    QColor nameColor = isDark ? QColor(0xdd, 0xdd, 0xdd) : QColor(0x1d, 0x1c, 0x1d);
+    QColor mutedColor = isDark ? QColor(0x88, 0x88, 0x88) : QColor(0x99, 0x99, 0x99);
+
+    // Avatar: AvatarStore pixmaps match the device pixel ratio; placeholders are drawn at 2x
+    QPixmap avatar = index.data(ChatTimelineModel::AvatarRole).value<QPixmap>();
+    if (!avatar.isNull()) {
+        painter->drawPixmap(QRect(r.left() + HPad, r.top() + VPad + AvatarTop,
+            ChatTimelineModel::AvatarPx, ChatTimelineModel::AvatarPx), avatar);
+    }
+
+    int x = r.left() + TextLeft;
+    int y = r.top() + VPad + TextTop;
+    int textWidth = r.width() - TextLeft - TextRight;
+
+    // Author name and timestamp on one line
+    QFont nf = nameFont(option.font);
+    QFontMetrics nfm(nf);
+    QString name = nfm.elidedText(index.data(ChatTimelineModel::AuthorNameRole).toString(),
+        Qt::ElideRight, qMax(0, textWidth * 2 / 3));
+    painter->setFont(nf);
+    painter->setPen(nameColor);
+    painter->drawText(x, y + nfm.ascent(), name);
+
+    // Local echoes show their send state in place of the timestamp
+    int delivery = index.data(ChatTimelineModel::DeliveryRole).toInt();
+    QString timeStr = index.data(ChatTimelineModel::TimestampTextRole).toString();
+    QColor timeColor = mutedColor;
+    if (delivery == ChatMessage::Sending) {
+        timeStr = TR("status.sending");
+    } else if (delivery == ChatMessage::Failed) {
+        timeStr = TR("chat.send_failed");
+        timeColor = isDark ? QColor(0xff, 0x6b, 0x6b) : QColor(0xd0, 0x30, 0x30);
+    }
+    if (!timeStr.isEmpty()) {
+        painter->setFont(timeFont(option.font));
+        painter->setPen(timeColor);
+        painter->drawText(x + nfm.horizontalAdvance(name) + NameGap, y + nfm.ascent(), timeStr);
+    }
+
+    // Message text, wrapped
+    QString content = index.data(Qt::DisplayRole).toString();
+    if (!content.isEmpty()) {
+        int top = y + nfm.height();
+        painter->setFont(option.font);
+        painter->setPen(delivery == ChatMessage::Sending ? mutedColor : option.palette.color(QPalette::Text));
+        painter->drawText(QRectF(x, top, textWidth, r.bottom() - top), content, contentOption());
+    }
+    painter->restore();
+}
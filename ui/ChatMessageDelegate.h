@@ -0,0 +1,53 @@
+/*
+ * ChatMessageDelegate.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHATMESSAGEDELEGATE_H
+#define CHATMESSAGEDELEGATE_H
+
+#include <QHash>
+#include <QStyledItemDelegate>
+#include <QVector>
+
+/**
+ * Paints one ChatTimelineModel row: avatar, author name, timestamp and wrapped text.
+ * Row heights are cached by message id for each of the last few widths, so resizing
+ * back to an earlier width (or toggling a side pane) measures nothing again.
+ */
+class ChatMessageDelegate : public QStyledItemDelegate {
+public:
+    explicit ChatMessageDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    /** Forget the measured height of one message (its content changed). */
+    void invalidateHeight(const QString &messageId);
+    void clearHeights();
+
+private:
+    static constexpr int MaxWidths = 4;
+
+    QHash<QString, int> &heightsAt(int width) const;
+
+    mutable QHash<int, QHash<QString, int>> m_heights;  // width -> message id -> row height
+    mutable QVector<int> m_widths;                      // keys of m_heights, most recently used last
+};
+
+#endif // CHATMESSAGEDELEGATE_H
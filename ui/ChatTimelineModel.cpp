@@ -0,0 +1,256 @@
+/*
+ * ChatTimelineModel.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChatTimelineModel.h"
+#include "IconUtils.h"
+
+#include <QApplication>
+#include <QColor>
+#include <QDateTime>
+#include <QLocale>
+#include <QPalette>
+
+ChatTimelineModel::ChatTimelineModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+int ChatTimelineModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_messages.size());
+}
+
+QVariant ChatTimelineModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_messages.size()) {
+        return QVariant();
+    }
+    const ChatMessage &msg = m_messages.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return msg.content;
+    case MessageIdRole:
+        return msg.id;
+    case AuthorIdRole:
+        return msg.authorId;
+    case AuthorNameRole:
+        return m_authors.value(msg.authorId).name;
+    case AvatarRole:
+        return m_authors.value(msg.authorId).avatar;
+    case TimestampRole:
+        return msg.timestampSecs;
+    case TimestampTextRole:
+        return formatChatTimestamp(msg.timestampSecs);
+    case DeliveryRole:
+        return static_cast<int>(msg.delivery);
+    default:
+        return QVariant();
+    }
+}
+
+void ChatTimelineModel::appendMessages(const QVector<ChatMessage> &messages) {
+    if (messages.isEmpty()) {
+        return;
+    }
+    int first = static_cast<int>(m_messages.size());
+    qint64 position = m_firstPosition + first;
+    indexMessages(messages, position);
+    for (const ChatMessage &msg : messages) {
+        author(msg.authorId).positions.append(position++);
+    }
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(messages.size()) - 1);
+    m_messages += messages;
+    endInsertRows();
+}
+
+void ChatTimelineModel::prependMessages(const QVector<ChatMessage> &messages) {
+    if (messages.isEmpty()) {
+        return;
+    }
+    m_firstPosition -= messages.size();
+    indexMessages(messages, m_firstPosition);
+    QHash<QString, QVector<qint64>> older;
+    qint64 position = m_firstPosition;
+    for (const ChatMessage &msg : messages) {
+        older[msg.authorId].append(position++);
+    }
+    for (auto it = older.cbegin(); it != older.cend(); ++it) {
+        Author &a = author(it.key());
+        a.positions = it.value() + a.positions;
+    }
+    beginInsertRows(QModelIndex(), 0, static_cast<int>(messages.size()) - 1);
+    m_messages = messages + m_messages;
+    endInsertRows();
+}
+
+void ChatTimelineModel::indexMessages(const QVector<ChatMessage> &messages, qint64 firstPosition) {
+    qint64 position = firstPosition;
+    for (const ChatMessage &msg : messages) {
+        if (!msg.id.isEmpty()) {
+            m_positionsById.insert(msg.id, position);
+        }
+        if (msg.delivery != ChatMessage::Delivered) {
+            m_echoPositions.append(position);
+        }
+        ++position;
+    }
+}
+
+int ChatTimelineModel::rowOf(const QString &id) const {
+    auto it = m_positionsById.constFind(id);
+    return it == m_positionsById.constEnd() ? -1 : static_cast<int>(it.value() - m_firstPosition);
+}
+
+bool ChatTimelineModel::updateMessage(const ChatMessage &msg) {
+    int row = rowOf(msg.id);
+    if (row < 0) {
+        return false;
+    }
+    m_messages[row].content = msg.content;
+    QModelIndex idx = index(row);
+    emit dataChanged(idx, idx);
+    return true;
+}
+
+bool ChatTimelineModel::setDelivery(const QString &localId, ChatMessage::Delivery delivery) {
+    int row = rowOf(localId);
+    if (row < 0) {
+        return false;
+    }
+    m_messages[row].delivery = delivery;
+    QModelIndex idx = index(row);
+    emit dataChanged(idx, idx, {DeliveryRole});
+    return true;
+}
+
+bool ChatTimelineModel::confirmLocalMessage(const ChatMessage &msg) {
+    // Only unconfirmed echoes are candidates; there are rarely more than a few
+    for (qsizetype i = 0; i < m_echoPositions.size(); ++i) {
+        int row = static_cast<int>(m_echoPositions.at(i) - m_firstPosition);
+        ChatMessage &echo = m_messages[row];
+        if (echo.delivery == ChatMessage::Failed || echo.content != msg.content
+            || (!echo.authorId.isEmpty() && echo.authorId != msg.authorId)) {
+            continue;
+        }
+        m_echoPositions.remove(i);
+        m_positionsById.insert(msg.id, m_positionsById.take(echo.id));
+        echo.id = msg.id;
+        echo.timestampSecs = msg.timestampSecs;
+        echo.delivery = ChatMessage::Delivered;
+        QModelIndex idx = index(row);
+        emit dataChanged(idx, idx);
+        return true;
+    }
+    return false;
+}
+
+void ChatTimelineModel::clear() {
+    beginResetModel();
+    m_messages.clear();
+    m_authors.clear();
+    m_firstPosition = 0;
+    m_positionsById.clear();
+    m_echoPositions.clear();
+    endResetModel();
+}
+
+bool ChatTimelineModel::hasAuthor(const QString &authorId) const {
+    return m_authors.contains(authorId);
+}
+
+QStringList ChatTimelineModel::authorIds() const {
+    return m_authors.keys();
+}
+
+ChatTimelineModel::Author &ChatTimelineModel::author(const QString &authorId) {
+    auto it = m_authors.find(authorId);
+    if (it == m_authors.end()) {
+        it = m_authors.insert(authorId, Author());
+        it->name = authorId.left(12) + QStringLiteral("…");
+        it->avatar = placeholderAvatar(authorId, it->name);
+    }
+    return *it;
+}
+
+void ChatTimelineModel::setAuthorName(const QString &authorId, const QString &name) {
+    Author &a = author(authorId);
+    if (a.name == name) {
+        return;
+    }
+    a.name = name;
+    QVector<int> roles { AuthorNameRole };
+    if (!a.hasPicture) {
+        a.avatar = placeholderAvatar(authorId, name);
+        roles.append(AvatarRole);
+    }
+    authorChanged(a, roles);
+}
+
+void ChatTimelineModel::setAuthorAvatar(const QString &authorId, const QPixmap &picture) {
+    Author &a = author(authorId);
+    a.hasPicture = !picture.isNull();
+    a.avatar = a.hasPicture ? picture : placeholderAvatar(authorId, a.name);
+    authorChanged(a, { AvatarRole });
+}
+
+void ChatTimelineModel::authorChanged(const Author &a, const QVector<int> &roles) {
+    // One change per run of consecutive rows by the author. Row heights do not depend on
+    // the author, so nothing is re-measured.
+    const QVector<qint64> &positions = a.positions;
+    for (qsizetype i = 0; i < positions.size();) {
+        qsizetype j = i + 1;
+        while (j < positions.size() && positions.at(j) == positions.at(j - 1) + 1) {
+            ++j;
+        }
+        emit dataChanged(index(static_cast<int>(positions.at(i) - m_firstPosition)),
+            index(static_cast<int>(positions.at(j - 1) - m_firstPosition)), roles);
+        i = j;
+    }
+}
+
+QPixmap ChatTimelineModel::placeholderAvatar(const QString &authorId, const QString &name) const {
+    uint hash = 0;
+    for (QChar c : authorId) {
+        hash = hash * 31 + c.unicode();
+    }
+    int hue = static_cast<int>(hash % 360);
+    bool isDark = QApplication::palette().color(QPalette::Window).lightness() < 128;
+    int sat = isDark ? 50 : 60;
+    int light = isDark ? 40 : 65;
+    QColor circleColor = QColor::fromHsl(hue, sat * 255 / 100, light * 255 / 100);
+    QChar initial = name.isEmpty() ? QLatin1Char('?') : name.at(0).toUpper();
+    return letterAvatar(initial, circleColor, AvatarPx * 2);
+}
+
+QString ChatTimelineModel::formatChatTimestamp(qint64 secs) {
+    if (secs <= 0) return QString();
+    QLocale locale;
+    QDateTime dt = QDateTime::fromSecsSinceEpoch(secs);
+    QDateTime now = QDateTime::currentDateTime();
+    QDate today = now.date();
+    if (dt.date() == today) {
+        return locale.toString(dt.time(), QLocale::ShortFormat);
+    }
+    int daysDiff = dt.date().daysTo(today);
+    if (daysDiff > 0 && daysDiff < 7) {
+        return locale.dayName(dt.date().dayOfWeek(), QLocale::ShortFormat)
+            + QStringLiteral(" ")
+            + locale.toString(dt.time(), QLocale::ShortFormat);
+    }
+    return locale.toString(dt, QLocale::ShortFormat);
+}
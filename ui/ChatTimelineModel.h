@@ -0,0 +1,122 @@
+/*
+ * ChatTimelineModel.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHATTIMELINEMODEL_H
+#define CHATTIMELINEMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QPixmap>
+#include <QString>
+#include <QVector>
+
+struct ChatMessage {
+    /** Outgoing messages are shown before the store has them (local echo). */
+    enum Delivery {
+        Delivered,       // from the store
+        Sending,         // local echo, send in progress
+        Sent,            // local echo, transport accepted it; the store's copy replaces it
+        Failed,          // local echo, send failed
+    };
+
+    QString id;          // message id from the store, or LocalIdPrefix + serial for a local echo
+    QString content;
+    QString authorId;    // hex pubkey (Nostr) or user ID (Matrix), lower case
+    qint64 timestampSecs;
+    Delivery delivery = Delivered;
+};
+
+/**
+ * Messages of one conversation, oldest first, for ChatTimelineView.
+ *
+ * Author display names and avatars are held per author, not per message, together with
+ * the positions of the author's messages: resolving a profile updates one entry and
+ * repaints only that author's rows.
+ */
+class ChatTimelineModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    enum Roles {
+        MessageIdRole = Qt::UserRole + 1,
+        AuthorIdRole,
+        AuthorNameRole,
+        AvatarRole,          // QPixmap: circular avatar or letter placeholder, AvatarPx logical pixels
+        TimestampRole,       // qint64 seconds
+        TimestampTextRole,   // formatted for display
+        DeliveryRole,        // int: ChatMessage::Delivery
+    };
+
+    static inline const QString LocalIdPrefix = QStringLiteral("local:");
+
+    static constexpr int AvatarPx = 40;
+
+    explicit ChatTimelineModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    void appendMessages(const QVector<ChatMessage> &messages);
+    /** Insert older messages (oldest first) above the existing rows. */
+    void prependMessages(const QVector<ChatMessage> &messages);
+    /** Replace the content of the message with msg.id; false if it is not in the model. */
+    bool updateMessage(const ChatMessage &msg);
+    /** Set the delivery state of a local echo; false if it is not in the model. */
+    bool setDelivery(const QString &localId, ChatMessage::Delivery delivery);
+    /** Replace the oldest local echo with the same content by the store's copy of it;
+     *  false if there is none. */
+    bool confirmLocalMessage(const ChatMessage &msg);
+    void clear();
+
+    bool hasAuthor(const QString &authorId) const;
+    /** Authors with at least one message in the model. */
+    QStringList authorIds() const;
+    void setAuthorName(const QString &authorId, const QString &name);
+    /** Set the author's picture, already circular and AvatarPx logical pixels (AvatarStore::pixmap);
+     *  a null pixmap reverts to the letter placeholder. */
+    void setAuthorAvatar(const QString &authorId, const QPixmap &picture);
+
+    /** Format a timestamp for the conversation view (smart: today/this week/older). */
+    static QString formatChatTimestamp(qint64 secs);
+
+private:
+    struct Author {
+        QString name;
+        QPixmap avatar;
+        bool hasPicture = false;
+        QVector<qint64> positions;   // of the author's messages, ascending (see m_firstPosition)
+    };
+
+    Author &author(const QString &authorId);
+    QPixmap placeholderAvatar(const QString &authorId, const QString &name) const;
+    void authorChanged(const Author &a, const QVector<int> &roles);
+    /** Row of the message with this id, or -1. */
+    int rowOf(const QString &id) const;
+    void indexMessages(const QVector<ChatMessage> &messages, qint64 firstPosition);
+
+    QVector<ChatMessage> m_messages;
+    QHash<QString, Author> m_authors;
+    // Position of row 0. Rows keep their position when older messages are prepended
+    // (positions below it are handed out), so per-author positions stay valid.
+    qint64 m_firstPosition = 0;
+    QHash<QString, qint64> m_positionsById;   // message id -> position
+    QVector<qint64> m_echoPositions;          // local echoes not yet confirmed, oldest first
+};
+
+#endif // CHATTIMELINEMODEL_H
@@ -0,0 +1,107 @@
+/*
+ * ChatTimelineView.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChatTimelineView.h"
+#include "ChatMessageDelegate.h"
+#include "ChatTimelineModel.h"
+
+#include <QScrollBar>
+
+ChatTimelineView::ChatTimelineView(QWidget *parent)
+    : QListView(parent)
+    , m_delegate(new ChatMessageDelegate(this))
+{
+    setItemDelegate(m_delegate);
+    setSelectionMode(QAbstractItemView::NoSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setFrameShape(QFrame::NoFrame);
+    setUniformItemSizes(false);
+    setResizeMode(QListView::Adjust);
+    // Lay rows out in batches from the event loop, so a long history never blocks the UI
+    setLayoutMode(QListView::Batched);
+    setBatchSize(500);
+
+    connect(verticalScrollBar(), &QScrollBar::rangeChanged, this, [this](int, int max) {
+        if (m_stickToBottom) {
+            setScrollValue(max);
+        } else if (m_keepAnchor) {
+            // Rows above grew: scroll by the same amount so the visible rows do not move
+            setScrollValue(max - m_anchorFromBottom);
+        }
+        checkReachedTop();
+    });
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value) {
+        if (m_adjusting) {
+            return;
+        }
+        m_keepAnchor = false;
+        m_stickToBottom = value >= verticalScrollBar()->maximum() - 4;
+        checkReachedTop();
+    });
+}
+
+void ChatTimelineView::setScrollValue(int value) {
+    m_adjusting = true;
+    verticalScrollBar()->setValue(value);
+    m_adjusting = false;
+}
+
+void ChatTimelineView::checkReachedTop() {
+    if (model() && model()->rowCount() > 0 && verticalScrollBar()->value() <= viewport()->height() / 2) {
+        emit reachedTop();
+    }
+}
+
+void ChatTimelineView::setModel(QAbstractItemModel *model) {
+    if (this->model()) {
+        disconnect(this->model(), nullptr, this, nullptr);
+    }
+    QListView::setModel(model);
+    m_delegate->clearHeights();
+    m_stickToBottom = true;
+    if (model) {
+        connect(model, &QAbstractItemModel::modelReset, this, [this]() {
+            m_delegate->clearHeights();
+            m_stickToBottom = true;
+            m_keepAnchor = false;
+        });
+        connect(model, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles) {
+            // Content changed: measure the row again. Author and delivery changes keep the height
+            if (!roles.isEmpty() && !roles.contains(Qt::DisplayRole)) {
+                return;
+            }
+            for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+                const QModelIndex index = this->model()->index(row, 0);
+                m_delegate->invalidateHeight(index.data(ChatTimelineModel::MessageIdRole).toString());
+                // dataChanged alone does not lay out rows again: the row would keep its old height
+                emit m_delegate->sizeHintChanged(index);
+            }
+        });
+        connect(model, &QAbstractItemModel::rowsAboutToBeInserted, this, [this](const QModelIndex &, int first) {
+            if (first == 0 && this->model()->rowCount() > 0 && !m_stickToBottom) {
+                m_keepAnchor = true;
+                m_anchorFromBottom = verticalScrollBar()->maximum() - verticalScrollBar()->value();
+            }
+        });
+    }
+}
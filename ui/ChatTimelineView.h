@@ -0,0 +1,55 @@
+/*
+ * ChatTimelineView.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHATTIMELINEVIEW_H
+#define CHATTIMELINEVIEW_H
+
+#include <QListView>
+
+class ChatMessageDelegate;
+
+/**
+ * Conversation timeline for chat stores (Nostr, Matrix): one row per message, painted by
+ * ChatMessageDelegate. Row heights are measured once per width and cached, and only
+ * visible rows are painted. Follows new messages while scrolled to the bottom.
+ */
+class ChatTimelineView : public QListView {
+    Q_OBJECT
+public:
+    explicit ChatTimelineView(QWidget *parent = nullptr);
+
+    void setModel(QAbstractItemModel *model) override;
+
+Q_SIGNALS:
+    /** Scrolled to (or near) the oldest loaded message: time to backfill older ones. */
+    void reachedTop();
+
+private:
+    void setScrollValue(int value);
+    void checkReachedTop();
+
+    ChatMessageDelegate *m_delegate = nullptr;
+    bool m_stickToBottom = true;  // keep the newest message in view as rows arrive
+    bool m_keepAnchor = false;    // rows were prepended: keep the same content in view
+    int m_anchorFromBottom = 0;   // scroll distance from the bottom when rows were prepended
+    bool m_adjusting = false;     // scroll value is being set by the view, not the user
+};
+
+#endif // CHATTIMELINEVIEW_H
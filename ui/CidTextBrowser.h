@@ -1,8 +1,13 @@
 #ifndef CIDTEXTBROWSER_H
 #define CIDTEXTBROWSER_H
 
+#include "RemoteResourceLoader.h"
+
 #include <QTextBrowser>
+#include <QTextDocument>
+#include <QTimer>
 #include <QMap>
+#include <QSet>
 #include <QImage>
 #include <QUrl>
 #include <QDebug>
@@ -10,7 +15,24 @@
 // QTextBrowser subclass with cid: resource resolution and configurable resource loading policy.
 class CidTextBrowser : public QTextBrowser {
 public:
-    explicit CidTextBrowser(QWidget *parent = nullptr) : QTextBrowser(parent) {}
+    explicit CidTextBrowser(QWidget *parent = nullptr) : QTextBrowser(parent) {
+        // Remote images arrive asynchronously; batch relayouts so a burst of images repaints once
+        m_relayoutTimer.setSingleShot(true);
+        m_relayoutTimer.setInterval(50);
+        QObject::connect(&m_relayoutTimer, &QTimer::timeout, this, [this]() {
+            document()->markContentsDirty(0, document()->characterCount());
+        });
+        QObject::connect(RemoteResourceLoader::instance(), &RemoteResourceLoader::imageReady, this,
+                         [this](const QUrl &url, const QImage &image) {
+            if (!m_remotePending.remove(url) || image.isNull()) {
+                return;
+            }
+            document()->addResource(QTextDocument::ImageResource, url, image);
+            if (!m_relayoutTimer.isActive()) {
+                m_relayoutTimer.start();
+            }
+        });
+    }
 
     // 0 = no resource loading, 1 = cid: only (default), 2 = external URLs allowed
     int resourceLoadPolicy() const { return m_resourceLoadPolicy; }
@@ -61,7 +83,18 @@ protected:
         if (m_resourceLoadPolicy == 2) {
             QString scheme = url.scheme();
             if (scheme == QLatin1String("http") || scheme == QLatin1String("https")) {
-                return QTextBrowser::loadResource(type, url);
+                if (type != QTextDocument::ImageResource) {
+                    return QVariant();
+                }
+                // Never block the UI thread: show a placeholder and swap the image in when it arrives
+                RemoteResourceLoader *loader = RemoteResourceLoader::instance();
+                QImage img = loader->cachedImage(url);
+                if (!img.isNull()) {
+                    return img;
+                }
+                m_remotePending.insert(url);
+                loader->request(url);
+                return transparentPixel();
             }
         }
         qDebug() << "[resource] blocked:" << url.toString();
@@ -71,6 +104,8 @@ protected:
 private:
     int m_resourceLoadPolicy = 1;
     const QMap<QString, QByteArray> *m_cidRegistry = nullptr;
+    QSet<QUrl> m_remotePending;   // remote images requested by this view, not yet arrived
+    QTimer m_relayoutTimer;
 
     static QVariant transparentPixel() {
         QImage img(1, 1, QImage::Format_ARGB32);
@@ -196,6 +196,8 @@ Config loadConfig() {
                             ? Qt::DescendingOrder : Qt::AscendingOrder;
                     } else if (r.isStartElement() && r.name() == QLatin1String("resource-load-policy")) {
                         c.resourceLoadPolicy = r.attributes().value(QLatin1String("value")).toInt();
+                    } else if (r.isStartElement() && r.name() == QLatin1String("warm-up-stores")) {
+                        c.warmUpStores = (r.attributes().value(QLatin1String("value")).toString() == QLatin1String("1"));
                     }
                 }
             } else if (r.name() == QLatin1String("nostr")) {
@@ -209,6 +211,11 @@ Config loadConfig() {
                         if (!url.isEmpty()) {
                             c.nostrBootstrapRelays.append(url);
                         }
+                    } else if (r.isStartElement() && r.name() == QLatin1String("profile-cache-ttl")) {
+                        int hours = r.attributes().value(QLatin1String("hours")).toInt();
+                        if (hours > 0) {
+                            c.profileCacheTtlHours = hours;
+                        }
                     }
                 }
             } else if (r.name() == QLatin1String("composing")) {
@@ -287,6 +294,9 @@ void saveConfig(const Config &c) {
     w.writeStartElement(QStringLiteral("resource-load-policy"));
     w.writeAttribute(QStringLiteral("value"), QString::number(c.resourceLoadPolicy));
     w.writeEndElement();
+    w.writeStartElement(QStringLiteral("warm-up-stores"));
+    w.writeAttribute(QStringLiteral("value"), c.warmUpStores ? QStringLiteral("1") : QStringLiteral("0"));
+    w.writeEndElement();
     w.writeEndElement();
     w.writeStartElement(QStringLiteral("composing"));
     w.writeStartElement(QStringLiteral("forward-mode"));
@@ -302,13 +312,18 @@ void saveConfig(const Config &c) {
     w.writeAttribute(QStringLiteral("value"), c.replyPosition.isEmpty() ? QStringLiteral("after") : c.replyPosition);
     w.writeEndElement();
     w.writeEndElement();
-    if (!c.nostrBootstrapRelays.isEmpty()) {
+    if (!c.nostrBootstrapRelays.isEmpty() || c.profileCacheTtlHours != 24) {
         w.writeStartElement(QStringLiteral("nostr"));
         for (const QString &url : c.nostrBootstrapRelays) {
             w.writeStartElement(QStringLiteral("bootstrap-relay"));
             w.writeAttribute(QStringLiteral("url"), url);
             w.writeEndElement();
         }
+        if (c.profileCacheTtlHours != 24) {
+            w.writeStartElement(QStringLiteral("profile-cache-ttl"));
+            w.writeAttribute(QStringLiteral("hours"), QString::number(c.profileCacheTtlHours));
+            w.writeEndElement();
+        }
         w.writeEndElement();
     }
     w.writeStartElement(QStringLiteral("stores"));
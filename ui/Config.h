@@ -22,6 +22,7 @@ struct Config {
     bool useKeychain = false;  // true = system keychain, false = encrypted file
     QString dateFormat;        // empty = locale default; otherwise Qt date format string for message list
     int resourceLoadPolicy = 1; // 0 = no resource loading, 1 = cid: only (default), 2 = external URLs
+    bool warmUpStores = true;  // connect every store in the background after startup
     // Message list
     QString messageListColumnOrder;   // e.g. "0,1,2" (from, subject, date)
     QString messageListColumnWidths;  // e.g. "120,0,80" (0 = stretch)
@@ -29,6 +30,7 @@ struct Config {
     Qt::SortOrder messageListSortOrder = Qt::AscendingOrder;  // ascending = oldest first, newest at bottom
     // Nostr
     QStringList nostrBootstrapRelays;  // empty = use hardcoded defaults; if set, overrides DEFAULT_RELAYS
+    int profileCacheTtlHours = 24;     // cached contact profiles are refreshed after this long
     // Composing
     QString forwardMode;       // "inline", "embedded", "attachment"
     bool quoteUsePrefix = true;
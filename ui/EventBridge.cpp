@@ -1,6 +1,10 @@
 #include "EventBridge.h"
+#include "AvatarStore.h"
+#include "Bech32.h"
+#include "Callbacks.h"
 #include "IconUtils.h"
 #include "MessageDragTreeWidget.h"
+#include "NewsgroupBrowser.h"
 #include "Tr.h"
 #include "tagliacarte.h"
 #include <QTreeWidgetItem>
@@ -12,6 +16,7 @@
 #include <QFileDialog>
 #include <QTextCursor>
 #include <QTextDocument>
+#include <QTimer>
 #include <QUrl>
 #include <QRegularExpression>
 #include <QDateTime>
@@ -20,15 +25,8 @@
 #include <QApplication>
 #include <QPainter>
 #include <QPixmap>
-#include <QDir>
 #include <QFile>
-#include <QStandardPaths>
-#include <QNetworkAccessManager>
-#include <QNetworkRequest>
-#include <QNetworkReply>
-#include <QEventLoop>
-#include <QBuffer>
-#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
 
 void showError(QWidget *parent, const char *contextKey) {
     const char *msg = tagliacarte_last_error();
@@ -94,28 +92,50 @@ bool EventBridge::isSystemFolder(const QString &realName, const QString &attribu
 
 // --- Helper functions ---
 
-QTreeWidgetItem *EventBridge::findFolderItem(const QString &realName) const {
-    if (!folderTree) {
-        return nullptr;
+void EventBridge::setFolderTree(QTreeWidget *tree) {
+    folderTree = tree;
+    m_folderItems.clear();
+    if (!tree) {
+        return;
     }
-    QTreeWidgetItemIterator it(folderTree);
-    while (*it) {
-        if ((*it)->data(0, FolderNameRole).toString() == realName) {
-            return *it;
+    // Rows arrive through insertFolder and the newsgroup browser, and leave through clear(),
+    // removeFolder and the folder context menu alike
+    QAbstractItemModel *model = tree->model();
+    connect(model, &QAbstractItemModel::modelAboutToBeReset, this, [this]() {
+        m_folderItems.clear();
+    });
+    connect(model, &QAbstractItemModel::rowsInserted, this, &EventBridge::indexFolderRows);
+    connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &EventBridge::forgetFolderRows);
+}
+
+void EventBridge::indexFolderRows(const QModelIndex &parent, int first, int last) {
+    QAbstractItemModel *model = folderTree->model();
+    for (int row = first; row <= last; ++row) {
+        QModelIndex idx = model->index(row, 0, parent);
+        QString name = idx.data(FolderNameRole).toString();
+        if (!name.isEmpty()) {
+            m_folderItems.insert(name, folderTree->itemFromIndex(idx));
+        }
+        int children = model->rowCount(idx);
+        if (children > 0) {
+            indexFolderRows(idx, 0, children - 1);
         }
-        ++it;
     }
-    return nullptr;
 }
 
-int EventBridge::countAllItems(QTreeWidget *tree) {
-    int count = 0;
-    QTreeWidgetItemIterator it(tree);
-    while (*it) {
-        ++count;
-        ++it;
+void EventBridge::forgetFolderRows(const QModelIndex &parent, int first, int last) {
+    QAbstractItemModel *model = folderTree->model();
+    for (int row = first; row <= last; ++row) {
+        QModelIndex idx = model->index(row, 0, parent);
+        QString name = idx.data(FolderNameRole).toString();
+        if (!name.isEmpty()) {
+            m_folderItems.remove(name);
+        }
+        int children = model->rowCount(idx);
+        if (children > 0) {
+            forgetFolderRows(idx, 0, children - 1);
+        }
     }
-    return count;
 }
 
 bool EventBridge::isConversationMode() const {
@@ -137,106 +157,86 @@ void EventBridge::fetchNostrProfile(const QString &hexPubkey) {
     if (m_nostrRelaysCsv.isEmpty()) return;
     QString lower = hexPubkey.toLower();
     if (m_profileFetchPending.contains(lower)) return;
-    if (m_nostrNameCache.contains(lower)) return;
+    if (m_profileCache.isFresh(lower, m_profileCacheTtlSecs)) return;
     m_profileFetchPending.insert(lower);
-    QString relays = m_nostrRelaysCsv;
-    QString secretKey = m_nostrSecretKey;
-    QString pk = lower;
-    (void)QtConcurrent::run([this, pk, relays, secretKey]() {
-        QByteArray pkBa = pk.toUtf8();
-        QByteArray relaysBa = relays.toUtf8();
-        QByteArray skBa = secretKey.toUtf8();
-        const char *skPtr = skBa.isEmpty() ? nullptr : skBa.constData();
-        auto *profile = tagliacarte_nostr_fetch_profile(pkBa.constData(), relaysBa.constData(), skPtr);
-        if (!profile) {
-            fprintf(stderr, "[avatar] profile fetch failed for %s\n", pkBa.constData());
-            return;
-        }
-        QString displayName;
-        if (profile->display_name)
-            displayName = QString::fromUtf8(profile->display_name);
-        QString nip05;
-        if (profile->nip05)
-            nip05 = QString::fromUtf8(profile->nip05);
-        QString pictureUrl;
-        if (profile->picture)
-            pictureUrl = QString::fromUtf8(profile->picture);
-        tagliacarte_nostr_profile_free(profile);
-
-        fprintf(stderr, "[avatar] %s: name=%s picture=%s\n",
-            pkBa.constData(),
-            displayName.toUtf8().constData(),
-            pictureUrl.isEmpty() ? "(none)" : pictureUrl.toUtf8().constData());
-
-        QString best;
-        if (!displayName.isEmpty())
-            best = displayName;
-        else if (!nip05.isEmpty())
-            best = nip05;
-        if (!best.isEmpty()) {
-            QMetaObject::invokeMethod(this, "updateFolderDisplayName",
-                Qt::QueuedConnection, Q_ARG(QString, pk), Q_ARG(QString, best));
-        }
-
-        // Download and cache the profile picture
-        if (!pictureUrl.isEmpty()) {
-            QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
-                + QStringLiteral("/avatars");
-            QDir().mkpath(cacheDir);
-            QString filePath = cacheDir + QStringLiteral("/") + pk + QStringLiteral(".img");
-
-            // Validate existing cached file; remove if corrupt
-            if (QFile::exists(filePath)) {
-                QImage cached(filePath);
-                if (cached.isNull()) {
-                    fprintf(stderr, "[avatar] cached file corrupt, removing: %s\n", filePath.toUtf8().constData());
-                    QFile::remove(filePath);
-                }
-            }
+    m_profileFetchQueue.append(lower);
+    // Requests made while the folder list or a conversation page is arriving share one batch
+    if (m_profileFetchScheduled) return;
+    m_profileFetchScheduled = true;
+    QTimer::singleShot(16, this, [this]() {
+        m_profileFetchScheduled = false;
+        flushProfileFetches();
+    });
+}
 
-            if (!QFile::exists(filePath)) {
-                QNetworkAccessManager nam;
-                QUrl avatarUrl(pictureUrl);
-                QNetworkRequest req{avatarUrl};
-                req.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
-                                 QNetworkRequest::NoLessSafeRedirectPolicy);
-                req.setHeader(QNetworkRequest::UserAgentHeader,
-                              QStringLiteral("Tagliacarte/1.0"));
-                QNetworkReply *reply = nam.get(req);
-                QEventLoop loop;
-                QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-                loop.exec();
-                if (reply->error() == QNetworkReply::NoError) {
-                    QByteArray body = reply->readAll();
-                    fprintf(stderr, "[avatar] downloaded %lld bytes for %s\n",
-                        (long long)body.size(), pkBa.constData());
-                    QImage testImg;
-                    if (!body.isEmpty() && testImg.loadFromData(body)) {
-                        QFile f(filePath);
-                        if (f.open(QIODevice::WriteOnly)) {
-                            f.write(body);
-                            f.close();
-                        }
-                    } else {
-                        QString ct = reply->header(QNetworkRequest::ContentTypeHeader).toString();
-                        fprintf(stderr, "[avatar] response is not a valid image for %s (content-type: %s, %lld bytes)\n",
-                            pkBa.constData(), ct.toUtf8().constData(), (long long)body.size());
-                    }
-                } else {
-                    fprintf(stderr, "[avatar] download failed for %s: %s\n",
-                        pkBa.constData(), reply->errorString().toUtf8().constData());
-                }
-                reply->deleteLater();
-            }
-            if (QFile::exists(filePath)) {
-                fprintf(stderr, "[avatar] cached at %s\n", filePath.toUtf8().constData());
-                QMetaObject::invokeMethod(this, "updateFolderAvatar",
-                    Qt::QueuedConnection, Q_ARG(QString, pk), Q_ARG(QString, filePath));
-            }
-        }
+void EventBridge::flushProfileFetches() {
+    if (m_profileFetchQueue.isEmpty() || m_nostrRelaysCsv.isEmpty()) return;
+    QByteArray pubkeysBa = m_profileFetchQueue.join(QLatin1Char(',')).toUtf8();
+    QByteArray relaysBa = m_nostrRelaysCsv.toUtf8();
+    QByteArray skBa = m_nostrSecretKey.toUtf8();
+    fprintf(stderr, "[avatar] fetching %lld profiles in one batch\n", (long long)m_profileFetchQueue.size());
+    auto *ctx = new ProfileBatchContext{this, m_profileFetchQueue};
+    m_profileFetchQueue.clear();
+    tagliacarte_nostr_fetch_profiles(pubkeysBa.constData(), relaysBa.constData(),
+        skBa.isEmpty() ? nullptr : skBa.constData(),
+        on_nostr_profile_cb, on_nostr_profiles_complete_cb, ctx);
+}
+
+void EventBridge::onNostrProfile(const QString &pubkey, const QString &displayName, const QString &nip05, const QString &pictureUrl) {
+    QString pk = pubkey.toLower();
+    fprintf(stderr, "[avatar] %s: name=%s picture=%s\n",
+        pk.toUtf8().constData(),
+        displayName.toUtf8().constData(),
+        pictureUrl.isEmpty() ? "(none)" : pictureUrl.toUtf8().constData());
+
+    m_profileFetchPending.remove(pk);
+    CachedProfile profile;
+    profile.displayName = displayName;
+    profile.nip05 = nip05;
+    profile.pictureUrl = pictureUrl;
+    m_profileCache.insert(pk, profile);
+    scheduleProfileCacheSave();
+
+    QString best = profile.bestName();
+    if (!best.isEmpty())
+        updateFolderDisplayName(pk, best);
+    if (!pictureUrl.isEmpty())
+        AvatarStore::instance()->request(pk, QUrl(pictureUrl));
+}
+
+void EventBridge::setProfileCacheTtl(int hours) {
+    m_profileCacheTtlSecs = static_cast<qint64>(qMax(1, hours)) * 3600;
+}
+
+void EventBridge::scheduleProfileCacheSave() {
+    if (m_profileCacheSaveScheduled) return;
+    m_profileCacheSaveScheduled = true;
+    // Profiles arrive in bursts; write the file once the burst is over
+    QTimer::singleShot(2000, this, [this]() {
+        m_profileCacheSaveScheduled = false;
+        m_profileCache.save();
     });
 }
 
+void EventBridge::onNostrProfilesComplete(const QStringList &pubkeys, int error) {
+    if (error != 0) {
+        const char *msg = tagliacarte_last_error();
+        fprintf(stderr, "[avatar] profile batch failed: %s\n", msg ? msg : "unknown error");
+    }
+    // Still pending: no relay had a profile. Remember that, so opening the conversation
+    // again does not refetch it until the entry expires.
+    int missing = 0;
+    for (const QString &pk : pubkeys) {
+        if (!m_profileFetchPending.remove(pk) || error != 0) continue;
+        m_profileCache.insertMissing(pk);
+        ++missing;
+    }
+    if (missing > 0) {
+        fprintf(stderr, "[avatar] %d of %lld pubkeys have no profile\n", missing, (long long)pubkeys.size());
+        scheduleProfileCacheSave();
+    }
+}
+
 void EventBridge::updateFolderDisplayName(const QString &realName, const QString &displayName) {
     m_nostrNameCache.insert(realName.toLower(), displayName);
     m_profileFetchPending.remove(realName.toLower());
@@ -244,41 +244,32 @@ void EventBridge::updateFolderDisplayName(const QString &realName, const QString
     if (item) {
         item->setText(0, displayName);
     }
-    if (isConversationMode() && !m_chatMessages.isEmpty())
-        renderChatMessages();
+    if (chatModel && chatModel->hasAuthor(realName.toLower()))
+        chatModel->setAuthorName(realName.toLower(), displayName);
 }
 
 // circularAvatar() is now in IconUtils.h/cpp
 
-void EventBridge::updateFolderAvatar(const QString &realName, const QString &filePath) {
+void EventBridge::updateFolderAvatar(const QString &realName) {
     QString lower = realName.toLower();
-    fprintf(stderr, "[avatar] updateFolderAvatar: pk=%s file=%s\n",
-        lower.toUtf8().constData(), filePath.toUtf8().constData());
-    m_nostrPictureCache.insert(lower, filePath);
     QTreeWidgetItem *item = findFolderItem(realName);
     if (item) {
-        QPixmap pix(filePath);
-        if (!pix.isNull()) {
-            item->setIcon(0, QIcon(circularAvatar(pix, 24)));
-            fprintf(stderr, "[avatar] folder icon set for %s\n", lower.toUtf8().constData());
-        } else {
-            fprintf(stderr, "[avatar] pixmap load FAILED for %s\n", filePath.toUtf8().constData());
-        }
-    } else {
-        fprintf(stderr, "[avatar] folder item NOT FOUND for %s\n", lower.toUtf8().constData());
+        QIcon icon = AvatarStore::instance()->icon(lower, 24);
+        if (!icon.isNull())
+            item->setIcon(0, icon);
     }
-    if (isConversationMode() && !m_chatMessages.isEmpty())
-        renderChatMessages();
+    if (chatModel && chatModel->hasAuthor(lower))
+        chatModel->setAuthorAvatar(lower, chatAvatar(lower));
 }
 
 void EventBridge::ensureProfilesFetched() {
     QSet<QString> needed;
-    for (const ChatMessage &msg : m_chatMessages) {
-        QString lower = msg.authorId.toLower();
-        if (!m_nostrNameCache.contains(lower) && !m_profileFetchPending.contains(lower) && isHexPubkey(lower))
+    const QStringList authors = chatModel ? chatModel->authorIds() : QStringList();
+    for (const QString &lower : authors) {
+        if (!m_profileCache.isFresh(lower, m_profileCacheTtlSecs) && !m_profileFetchPending.contains(lower) && isHexPubkey(lower))
             needed.insert(lower);
     }
-    if (!m_selfPubkey.isEmpty() && !m_nostrNameCache.contains(m_selfPubkey)
+    if (!m_selfPubkey.isEmpty() && !m_profileCache.isFresh(m_selfPubkey, m_profileCacheTtlSecs)
         && !m_profileFetchPending.contains(m_selfPubkey))
         needed.insert(m_selfPubkey);
     for (const QString &pk : needed)
@@ -290,161 +281,228 @@ QString EventBridge::authorDisplayName(const QString &authorId) const {
     if (m_nostrNameCache.contains(lower))
         return m_nostrNameCache.value(lower);
     if (isHexPubkey(lower)) {
-        QByteArray hexBa = lower.toUtf8();
-        char *npub = tagliacarte_nostr_hex_to_npub(hexBa.constData());
-        if (npub) {
-            QString s = QString::fromUtf8(npub);
-            tagliacarte_free_string(npub);
-            return s.left(12) + QStringLiteral("…");
-        }
+        QString npub = npubFor(lower);
+        if (!npub.isEmpty())
+            return npub.left(12) + QStringLiteral("…");
     }
     return authorId.left(12) + QStringLiteral("…");
 }
 
-QString EventBridge::authorAvatarPath(const QString &authorId) const {
-    QString lower = authorId.toLower();
-    QString cached = m_nostrPictureCache.value(lower);
-    if (!cached.isEmpty()) return cached;
-    // Fallback: check disk cache directly (handles timing gaps)
-    QString diskPath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
-        + QStringLiteral("/avatars/") + lower + QStringLiteral(".img");
-    if (QFile::exists(diskPath)) {
-        QImage test(diskPath);
-        if (!test.isNull()) {
-            const_cast<QMap<QString, QString> &>(m_nostrPictureCache).insert(lower, diskPath);
-            return diskPath;
-        }
-    }
-    return QString();
-}
-
-int EventBridge::avatarHue(const QString &id) {
-    uint hash = 0;
-    for (QChar c : id) {
-        hash = hash * 31 + c.unicode();
-    }
-    return static_cast<int>(hash % 360);
-}
-
-QString EventBridge::formatChatTimestamp(qint64 secs) {
-    if (secs <= 0) return QString();
-    QLocale locale;
-    QDateTime dt = QDateTime::fromSecsSinceEpoch(secs);
-    QDateTime now = QDateTime::currentDateTime();
-    QDate today = now.date();
-    if (dt.date() == today) {
-        return locale.toString(dt.time(), QLocale::ShortFormat);
-    }
-    int daysDiff = dt.date().daysTo(today);
-    if (daysDiff > 0 && daysDiff < 7) {
-        return locale.dayName(dt.date().dayOfWeek(), QLocale::ShortFormat)
-            + QStringLiteral(" ")
-            + locale.toString(dt.time(), QLocale::ShortFormat);
-    }
-    return locale.toString(dt, QLocale::ShortFormat);
-}
-
-void EventBridge::renderChatMessages() {
-    if (!messageView) return;
-    if (m_chatMessages.isEmpty()) {
-        QPalette pal = QApplication::palette();
-        QString mutedColor = pal.color(QPalette::Disabled, QPalette::WindowText).name();
-        messageView->setHtml(QStringLiteral(
-            "<p style='color:%1; text-align:center; padding-top:40px;'>No messages</p>").arg(mutedColor));
-        return;
+QString EventBridge::npubFor(const QString &lowerHex) const {
+    auto it = m_npubCache.constFind(lowerHex);
+    if (it != m_npubCache.constEnd())
+        return it.value();
+    QString npub = hexToNpub(lowerHex);
+    m_npubCache.insert(lowerHex, npub);
+    return npub;
+}
+
+QPixmap EventBridge::chatAvatar(const QString &authorId) const {
+    qreal dpr = chatView ? chatView->devicePixelRatioF() : qApp->devicePixelRatio();
+    return AvatarStore::instance()->pixmap(authorId.toLower(), ChatTimelineModel::AvatarPx, dpr);
+}
+
+void EventBridge::scheduleChatAppend() {
+    if (m_chatAppendScheduled) return;
+    m_chatAppendScheduled = true;
+    QTimer::singleShot(16, this, [this]() {
+        if (m_chatAppendScheduled)
+            appendChatMessages();
+    });
+}
+
+void EventBridge::registerChatAuthors(const QVector<ChatMessage> &messages) {
+    for (const ChatMessage &msg : messages) {
+        if (chatModel->hasAuthor(msg.authorId)) continue;
+        chatModel->setAuthorName(msg.authorId, authorDisplayName(msg.authorId));
+        QPixmap avatar = chatAvatar(msg.authorId);
+        if (!avatar.isNull())
+            chatModel->setAuthorAvatar(msg.authorId, avatar);
     }
+}
 
-    static const int AVATAR_PX = 40;
-
-    QPalette pal = QApplication::palette();
-    bool isDark = pal.color(QPalette::Window).lightness() < 128;
-    QString bgColor = pal.color(QPalette::Base).name();
-    QString textColor = pal.color(QPalette::Text).name();
-    QString mutedColor = isDark ? QStringLiteral("#888888") : QStringLiteral("#999999");
-    QString nameColor = isDark ? QStringLiteral("#dddddd") : QStringLiteral("#1d1c1d");
-
-    // Pre-render circular avatars as base64 data URIs (decoded in CidTextBrowser::loadResource)
-    fprintf(stderr, "[render] picture cache has %lld entries\n", (long long)m_nostrPictureCache.size());
-    QMap<QString, QString> avatarDataUris;
-    for (const ChatMessage &msg : m_chatMessages) {
-        QString lower = msg.authorId.toLower();
-        if (avatarDataUris.contains(lower)) continue;
-        QString avatarPath = authorAvatarPath(lower);
-        fprintf(stderr, "[render] author %s avatar=%s\n",
-            lower.left(8).toUtf8().constData(),
-            avatarPath.isEmpty() ? "(none)" : avatarPath.toUtf8().constData());
-        if (!avatarPath.isEmpty() && QFile::exists(avatarPath)) {
-            QPixmap pix(avatarPath);
-            if (!pix.isNull()) {
-                QPixmap circ = circularAvatar(pix, AVATAR_PX * 2);
-                QByteArray ba;
-                QBuffer buf(&ba);
-                buf.open(QIODevice::WriteOnly);
-                circ.save(&buf, "PNG");
-                buf.close();
-                if (!ba.isEmpty()) {
-                    avatarDataUris.insert(lower,
-                        QStringLiteral("data:image/png;base64,")
-                            + QString::fromLatin1(ba.toBase64()));
-                }
-            }
+void EventBridge::appendChatMessages() {
+    m_chatAppendScheduled = false;
+    if (!chatModel || m_pendingChatMessages.isEmpty()) return;
+    registerChatAuthors(m_pendingChatMessages);
+    chatModel->appendMessages(m_pendingChatMessages);
+    m_pendingChatMessages.clear();
+}
+
+void EventBridge::resetChatHistory() {
+    m_chatHistoryLoading = false;
+    m_chatHistoryMore = false;
+    m_chatHistoryLoaded = 0;
+    m_chatHistoryPage.clear();
+    m_chatHistoryIds.clear();
+}
+
+void EventBridge::requestChatHistory() {
+    if (m_folderUri.isEmpty()) return;
+    resetChatHistory();
+    // Pages are small and fast; a progress bar against the whole conversation would never fill
+    removeLoadProgressBar();
+    m_chatHistoryLoading = true;
+    tagliacarte_folder_request_conversation_history(m_folderUri.constData(), 0, ChatPageSize,
+        on_conversation_history_complete_cb);
+}
+
+void EventBridge::requestOlderChatMessages() {
+    if (m_folderUri.isEmpty() || m_chatHistoryLoading || !m_chatHistoryMore) return;
+    m_chatHistoryLoading = true;
+    tagliacarte_folder_request_conversation_history(m_folderUri.constData(), m_chatHistoryLoaded, ChatPageSize,
+        on_conversation_history_complete_cb);
+}
+
+void EventBridge::onConversationHistoryComplete(int error, int more) {
+    if (!m_chatHistoryLoading) return;  // folder changed while the page was loading
+    m_chatHistoryLoading = false;
+    QVector<ChatMessage> page;
+    page.swap(m_chatHistoryPage);
+    if (error != 0) {
+        m_chatHistoryMore = false;
+        if (m_chatHistoryLoaded == 0 && !m_folderUri.isEmpty()) {
+            // Folder cannot page its history: load the whole conversation as before
+            startMessageLoading(m_messageLoadTotal);
+            tagliacarte_folder_request_message_list(m_folderUri.constData(), 0, m_messageLoadTotal);
         }
+        return;
+    }
+    m_chatHistoryMore = more != 0;
+    m_chatHistoryLoaded += static_cast<quint64>(page.size());
+    // Stores may deliver a page newest first; the model is oldest first. Messages that arrived
+    // since the previous page shift the window, so drop any already shown.
+    std::stable_sort(page.begin(), page.end(), [](const ChatMessage &a, const ChatMessage &b) {
+        return a.timestampSecs < b.timestampSecs;
+    });
+    page.erase(std::remove_if(page.begin(), page.end(), [this](const ChatMessage &msg) {
+        return m_chatHistoryIds.contains(msg.id);
+    }), page.end());
+    for (const ChatMessage &msg : page) {
+        m_chatHistoryIds.insert(msg.id);
+    }
+    if (chatModel && !page.isEmpty()) {
+        registerChatAuthors(page);
+        chatModel->prependMessages(page);
+        ensureProfilesFetched();
+    }
+    if (statusBar && chatModel) {
+        statusBar->showMessage(TR_N("status.folder_messages_count", chatModel->rowCount()));
+    }
+}
+
+void EventBridge::subscribeChat() {
+    if (m_folderUri.isEmpty()) return;
+    LiveSubscriptionContext *&ctx = m_liveSubscriptions[m_folderUri];
+    if (!ctx)
+        ctx = new LiveSubscriptionContext{this, QString::fromUtf8(m_folderUri)};
+    tagliacarte_folder_subscribe(m_folderUri.constData(), on_message_added_cb, on_message_updated_cb, ctx);
+}
+
+void EventBridge::onMessageAdded(const QString &folderUri, const QString &id, const QString &subject, const QString &from, qint64 timestampSecs) {
+    // Queued before the bridge moved to another folder
+    if (folderUri.toUtf8() != m_folderUri) return;
+    if (!isConversationMode() || !chatModel) return;
+    // Relays and sync may repeat an event the history page already showed
+    if (m_chatHistoryIds.contains(id)) return;
+    m_chatHistoryIds.insert(id);
+    // Our own message coming back: it takes the place of its local echo
+    if (chatModel->confirmLocalMessage({id, subject, from.toLower(), timestampSecs}))
+        return;
+    m_pendingChatMessages.append({id, subject, from.toLower(), timestampSecs});
+    scheduleChatAppend();
+    if (statusBar) {
+        statusBar->showMessage(TR_N("status.folder_messages_count", chatModel->rowCount() + m_pendingChatMessages.size()));
     }
+}
+
+void EventBridge::onMessageUpdated(const QString &folderUri, const QString &id, const QString &subject, const QString &from, qint64 timestampSecs) {
+    if (folderUri.toUtf8() != m_folderUri) return;
+    if (!isConversationMode() || !chatModel) return;
+    if (!chatModel->updateMessage({id, subject, from.toLower(), timestampSecs}))
+        onMessageAdded(folderUri, id, subject, from, timestampSecs);
+}
 
-    QString html;
-    html.reserve(m_chatMessages.size() * 500);
-    html += QStringLiteral(
-        "<html><body style='margin:0; padding:0; background-color:%1; color:%2;'>"
-    ).arg(bgColor, textColor);
+void EventBridge::queueChatMessage(const QByteArray &transportUri, const QString &to, const QString &text) {
+    QString body = text.trimmed();
+    if (body.isEmpty() || to.isEmpty()) return;
+    ChatSend send;
+    send.localId = ChatTimelineModel::LocalIdPrefix + QString::number(++m_chatSendSerial);
+    send.transportUri = transportUri;
+    send.from = m_selfPubkey.toUtf8();
+    send.to = to.toUtf8();
+    send.body = body.toUtf8();
+    if (chatModel) {
+        // Ahead of anything still coalescing, so the echo lands below what has been received
+        appendChatMessages();
+        ChatMessage echo{send.localId, body, m_selfPubkey.toLower(), QDateTime::currentSecsSinceEpoch(), ChatMessage::Sending};
+        registerChatAuthors({echo});
+        chatModel->appendMessages({echo});
+        if (chatView)
+            chatView->scrollToBottom();
+    }
+    QQueue<ChatSend> &queue = m_chatSendQueues[to];
+    queue.enqueue(send);
+    if (queue.size() == 1)
+        startChatSend(to);
+}
 
-    for (const ChatMessage &msg : m_chatMessages) {
-        QString lower = msg.authorId.toLower();
-        QString name = authorDisplayName(lower).toHtmlEscaped();
-        QString timeStr = formatChatTimestamp(msg.timestampSecs).toHtmlEscaped();
-        QString content = msg.content.toHtmlEscaped().replace(QLatin1Char('\n'), QStringLiteral("<br>"));
+void EventBridge::startChatSend(const QString &conversation) {
+    const ChatSend &send = m_chatSendQueues[conversation].head();
+    fprintf(stderr, "[chat] sending to %s via %s\n", send.to.constData(), send.transportUri.constData());
+    tagliacarte_transport_send_async(
+        send.transportUri.constData(),
+        send.from.constData(),
+        send.to.constData(),
+        nullptr,
+        nullptr,
+        nullptr,
+        send.body.constData(),
+        nullptr,
+        0,
+        nullptr,
+        nullptr,
+        on_chat_send_complete_cb,
+        new ChatSendContext{this, conversation}
+    );
+}
 
-        QString avatarHtml;
-        if (avatarDataUris.contains(lower)) {
-            avatarHtml = QStringLiteral("<img src='%1' width='%2' height='%2' />")
-                .arg(avatarDataUris.value(lower), QString::number(AVATAR_PX));
-        } else {
-            int hue = avatarHue(lower);
-            int sat = isDark ? 50 : 60;
-            int light = isDark ? 40 : 65;
-            QString circleColor = QColor::fromHsl(hue, sat * 255 / 100, light * 255 / 100).name();
-            QString initial = name.isEmpty() ? QStringLiteral("?") : name.left(1).toUpper();
-            avatarHtml = QStringLiteral(
-                "<table cellspacing='0' cellpadding='0'><tr><td style='"
-                "width:%3px; height:%3px; background-color:%1;"
-                "text-align:center; vertical-align:middle; color:#ffffff; font-weight:bold;"
-                "font-size:18px;'>%2</td></tr></table>"
-            ).arg(circleColor, initial.toHtmlEscaped(), QString::number(AVATAR_PX));
-        }
-
-        html += QStringLiteral(
-            "<table width='100%%' cellspacing='0' cellpadding='0' style='padding:6px 16px;'><tr>"
-            "<td width='%5' style='vertical-align:top; padding-top:4px;'>%1</td>"
-            "<td style='vertical-align:top; padding:2px 4px 8px 6px;'>"
-            "<b style='font-size:14px; color:%6;'>%2</b>"
-            "&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;"
-            "<span style='font-size:11px; color:%7;'>%3</span>"
-            "<br/>%4"
-            "</td></tr></table>"
-        ).arg(avatarHtml, name, timeStr, content,
-              QString::number(AVATAR_PX + 8), nameColor, mutedColor);
-    }
-
-    html += QStringLiteral("</body></html>");
-    messageView->setHtml(html);
-
-    QTextCursor cursor = messageView->textCursor();
-    cursor.movePosition(QTextCursor::End);
-    messageView->setTextCursor(cursor);
-    messageView->ensureCursorVisible();
+void EventBridge::onChatSendComplete(const QString &conversation, int ok) {
+    auto it = m_chatSendQueues.find(conversation);
+    if (it == m_chatSendQueues.end() || it->isEmpty()) return;
+    ChatSend done = it->dequeue();
+    // The echo is gone if another conversation has been opened meanwhile
+    if (chatModel)
+        chatModel->setDelivery(done.localId, ok == 0 ? ChatMessage::Sent : ChatMessage::Failed);
+    if (ok != 0 && statusBar)
+        statusBar->showMessage(TR("chat.send_failed"));
+    if (it->isEmpty())
+        m_chatSendQueues.erase(it);
+    else
+        startChatSend(conversation);
 }
 
 // --- EventBridge implementation ---
 
+EventBridge::EventBridge(QObject *parent)
+    : QObject(parent)
+{
+    connect(AvatarStore::instance(), &AvatarStore::avatarReady, this, &EventBridge::updateFolderAvatar);
+    // Warm start: names from the last session, until their profiles are refreshed
+    const QHash<QString, CachedProfile> &profiles = m_profileCache.profiles();
+    for (auto it = profiles.constBegin(); it != profiles.constEnd(); ++it) {
+        QString name = it->bestName();
+        if (!name.isEmpty())
+            m_nostrNameCache.insert(it.key(), name);
+    }
+}
+
+EventBridge::~EventBridge() {
+    m_profileCache.save();
+    qDeleteAll(m_liveSubscriptions);
+    qDeleteAll(m_folderListContexts);
+}
+
 void EventBridge::setFolderUri(const QByteArray &uri) {
     if (!m_folderUri.isEmpty()) {
         tagliacarte_folder_free(m_folderUri.constData());
@@ -475,13 +533,87 @@ void EventBridge::clearFolder() {
         tagliacarte_folder_free(m_folderUri.constData());
         m_folderUri.clear();
     }
+    m_pendingChatMessages.clear();
+    m_chatAppendScheduled = false;
+    resetChatHistory();
+    if (chatModel) {
+        chatModel->clear();
+    }
+}
+
+void EventBridge::showCachedFolders(const QByteArray &storeUri) {
+    m_folderListStoreUri = QString::fromUtf8(storeUri);
+    m_folderListStartUs = Trace::now();
+    m_listedFolders.clear();
+    m_listedNames.clear();
+    const QVector<CachedFolder> cached = m_folderListCache.folders(m_folderListStoreUri);
+    if (cached.isEmpty()) {
+        return;
+    }
+    if (newsgroups && newsgroups->isActive()) {
+        for (const CachedFolder &folder : cached) {
+            newsgroups->addGroup(folder.name);
+        }
+        newsgroups->finishLoading();
+        return;
+    }
+    for (const CachedFolder &folder : cached) {
+        insertFolder(folder.name, folder.delimiter, folder.attributes);
+    }
+}
+
+FolderListContext *EventBridge::folderListContext(const QByteArray &storeUri) {
+    FolderListContext *&ctx = m_folderListContexts[storeUri];
+    if (!ctx)
+        ctx = new FolderListContext{this, QString::fromUtf8(storeUri)};
+    return ctx;
+}
+
+void EventBridge::refreshFolders(const QByteArray &storeUri) {
+    ++folderListContext(storeUri)->pending;
+    tagliacarte_store_refresh_folders(storeUri.constData());
 }
 
 void EventBridge::addFolder(const QString &name, const QString &delimiter, const QString &attributes) {
     if (!folderTree) {
         return;
     }
+    if (!m_listedNames.contains(name)) {
+        m_listedNames.insert(name);
+        m_listedFolders.append(CachedFolder{ name, delimiter, attributes });
+    }
+    if (newsgroups && newsgroups->isActive()) {
+        newsgroups->addGroup(name);
+        return;
+    }
+    insertFolder(name, delimiter, attributes);
+}
 
+void EventBridge::queueFolderFound(const QString &storeUri, const QString &name, const QString &delimiter, const QString &attributes) {
+    QMutexLocker lock(&m_foundFoldersMutex);
+    m_foundFolders.append({ storeUri, CachedFolder{ name, delimiter, attributes } });
+    // The first folder of a batch schedules it; later ones join until it runs
+    if (m_foundFolders.size() == 1) {
+        QMetaObject::invokeMethod(this, "addQueuedFolders", Qt::QueuedConnection);
+    }
+}
+
+void EventBridge::addQueuedFolders() {
+    QVector<QPair<QString, CachedFolder>> folders;
+    {
+        QMutexLocker lock(&m_foundFoldersMutex);
+        folders.swap(m_foundFolders);
+    }
+    for (const auto &[storeUri, folder] : std::as_const(folders)) {
+        // Listed for a store the tree no longer shows
+        if (storeUri != m_folderListStoreUri) {
+            continue;
+        }
+        addFolder(folder.name, folder.delimiter, folder.attributes);
+    }
+}
+
+void EventBridge::insertFolder(const QString &name, const QString &delimiter, const QString &attributes) {
     // Split by delimiter to build hierarchy
     QStringList parts;
     QChar delimChar;
@@ -493,6 +625,7 @@ void EventBridge::addFolder(const QString &name, const QString &delimiter, const
     }
 
     // Walk/create the hierarchy in the tree
+    const QHash<QString, FolderCounts> storeCounts = m_folderCounts.value(m_folderListStoreUri);
     QTreeWidgetItem *parent = nullptr;
     QString pathSoFar;
     for (int i = 0; i < parts.size(); ++i) {
@@ -503,16 +636,8 @@ void EventBridge::addFolder(const QString &name, const QString &delimiter, const
 
         bool isLeaf = (i == parts.size() - 1);
 
-        // Try to find existing item at this level
-        QTreeWidgetItem *existing = nullptr;
-        int childCount = parent ? parent->childCount() : folderTree->topLevelItemCount();
-        for (int c = 0; c < childCount; ++c) {
-            QTreeWidgetItem *child = parent ? parent->child(c) : folderTree->topLevelItem(c);
-            if (child->data(0, FolderNameRole).toString() == pathSoFar) {
-                existing = child;
-                break;
-            }
-        }
+        // Paths are unique across the tree, so the item at this level is found by its path
+        QTreeWidgetItem *existing = m_folderItems.value(pathSoFar);
 
         if (existing) {
             if (isLeaf) {
@@ -532,16 +657,16 @@ void EventBridge::addFolder(const QString &name, const QString &delimiter, const
                 if (m_nostrNameCache.contains(lower)) {
                     displayText = m_nostrNameCache.value(lower);
                 } else {
-                    QByteArray hexBa = lower.toUtf8();
-                    char *npub = tagliacarte_nostr_hex_to_npub(hexBa.constData());
-                    if (npub) {
-                        displayText = QString::fromUtf8(npub);
-                        tagliacarte_free_string(npub);
-                    } else {
+                    displayText = npubFor(lower);
+                    if (displayText.isEmpty())
                         displayText = lower;
-                    }
-                    needsProfileFetch = true;
                 }
+                QIcon avatar = AvatarStore::instance()->icon(lower, 24);
+                if (!avatar.isNull()) {
+                    item->setIcon(0, avatar);
+                }
+                // Cached profiles show at once; fetchNostrProfile refreshes them once the TTL has passed
+                needsProfileFetch = true;
             } else {
                 displayText = displayNameForFolder(parts[i]);
             }
@@ -565,6 +690,10 @@ void EventBridge::addFolder(const QString &name, const QString &delimiter, const
                 folderTree->addTopLevelItem(item);
             }
             item->setExpanded(true);
+            auto counts = storeCounts.constFind(pathSoFar);
+            if (counts != storeCounts.constEnd()) {
+                applyFolderCounts(item, *counts);
+            }
             parent = item;
 
             if (needsProfileFetch) {
@@ -575,6 +704,18 @@ void EventBridge::addFolder(const QString &name, const QString &delimiter, const
 }
 
 void EventBridge::removeFolder(const QString &name) {
+    if (m_listedNames.remove(name)) {
+        for (int i = 0; i < m_listedFolders.size(); ++i) {
+            if (m_listedFolders[i].name == name) {
+                m_listedFolders.remove(i);
+                break;
+            }
+        }
+    }
+    if (newsgroups && newsgroups->isActive()) {
+        newsgroups->removeGroup(name);
+        return;
+    }
     QTreeWidgetItem *item = findFolderItem(name);
     if (!item) {
         return;
@@ -591,7 +732,85 @@ void EventBridge::removeFolder(const QString &name) {
     delete item;
 }
 
-void EventBridge::onFolderListComplete(int error, const QString &errorMessage) {
+void EventBridge::onFolderRemoved(const QString &storeUri, const QString &name) {
+    if (storeUri != m_folderListStoreUri) {
+        return;
+    }
+    removeFolder(name);
+}
+
+void EventBridge::onFolderStatus(const QString &storeUri, const QString &name, quint64 total, quint64 unread) {
+    FolderCounts &counts = m_folderCounts[storeUri][name];
+    counts.total = total;
+    counts.unread = unread;
+    if (storeUri != m_folderListStoreUri || (newsgroups && newsgroups->isActive())) {
+        return;
+    }
+    if (QTreeWidgetItem *item = findFolderItem(name)) {
+        applyFolderCounts(item, counts);
+    }
+}
+
+void EventBridge::applyFolderCounts(QTreeWidgetItem *item, const FolderCounts &counts) {
+    item->setText(1, counts.unread > 0
+        ? QStringLiteral("%1/%2").arg(counts.unread).arg(counts.total)
+        : QString::number(counts.total));
+    item->setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+    item->setToolTip(1, TR("folder.counts_tooltip").arg(counts.total).arg(counts.unread));
+    QFont font = item->font(0);
+    font.setBold(counts.unread > 0);
+    item->setFont(0, font);
+    item->setFont(1, font);
+}
+
+void EventBridge::removeUnlistedFolders() {
+    QStringList stale;
+    for (auto it = m_folderItems.constBegin(); it != m_folderItems.constEnd(); ++it) {
+        if (!m_listedNames.contains(it.key())) {
+            stale.append(it.key());
+        }
+    }
+    // Children before parents: a parent of a listed folder keeps its children and stays
+    std::sort(stale.begin(), stale.end(), [](const QString &a, const QString &b) {
+        return a.size() > b.size();
+    });
+    for (const QString &name : stale) {
+        QTreeWidgetItem *item = findFolderItem(name);
+        if (item && item->childCount() == 0) {
+            removeFolder(name);
+        }
+    }
+}
+
+void EventBridge::onFolderListComplete(const QString &storeUri, int error, const QString &errorMessage) {
+    FolderListContext *ctx = folderListContext(storeUri.toUtf8());
+    if (ctx->pending > 0) {
+        --ctx->pending;
+    }
+    // A listing for a store the tree no longer shows, or one overtaken by a later listing of
+    // this store: what it reported is not the whole list, so it neither reconciles nor caches
+    if (storeUri != m_folderListStoreUri || ctx->pending > 0) {
+        return;
+    }
+    if (m_folderListStartUs >= 0) {
+        Trace::record("folder.list", m_folderListStartUs, m_listedFolders.size());
+        m_folderListStartUs = -1;
+    }
+    // Show what was listed, even if the listing broke off
+    if (newsgroups && newsgroups->isActive() && error != TAGLIACARTE_NEEDS_CREDENTIAL) {
+        newsgroups->finishLoading();
+    }
+    if (error == 0) {
+        // The tree started from the cached list: reconcile it with what the server reported
+        if (!newsgroups || !newsgroups->isActive()) {
+            removeUnlistedFolders();
+        }
+        m_folderListCache.setFolders(m_folderListStoreUri, m_listedFolders);
+        m_folderListCache.save();
+    }
+    // A failed listing leaves the cached folders in place; the next one starts afresh
+    m_listedFolders.clear();
+    m_listedNames.clear();
     if (statusBar && win) {
         if (error == TAGLIACARTE_NEEDS_CREDENTIAL) {
             return;
@@ -600,8 +819,10 @@ void EventBridge::onFolderListComplete(int error, const QString &errorMessage) {
             QString detail = errorMessage.isEmpty() ? TR("error.unknown") : errorMessage;
             QMessageBox::warning(win, TR("common.error"),
                 TR("error.context.store_connect") + QStringLiteral("\n\n") + detail);
+        } else if (newsgroups && newsgroups->isActive()) {
+            statusBar->showMessage(TR_N("status.folders_count", newsgroups->groupCount()));
         } else if (folderTree) {
-            statusBar->showMessage(TR_N("status.folders_count", countAllItems(folderTree)));
+            statusBar->showMessage(TR_N("status.folders_count", folderCount()));
         }
     }
     if (conversationList && error == 0) {
@@ -610,6 +831,9 @@ void EventBridge::onFolderListComplete(int error, const QString &errorMessage) {
             conversationList->scrollToItem(conversationList->topLevelItem(n - 1));
         }
     }
+    if (error == 0) {
+        emit folderListLoaded();
+    }
 }
 
 void EventBridge::requestCredentialSlot(const QString &storeUri, const QString &username, int isPlaintext, int authType) {
@@ -633,6 +857,10 @@ void EventBridge::onFolderReady(const QString &folderUri) {
     if (realName != m_folderNameOpening) {
         return; /* stale: user selected a different folder */
     }
+    if (m_folderOpenStartUs >= 0) {
+        Trace::record("folder.select", m_folderOpenStartUs);
+        m_folderOpenStartUs = -1;
+    }
     setFolderUri(folderUri.toUtf8());
     tagliacarte_folder_message_count(m_folderUri.constData(), on_message_count_complete_cb, this);
 }
@@ -652,12 +880,13 @@ void EventBridge::showOpeningMessageCount(quint32 count) {
 void EventBridge::startMessageLoading(quint64 total) {
     m_messageLoadTotal = total;
     m_messageLoadCount = 0;
-    m_chatMessages.clear();
-    if (m_loadProgressBar) {
-        statusBar->removeWidget(m_loadProgressBar);
-        delete m_loadProgressBar;
-        m_loadProgressBar = nullptr;
-    }
+    m_messageListStartUs = Trace::now();
+    m_pendingChatMessages.clear();
+    m_chatAppendScheduled = false;
+    resetChatHistory();
+    if (chatModel)
+        chatModel->clear();
+    removeLoadProgressBar();
     if (statusBar && total > 0) {
         m_loadProgressBar = new QProgressBar();
         m_loadProgressBar->setRange(0, static_cast<int>(total));
@@ -668,26 +897,38 @@ void EventBridge::startMessageLoading(quint64 total) {
     }
 }
 
-void EventBridge::addMessageSummary(const QString &id, const QString &subject, const QString &from, const QString &dateFormatted, qint64 timestampSecs, quint64 size, quint32 flags) {
-    if (isConversationMode()) {
-        m_chatMessages.append({subject, from.toLower(), timestampSecs});
-        m_messageLoadCount++;
-        if (m_loadProgressBar)
-            m_loadProgressBar->setValue(static_cast<int>(m_messageLoadCount));
-        return;
+void EventBridge::removeLoadProgressBar() {
+    if (m_loadProgressBar && statusBar) {
+        statusBar->removeWidget(m_loadProgressBar);
+        delete m_loadProgressBar;
+        m_loadProgressBar = nullptr;
     }
+}
 
-    if (!conversationList) {
-        return;
+// Message list row whose date column compares by timestamp (the text is locale-formatted)
+class MessageItem : public QTreeWidgetItem {
+public:
+    using QTreeWidgetItem::QTreeWidgetItem;
+
+    bool operator<(const QTreeWidgetItem &other) const override {
+        const int column = treeWidget() ? treeWidget()->sortColumn() : 0;
+        if (column == 2) {
+            return data(2, MessageTimestampRole).toLongLong() < other.data(2, MessageTimestampRole).toLongLong();
+        }
+        return QTreeWidgetItem::operator<(other);
     }
+};
+
+QTreeWidgetItem *EventBridge::newMessageItem(const QString &id, const QString &subject, const QString &from, const QString &dateFormatted, qint64 timestampSecs, quint32 flags) {
     QString fromStr = from.trimmed();
     if (fromStr.isEmpty() || fromStr.compare(QLatin1String("(unknown)"), Qt::CaseInsensitive) == 0) {
         fromStr = TR("message.unknown_sender");
     }
     QString subj = subject.isEmpty() ? TR("message.no_subject") : subject;
-    auto *item = new QTreeWidgetItem(QStringList() << fromStr << subj << dateFormatted);
+    auto *item = new MessageItem(QStringList() << fromStr << subj << dateFormatted);
     item->setData(0, MessageIdRole, id);
     item->setData(0, MessageFlagsRole, flags);
+    item->setData(2, MessageTimestampRole, timestampSecs);
     item->setTextAlignment(2, Qt::AlignRight | Qt::AlignVCenter);  // date column right-aligned
 
     // Apply flag-based visual styling
@@ -703,9 +944,44 @@ void EventBridge::addMessageSummary(const QString &id, const QString &subject, c
         }
         item->setFont(col, f);
     }
+    return item;
+}
+
+QByteArray EventBridge::folderUriForItem(const QTreeWidgetItem *item) const {
+    QByteArray uri = item ? item->data(0, MessageFolderUriRole).toByteArray() : QByteArray();
+    return uri.isEmpty() ? m_folderUri : uri;
+}
+
+void EventBridge::addMessageSummary(const QString &id, const QString &subject, const QString &from, const QString &dateFormatted, qint64 timestampSecs, quint64 size, quint32 flags) {
+    if (isConversationMode() && m_chatHistoryLoading) {
+        // Held until the page completes: it is sorted and inserted above the loaded messages
+        m_chatHistoryPage.append({id, subject, from.toLower(), timestampSecs});
+        return;
+    }
+    if (isConversationMode()) {
+        m_pendingChatMessages.append({id, subject, from.toLower(), timestampSecs});
+        scheduleChatAppend();
+        m_messageLoadCount++;
+        if (m_loadProgressBar)
+            m_loadProgressBar->setValue(static_cast<int>(m_messageLoadCount));
+        return;
+    }
 
-    conversationList->addTopLevelItem(item);
+    if (!conversationList) {
+        return;
+    }
+    conversationList->addTopLevelItem(newMessageItem(id, subject, from, dateFormatted, timestampSecs, flags));
 
+    if (m_messageLoadCount == 0) {
+        static bool firstRowTraced = false;
+        if (!firstRowTraced) {
+            Trace::record("startup.first_row", 0);
+            firstRowTraced = true;
+        }
+        if (m_messageListStartUs >= 0) {
+            Trace::record("message_list.first_row", m_messageListStartUs);
+        }
+    }
     m_messageLoadCount++;
     if (m_loadProgressBar) {
         m_loadProgressBar->setValue(static_cast<int>(m_messageLoadCount));
@@ -713,17 +989,17 @@ void EventBridge::addMessageSummary(const QString &id, const QString &subject, c
 }
 
 void EventBridge::onMessageListComplete(int error) {
-    if (m_loadProgressBar && statusBar) {
-        statusBar->removeWidget(m_loadProgressBar);
-        delete m_loadProgressBar;
-        m_loadProgressBar = nullptr;
+    removeLoadProgressBar();
+    if (m_messageListStartUs >= 0) {
+        Trace::record("message_list", m_messageListStartUs, static_cast<qint64>(m_messageLoadCount));
+        m_messageListStartUs = -1;
     }
 
     if (isConversationMode() && error == 0) {
         ensureProfilesFetched();
-        renderChatMessages();
-        if (statusBar) {
-            statusBar->showMessage(TR_N("status.folder_messages_count", m_chatMessages.size()));
+        appendChatMessages();
+        if (statusBar && chatModel) {
+            statusBar->showMessage(TR_N("status.folder_messages_count", chatModel->rowCount()));
         }
         return;
     }
@@ -741,9 +1017,16 @@ void EventBridge::onMessageListComplete(int error) {
             conversationList->scrollToItem(conversationList->topLevelItem(n - 1));
         }
     }
+    if (error == 0) {
+        emit messageListLoaded();
+    }
 }
 
 void EventBridge::showMessageMetadata(const QString &subject, const QString &from, const QString &to, const QString &date) {
+    if (m_messageLoadStartUs >= 0) {
+        Trace::record("message.fetch", m_messageLoadStartUs);
+    }
+    m_messageMimeStartUs = Trace::now();
     setLastMessage(from, to, subject, QString());
     // Populate header labels (outside QTextBrowser, unaffected by HTML backgrounds)
     if (headerFromLabel) {
@@ -767,6 +1050,7 @@ void EventBridge::showMessageMetadata(const QString &subject, const QString &fro
     m_inlineHtmlParts.clear();
     m_alternativeGroupStart = -1;
     m_inMultipartAlternative = false;
+    m_pendingPlainText.clear();
     if (messageView) {
         messageView->setHtml(TR("status.loading"));
     }
@@ -795,6 +1079,12 @@ void EventBridge::onStartEntity() {
     m_entityIsHtml = false;
     m_entityIsPlain = false;
     m_entityBuffer.clear();
+    m_entityDeferredSection.clear();
+    m_entityDeferredSize = 0;
+    m_entityCharset.clear();
+    m_entityStreamingPlain = false;
+    m_entityDecodesText = false;
+    m_entityText.clear();
 }
 
 void EventBridge::onContentType(const QString &value) {
@@ -802,6 +1092,9 @@ void EventBridge::onContentType(const QString &value) {
     m_entityIsMultipart = m_entityContentType.startsWith(QLatin1String("multipart/"));
     m_entityIsHtml = m_entityContentType.startsWith(QLatin1String("text/html"));
     m_entityIsPlain = m_entityContentType.startsWith(QLatin1String("text/plain"));
+    static QRegularExpression charsetRe(QStringLiteral("charset\\s*=\\s*\"?([^\";\\s]+)\"?"));
+    auto match = charsetRe.match(m_entityContentType);
+    m_entityCharset = match.hasMatch() ? match.captured(1) : QString();
     // Track multipart/alternative groups for text/html replacing text/plain
     if (m_entityContentType.startsWith(QLatin1String("multipart/alternative"))) {
         m_inMultipartAlternative = true;
@@ -831,28 +1124,96 @@ void EventBridge::onEndHeaders() {
     if (m_entityIsMultipart) {
         return;  // multipart containers have no displayable body
     }
+    // Inline text is only ever used decoded, so decode it as it arrives instead of keeping the
+    // bytes. Parts with a Content-ID keep their bytes for the CID registry.
+    m_entityDecodesText = (m_entityIsHtml || m_entityIsPlain) && !m_entityIsAttachment
+        && m_entityDeferredSection.isEmpty() && m_entityContentId.isEmpty();
+    if (m_entityDecodesText) {
+        m_entityDecoder = entityDecoder();
+    }
     // For text/plain not in alternative: set up progressive display
     if (m_entityIsPlain && !m_entityIsAttachment && !m_inMultipartAlternative) {
         if (messageView) {
             // Show existing composite + empty <pre> for progressive text append
             messageView->setHtml(m_inlineHtmlParts.join(QString()) + QStringLiteral("<pre></pre>"));
+            m_entityStreamingPlain = true;
+            if (!m_entityDecodesText) {
+                m_entityDecodesText = true;
+                m_entityDecoder = entityDecoder();
+            }
+        }
+    }
+}
+
+QStringDecoder EventBridge::entityDecoder() const {
+    if (!m_entityCharset.isEmpty()) {
+        QStringDecoder decoder(m_entityCharset.toLatin1().constData());
+        if (decoder.isValid()) {
+            return decoder;
         }
     }
+    return QStringDecoder(QStringDecoder::Utf8);
+}
+
+void EventBridge::finishEntityText() {
+    QString tail = m_entityDecoder.finish();
+    if (tail.isEmpty()) {
+        return;
+    }
+    m_entityText.append(tail);
+    if (m_entityStreamingPlain) {
+        m_pendingPlainText.append(tail);
+    }
+}
+
+QString EventBridge::takeEntityText() {
+    if (!m_entityDecodesText) {
+        return entityDecoder().decode(m_entityBuffer);
+    }
+    QString text = std::move(m_entityText);
+    m_entityText.clear();
+    return text;
+}
+
+void EventBridge::flushPendingPlainText() {
+    if (m_pendingPlainText.isEmpty() || !messageView) {
+        return;
+    }
+    // One insert per frame: a single relayout however many chunks arrived since the last one.
+    // CR is dropped because insertText treats it as a block break of its own.
+    m_pendingPlainText.remove(QLatin1Char('\r'));
+    QTextCursor cursor(messageView->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(m_pendingPlainText);
+    m_pendingPlainText.clear();
 }
 
 void EventBridge::onBodyContent(const QByteArray &data) {
     if (m_entityIsMultipart) {
         return;
     }
-    // Always buffer for onEndEntity processing
-    m_entityBuffer.append(data);
-    // Progressive display for text/plain (not in alternative, not attachment)
-    if (m_entityIsPlain && !m_entityIsAttachment && !m_inMultipartAlternative && messageView) {
-        QTextCursor cursor = messageView->textCursor();
-        cursor.movePosition(QTextCursor::End);
-        cursor.insertText(QString::fromUtf8(data));
-        messageView->setTextCursor(cursor);
+    // data may be a raw view of a core-owned buffer (on_body_buffer_cb), valid only during this
+    // call. Text is decoded straight from it; only the bytes of other parts are copied and kept.
+    if (m_entityStreamingPlain) {
+        // Progressive display for text/plain: decode statefully, insert on the next frame
+        QString text = m_entityDecoder.decode(data);
+        m_entityText.append(text);
+        m_pendingPlainText.append(text);
+        if (!m_plainTextFlushScheduled) {
+            m_plainTextFlushScheduled = true;
+            QTimer::singleShot(16, this, [this]() {
+                m_plainTextFlushScheduled = false;
+                flushPendingPlainText();
+            });
+        }
+        return;
     }
+    if (m_entityDecodesText) {
+        m_entityText.append(m_entityDecoder.decode(data));
+        return;
+    }
+    // Inline images and attachments: kept for onEndEntity
+    m_entityBuffer.append(data.constData(), data.size());
 }
 
 void EventBridge::onEndEntity() {
@@ -866,6 +1227,9 @@ void EventBridge::onEndEntity() {
     if (!messageView) {
         return;
     }
+    if (m_entityDecodesText) {
+        finishEntityText();
+    }
 
     // Register CID resource if Content-ID is present.
     // CidTextBrowser::loadResource looks up directly from the registry on demand,
@@ -874,9 +1238,10 @@ void EventBridge::onEndEntity() {
         m_cidRegistry.insert(m_entityContentId, m_entityBuffer);
     }
 
-    if (m_entityIsAttachment) {
+    bool deferred = !m_entityDeferredSection.isEmpty();
+    if (m_entityIsAttachment || deferred) {
         // Attachment: create save button in attachments pane
-        if (attachmentsPane && !m_entityBuffer.isEmpty()) {
+        if (attachmentsPane && (!m_entityBuffer.isEmpty() || deferred)) {
             QLayout *layout = attachmentsPane->layout();
             if (!layout) {
                 layout = new QHBoxLayout(attachmentsPane);
@@ -886,24 +1251,50 @@ void EventBridge::onEndEntity() {
                 layout->addWidget(new QLabel(TR("message.attachments") + QStringLiteral(":"), attachmentsPane));
             }
             QString label = m_entityFilename.isEmpty() ? QStringLiteral("unnamed") : m_entityFilename;
-            auto *btn = new QPushButton(label, attachmentsPane);
-            QByteArray data = m_entityBuffer;  // copy for lambda capture
-            QObject::connect(btn, &QPushButton::clicked, [label, data]() {
-                QString path = QFileDialog::getSaveFileName(nullptr, QString(), label);
-                if (!path.isEmpty()) {
-                    QFile f(path);
-                    if (f.open(QIODevice::WriteOnly)) {
-                        f.write(data);
+            if (deferred) {
+                // Body still on the server: fetch it straight to the chosen file on save
+                auto *btn = new QPushButton(QStringLiteral("%1 (%2)").arg(label, QLocale().formattedDataSize(static_cast<qint64>(m_entityDeferredSize))), attachmentsPane);
+                QByteArray folderUri = m_folderUri;
+                QByteArray messageId = m_messageIdLoading;
+                QByteArray section = m_entityDeferredSection.toUtf8();
+                QObject::connect(btn, &QPushButton::clicked, this, [this, label, folderUri, messageId, section]() {
+                    QString path = QFileDialog::getSaveFileName(nullptr, QString(), label);
+                    if (path.isEmpty()) {
+                        return;
+                    }
+                    auto *file = new QFile(path);
+                    if (!file->open(QIODevice::WriteOnly)) {
+                        delete file;
+                        onPartSaved(path, -1);
+                        return;
+                    }
+                    if (statusBar) {
+                        statusBar->showMessage(TR("status.saving_attachment"));
+                    }
+                    auto *ctx = new PartSaveContext{this, file};
+                    tagliacarte_folder_request_message_part(folderUri.constData(), messageId.constData(), section.constData(),
+                        on_part_save_body_cb, on_part_save_complete_cb, ctx);
+                });
+                layout->addWidget(btn);
+            } else {
+                auto *btn = new QPushButton(label, attachmentsPane);
+                QByteArray data = m_entityBuffer;  // copy for lambda capture
+                QObject::connect(btn, &QPushButton::clicked, this, [this, label, data]() {
+                    QString path = QFileDialog::getSaveFileName(nullptr, QString(), label);
+                    if (!path.isEmpty()) {
+                        QFile f(path);
+                        bool ok = f.open(QIODevice::WriteOnly) && f.write(data) == data.size() && f.flush();
                         f.close();
+                        onPartSaved(path, ok ? 0 : -1);
                     }
-                }
-            });
-            layout->addWidget(btn);
+                });
+                layout->addWidget(btn);
+            }
             attachmentsPane->setVisible(true);
         }
     } else if (m_entityIsHtml) {
         // Inline HTML: sanitize and add to composite display
-        QString html = sanitizeHtml(QString::fromUtf8(m_entityBuffer));
+        QString html = sanitizeHtml(takeEntityText());
         if (!html.isEmpty()) {
             if (m_inMultipartAlternative && m_alternativeGroupStart >= 0) {
                 // Replace text/plain fallback with HTML within this alternative group
@@ -913,29 +1304,57 @@ void EventBridge::onEndEntity() {
             }
             m_inlineHtmlParts.append(html);
             m_messageBody = m_inlineHtmlParts.join(QString());
-            messageView->setHtml(m_messageBody);
+            renderMessageBody();
         }
     } else if (m_entityIsPlain && !m_entityIsAttachment) {
         // Inline text/plain: finalize into composite display
-        QString plainText = QString::fromUtf8(m_entityBuffer);
+        if (m_entityStreamingPlain) {
+            flushPendingPlainText();
+        }
+        QString plainText = takeEntityText();
         m_lastMessageBodyPlain.append(plainText);
         QString htmlFragment = QStringLiteral("<pre>") + plainText.toHtmlEscaped() + QStringLiteral("</pre>");
         m_inlineHtmlParts.append(htmlFragment);
         m_messageBody = m_inlineHtmlParts.join(QString());
-        messageView->setHtml(m_messageBody);
+        if (!m_entityStreamingPlain) {
+            // Streamed text is already on screen; re-laying out a large body would stall
+            renderMessageBody();
+        }
         setLastMessage(m_lastMessageFrom, m_lastMessageTo, m_lastMessageSubject, m_lastMessageBodyPlain);
     } else if (!m_entityContentId.isEmpty()) {
         // Non-text CID resource (image, etc.) — already registered above
         // Re-render to pick up the new resource in existing HTML
         if (!m_messageBody.isEmpty()) {
-            messageView->setHtml(m_messageBody);
+            renderMessageBody();
         }
     }
 
     m_entityBuffer.clear();
 }
 
+void EventBridge::renderMessageBody() {
+    {
+        TraceSpan span("message.set_html");
+        span.setValue(m_messageBody.size());
+        messageView->setHtml(m_messageBody);
+    }
+    {
+        // setHtml lays out lazily; asking for the document size finishes the layout now,
+        // at the viewport width, so the span covers layout and not event-loop latency
+        TraceSpan span("message.layout");
+        span.setValue(qRound(messageView->document()->size().height()));
+    }
+}
+
 void EventBridge::onMessageComplete(int error) {
+    if (m_messageMimeStartUs >= 0) {
+        Trace::record("message.mime", m_messageMimeStartUs);
+        m_messageMimeStartUs = -1;
+    }
+    if (m_messageLoadStartUs >= 0) {
+        Trace::record("message.load", m_messageLoadStartUs);
+        m_messageLoadStartUs = -1;
+    }
     if (win && error != 0) {
         showError(win, "error.context.load_message");
     }
@@ -966,6 +1385,24 @@ void EventBridge::onMessageComplete(int error) {
     }
 }
 
+void EventBridge::onDeferredPart(const QString &section, quint64 size) {
+    m_entityDeferredSection = section;
+    m_entityDeferredSize = size;
+}
+
+void EventBridge::onPartSaved(const QString &path, int error) {
+    if (error != 0) {
+        QFile::remove(path);
+    }
+    if (statusBar) {
+        if (error != 0) {
+            statusBar->showMessage(TR("status.attachment_save_error"));
+        } else {
+            statusBar->showMessage(TR("status.attachment_saved"), 3000);
+        }
+    }
+}
+
 // --- HTML sanitization ---
 
 QString EventBridge::sanitizeHtml(const QString &html) {
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QTreeWidget>
 #include <QTextBrowser>
+#include <QListView>
 #include <QStatusBar>
 #include <QProgressBar>
 #include <QWidget>
@@ -14,6 +15,15 @@
 #include <QSet>
 #include <QStringList>
 #include <QImage>
+#include <QStringDecoder>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QQueue>
+#include "ChatTimelineModel.h"
+#include "FolderListCache.h"
+#include "ProfileCache.h"
+#include "Trace.h"
 
 void showError(QWidget *parent, const char *context);
 
@@ -23,22 +33,46 @@ static const int MessageIdRole = Qt::UserRole;
 static const int FolderNameRole  = Qt::UserRole + 1;  // real protocol folder name (e.g. "INBOX/Subfolder")
 static const int FolderAttrsRole = Qt::UserRole + 2;  // space-separated attribute string
 static const int FolderDelimRole = Qt::UserRole + 3;  // delimiter character (QChar, null if none)
+static const int NewsgroupPathRole = Qt::UserRole + 4; // NNTP hierarchy node whose children are created on expand
 
 // Custom data role for message flags bitmask
 static const int MessageFlagsRole = Qt::UserRole + 10;
+// Folder a message row belongs to, when the list mixes folders (unified inbox); else unset
+static const int MessageFolderUriRole = Qt::UserRole + 11;
+// Date column sort key: seconds since the epoch (-1 if the message has no date)
+static const int MessageTimestampRole = Qt::UserRole + 12;
 
-struct ChatMessage {
-    QString content;
-    QString authorId;    // hex pubkey (Nostr) or user ID (Matrix)
-    qint64 timestampSecs;
+class NewsgroupBrowser;
+struct LiveSubscriptionContext;
+struct FolderListContext;
+
+/** Stateful decoder for a body that arrives in chunks, which can also end the stream:
+ *  input that stops inside a multibyte sequence yields a replacement character. */
+class StreamDecoder : public QStringDecoder {
+public:
+    StreamDecoder() = default;
+    StreamDecoder(QStringDecoder &&decoder) : QStringDecoder(std::move(decoder)) {}
+
+    /** End of input: U+FFFD if a sequence was left incomplete, else empty. Resets the state. */
+    QString finish() {
+        const bool incomplete = state.remainingChars > 0;
+        resetState();
+        return incomplete ? QString(QChar::ReplacementCharacter) : QString();
+    }
 };
 
 class EventBridge : public QObject {
     Q_OBJECT
 public:
-    QTreeWidget *folderTree = nullptr;
+    explicit EventBridge(QObject *parent = nullptr);
+    ~EventBridge() override;
+
+    QTreeWidget *folderTree = nullptr;        // set with setFolderTree
+    NewsgroupBrowser *newsgroups = nullptr;   // NNTP: holds the group list while active
     QTreeWidget *conversationList = nullptr;  // columns: From, Subject, Date (sortable; supports hierarchy for thread view later)
     QTextBrowser *messageView = nullptr;
+    QListView *chatView = nullptr;            // conversation mode: timeline, shown instead of messageView
+    ChatTimelineModel *chatModel = nullptr;   // rows of chatView
     QWidget *attachmentsPane = nullptr;  // optional; child widgets are attachment buttons, cleared/repopulated per message
     QStatusBar *statusBar = nullptr;
     QWidget *win = nullptr;
@@ -48,12 +82,29 @@ public:
     QLabel *headerToLabel = nullptr;
     QLabel *headerSubjectLabel = nullptr;
 
+    /** Use tree for the folder list and keep the folder name index in step with its rows. */
+    void setFolderTree(QTreeWidget *tree);
+    /** Find a tree item by its real folder name (FolderNameRole). */
+    QTreeWidgetItem *findFolderItem(const QString &realName) const { return m_folderItems.value(realName); }
+    /** Number of folders in the tree. */
+    int folderCount() const { return static_cast<int>(m_folderItems.size()); }
+    /** Fill the (cleared) folder tree from storeUri's cached folder list. The listing that
+     *  follows updates the tree in place and replaces the cached list when it completes. */
+    void showCachedFolders(const QByteArray &storeUri);
+    /** user_data for storeUri's folder list callbacks (created on first use, owned by the bridge). */
+    FolderListContext *folderListContext(const QByteArray &storeUri);
+    /** Start listing storeUri's folders (tagliacarte_store_refresh_folders), counted so that
+     *  only the last of overlapping listings reconciles the tree. */
+    void refreshFolders(const QByteArray &storeUri);
+
     QByteArray folderUri() const { return m_folderUri; }
     void setFolderUri(const QByteArray &uri);
     /** Pointer to the CID resource registry for CidTextBrowser to look up cid: URLs. */
     const QMap<QString, QByteArray> *cidRegistryPtr() const { return &m_cidRegistry; }
     void clearFolder();
-    void setFolderNameOpening(const QString &name) { m_folderNameOpening = name; }
+    /** Message id being loaded (for on-demand fetch of deferred attachment parts). */
+    void setMessageIdLoading(const QByteArray &id) { m_messageIdLoading = id; m_messageLoadStartUs = Trace::now(); }
+    void setFolderNameOpening(const QString &name) { m_folderNameOpening = name; m_folderOpenStartUs = Trace::now(); }
     /** Last displayed message (for Reply/Forward). Cleared when selection changes. */
     QString lastMessageFrom() const { return m_lastMessageFrom; }
     QString lastMessageTo() const { return m_lastMessageTo; }
@@ -75,6 +126,9 @@ public:
     /** Secret key (hex) for NIP-42 relay auth during profile fetches. */
     void setNostrSecretKey(const QString &hex) { m_nostrSecretKey = hex; }
 
+    /** How long a cached profile is used before it is fetched again (Config::profileCacheTtlHours). */
+    void setProfileCacheTtl(int hours);
+
     /** Set / get the self user's pubkey (hex) for the current Nostr store. */
     void setSelfPubkey(const QString &hex) { m_selfPubkey = hex.toLower(); }
     QString selfPubkey() const { return m_selfPubkey; }
@@ -87,11 +141,35 @@ public:
     /** Check if a folder is a system folder that should not be deleted. */
     static bool isSystemFolder(const QString &realName, const QString &attributes);
 
+    /** A message list row, styled by flags (bold when unread, struck out when deleted).
+     *  The date column sorts by timestampSecs, not by its formatted text. */
+    static QTreeWidgetItem *newMessageItem(const QString &id, const QString &subject, const QString &from,
+                                           const QString &dateFormatted, qint64 timestampSecs, quint32 flags);
+    /** Folder to act on for a message row: its own (unified inbox) or the open folder. */
+    QByteArray folderUriForItem(const QTreeWidgetItem *item) const;
+
+    /** Conversation mode: load the newest page of the conversation; older pages follow on scroll-up. */
+    void requestChatHistory();
+    /** Conversation mode: receive messages arriving in the open folder (onMessageAdded/Updated). */
+    void subscribeChat();
+    /** Conversation mode: show text at once as a local echo and send it after any earlier
+     *  messages to the same recipient; the echo moves to sent or failed as the send completes. */
+    void queueChatMessage(const QByteArray &transportUri, const QString &to, const QString &text);
+    /** Backend thread: a folder from a listing. Folders are handed to the main thread in
+     *  batches (addQueuedFolders), not one queued call each: a news server lists many groups. */
+    void queueFolderFound(const QString &storeUri, const QString &name, const QString &delimiter, const QString &attributes);
+
 public Q_SLOTS:
     void startMessageLoading(quint64 total);
     void addFolder(const QString &name, const QString &delimiter, const QString &attributes);
+    /** Add the folders queued by queueFolderFound. */
+    void addQueuedFolders();
     void removeFolder(const QString &name);
-    void onFolderListComplete(int error, const QString &errorMessage);
+    /** A folder removed from storeUri; ignored unless the tree shows that store. */
+    void onFolderRemoved(const QString &storeUri, const QString &name);
+    void onFolderListComplete(const QString &storeUri, int error, const QString &errorMessage);
+    /** Folder counts from status polling (any store); shown if the tree shows that store. */
+    void onFolderStatus(const QString &storeUri, const QString &name, quint64 total, quint64 unread);
     /** Called from C credential callback (marshal to main thread). Emits credentialRequested. */
     void requestCredentialSlot(const QString &storeUri, const QString &username, int isPlaintext, int authType);
     void onFolderReady(const QString &folderUri);
@@ -99,6 +177,11 @@ public Q_SLOTS:
     void showOpeningMessageCount(quint32 count);
     void addMessageSummary(const QString &id, const QString &subject, const QString &from, const QString &dateFormatted, qint64 timestampSecs, quint64 size, quint32 flags = 0);
     void onMessageListComplete(int error);
+    void onConversationHistoryComplete(int error, int more);
+    void onMessageAdded(const QString &folderUri, const QString &id, const QString &subject, const QString &from, qint64 timestampSecs);
+    void onMessageUpdated(const QString &folderUri, const QString &id, const QString &subject, const QString &from, qint64 timestampSecs);
+    /** Load the next older page of the conversation, if any and none is in flight. */
+    void requestOlderChatMessages();
     void onBulkComplete(int ok, const QString &errorMessage);
     void showMessageMetadata(const QString &subject, const QString &from, const QString &to, const QString &date);
     void onStartEntity();
@@ -109,13 +192,21 @@ public Q_SLOTS:
     void onBodyContent(const QByteArray &data);
     void onEndEntity();
     void onMessageComplete(int error);
+    /** Current entity's body was left on the server; section is passed to tagliacarte_folder_request_message_part. */
+    void onDeferredPart(const QString &section, quint64 size);
+    /** A deferred part finished saving to path (error != 0: failed). */
+    void onPartSaved(const QString &path, int error);
     void onSendProgress(const QString &status);
     void onSendComplete(int ok);
+    void onChatSendComplete(const QString &conversation, int ok);
     void onFolderOpError(const QString &message);
     /** Update a folder tree item's display text after an async profile fetch. */
     void updateFolderDisplayName(const QString &realName, const QString &displayName);
     /** Update a folder tree item's icon after an avatar has been downloaded. */
-    void updateFolderAvatar(const QString &realName, const QString &filePath);
+    void updateFolderAvatar(const QString &realName);
+    /** A profile from a batch fetch (tagliacarte_nostr_fetch_profiles); empty fields are absent. */
+    void onNostrProfile(const QString &pubkey, const QString &displayName, const QString &nip05, const QString &pictureUrl);
+    void onNostrProfilesComplete(const QStringList &pubkeys, int error);
 
 Q_SIGNALS:
     void folderReadyForMessages(quint64 total);
@@ -125,12 +216,23 @@ Q_SIGNALS:
     void credentialRequested(const QString &storeUri, const QString &username, int isPlaintext, int authType);
     /** OAuth flow completed. provider: "google" or "microsoft". error: 0 = success, non-zero = failure. */
     void oauthComplete(const QString &provider, int error, const QString &errorMessage);
+    /** A folder listing completed; the folder tree now holds every folder of the store. */
+    void folderListLoaded();
+    /** The open folder's message list has loaded (message list mode only). */
+    void messageListLoaded();
 
 private:
     QByteArray m_folderUri;
+    QByteArray m_messageIdLoading;
     QString m_folderNameOpening;
     quint64 m_messageLoadTotal = 0;
     quint64 m_messageLoadCount = 0;
+    // Trace clock start of the stages in flight (see Trace); -1 when not traced
+    qint64 m_folderListStartUs = -1;
+    qint64 m_folderOpenStartUs = -1;
+    qint64 m_messageListStartUs = -1;
+    qint64 m_messageLoadStartUs = -1;
+    qint64 m_messageMimeStartUs = -1;
     QProgressBar *m_loadProgressBar = nullptr;
     char *m_pendingSendTransportUri = nullptr;
     QString m_lastMessageFrom;
@@ -143,19 +245,53 @@ private:
     QString m_nostrRelaysCsv;
     QString m_nostrSecretKey;                      // hex secret key for NIP-42 auth
     QString m_selfPubkey;                          // hex pubkey of the current Nostr user
+    QHash<QString, QTreeWidgetItem *> m_folderItems;  // real folder name -> folderTree item
+    FolderListCache m_folderListCache;             // folder lists persisted across restarts
+    QString m_folderListStoreUri;                  // store whose folders the tree shows
+    QVector<CachedFolder> m_listedFolders;         // reported since the last listing completed
+    struct FolderCounts {
+        quint64 total = 0;
+        quint64 unread = 0;
+    };
+    QHash<QString, QHash<QString, FolderCounts>> m_folderCounts;  // store URI -> folder name -> latest counts
+    QSet<QString> m_listedNames;                   // names in m_listedFolders
+    QMutex m_foundFoldersMutex;
+    QVector<QPair<QString, CachedFolder>> m_foundFolders;  // (store URI, folder): queueFolderFound -> addQueuedFolders; guarded by the mutex
+    QHash<QByteArray, FolderListContext *> m_folderListContexts;  // store URI -> folder list user_data
     QMap<QString, QString> m_nostrNameCache;       // hex pubkey -> resolved display name
-    QMap<QString, QString> m_nostrPictureCache;    // hex pubkey -> local file path for avatar
     QSet<QString> m_profileFetchPending;           // pubkeys currently being fetched
-    QList<ChatMessage> m_chatMessages;             // accumulated for conversation rendering
+    QStringList m_profileFetchQueue;               // pubkeys for the next batch fetch
+    bool m_profileFetchScheduled = false;
+    ProfileCache m_profileCache;                   // profiles persisted across restarts
+    qint64 m_profileCacheTtlSecs = 24 * 3600;
+    bool m_profileCacheSaveScheduled = false;
+    QVector<ChatMessage> m_pendingChatMessages;    // received, not yet appended to chatModel
+    bool m_chatAppendScheduled = false;
+    static constexpr quint64 ChatPageSize = 100;    // messages per conversation history page
+    bool m_chatHistoryLoading = false;             // a history page request is in flight
+    bool m_chatHistoryMore = false;                // older messages may remain on the server
+    quint64 m_chatHistoryLoaded = 0;               // messages received through history pages
+    QVector<ChatMessage> m_chatHistoryPage;        // page being received, in delivery order
+    QSet<QString> m_chatHistoryIds;                // ids already in chatModel (history pages and live)
+    struct ChatSend {
+        QString localId;                           // id of the local echo in chatModel
+        QByteArray transportUri;
+        QByteArray from;
+        QByteArray to;
+        QByteArray body;
+    };
+    QHash<QString, QQueue<ChatSend>> m_chatSendQueues;  // recipient -> sends; the head is in flight
+    QHash<QByteArray, LiveSubscriptionContext *> m_liveSubscriptions;  // folder URI -> subscribe user_data
+    quint64 m_chatSendSerial = 0;
+    void startChatSend(const QString &conversation);
 
     /** Get cached display name for an author ID, or a short fallback. */
     QString authorDisplayName(const QString &authorId) const;
-    /** Get cached avatar file path for an author ID, or empty. */
-    QString authorAvatarPath(const QString &authorId) const;
-    /** Generate a deterministic hue (0-360) from a string for placeholder avatar colors. */
-    static int avatarHue(const QString &id);
-    /** Format a timestamp for the conversation view (smart: today/this week/older). */
-    static QString formatChatTimestamp(qint64 secs);
+    /** npub for a lower-case hex pubkey, encoded once and memoized. */
+    QString npubFor(const QString &lowerHex) const;
+    mutable QHash<QString, QString> m_npubCache;   // hex pubkey -> npub
+    /** The author's avatar for the chat timeline at chatView's device pixel ratio, or null. */
+    QPixmap chatAvatar(const QString &authorId) const;
 
     // Per-entity state for streaming MIME events
     QString m_entityContentType;         // content-type of current entity
@@ -167,6 +303,15 @@ private:
     bool    m_entityIsHtml = false;       // true for text/html
     bool    m_entityIsPlain = false;      // true for text/plain
     QByteArray m_entityBuffer;           // accumulated body for HTML/attachments
+    QString m_entityDeferredSection;     // non-empty if the body was deferred (fetch on save)
+    quint64 m_entityDeferredSize = 0;    // approximate decoded size of a deferred body
+    QString m_entityCharset;             // charset parameter of current entity (empty = UTF-8)
+    bool    m_entityStreamingPlain = false; // text/plain displayed progressively as it arrives
+    bool    m_entityDecodesText = false; // inline text: decoded as it arrives, bytes not kept
+    StreamDecoder m_entityDecoder;       // stateful: keeps multibyte sequences split across chunks
+    QString m_entityText;                // decoded text of an inline text entity
+    QString m_pendingPlainText;          // decoded but not yet inserted into the view
+    bool    m_plainTextFlushScheduled = false;
 
     // Per-message state (cleared in showMessageMetadata)
     QMap<QString, QByteArray> m_cidRegistry;  // Content-ID -> raw bytes (for cid: resolution)
@@ -177,16 +322,40 @@ private:
     bool m_inMultipartAlternative = false;
 
     static QString sanitizeHtml(const QString &html);
+    /** Decoder for the current entity's charset (UTF-8 if absent or unsupported). */
+    QStringDecoder entityDecoder() const;
+    /** End of an entity decoded as it arrived: flush the decoder into m_entityText (and the view). */
+    void finishEntityText();
+    /** The current entity's body as text: decoded as it arrived, or from m_entityBuffer. */
+    QString takeEntityText();
+    /** Append pending streamed text to the view; scheduled at most once per frame. */
+    void flushPendingPlainText();
+    /** Show m_messageBody in messageView, tracing setHtml and the layout that follows. */
+    void renderMessageBody();
 
-    /** Find a tree item by its real folder name (FolderNameRole). */
-    QTreeWidgetItem *findFolderItem(const QString &realName) const;
-    /** Recursively count all items in the tree. */
-    static int countAllItems(QTreeWidget *tree);
+    /** Add rows inserted into the folder tree, and their descendants, to m_folderItems. */
+    void indexFolderRows(const QModelIndex &parent, int first, int last);
+    /** Drop rows about to leave the folder tree, and their descendants, from m_folderItems. */
+    void forgetFolderRows(const QModelIndex &parent, int first, int last);
+    /** Add a folder, and any missing ancestors, to the tree or update its attributes. */
+    void insertFolder(const QString &name, const QString &delimiter, const QString &attributes);
+    /** Show counts in the item's second column; folders with unread messages are bold. */
+    static void applyFolderCounts(QTreeWidgetItem *item, const FolderCounts &counts);
+    /** After a complete listing: drop folders it did not report, deepest first. */
+    void removeUnlistedFolders();
 
     static bool isHexPubkey(const QString &s);
+    /** Queue a profile fetch; queued pubkeys are fetched together, at most one batch per frame. */
     void fetchNostrProfile(const QString &hexPubkey);
+    void flushProfileFetches();
+    void scheduleProfileCacheSave();
     void ensureProfilesFetched();
-    void renderChatMessages();
-};
+    /** Append pending messages to chatModel; scheduled at most once per frame while loading. */
+    void appendChatMessages();
+    void scheduleChatAppend();
+    /** Give chatModel the cached name and avatar of authors it has not seen yet. */
+    void registerChatAuthors(const QVector<ChatMessage> &messages);
+    void resetChatHistory();
+    void removeLoadProgressBar();
 
 #endif // EVENTBRIDGE_H
@@ -0,0 +1,118 @@
+/*
+ * FolderListCache.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FolderListCache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <cstdio>
+
+static bool sameFolders(const QVector<CachedFolder> &a, const QVector<CachedFolder> &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i].name != b[i].name || a[i].delimiter != b[i].delimiter || a[i].attributes != b[i].attributes) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString FolderListCache::path() {
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QDir().mkpath(dir);
+    return dir + QStringLiteral("/folders.xml");
+}
+
+FolderListCache::FolderListCache() {
+    QFile f(path());
+    if (!f.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QXmlStreamReader r(&f);
+    QVector<CachedFolder> *current = nullptr;
+    while (!r.atEnd()) {
+        r.readNext();
+        if (!r.isStartElement()) {
+            continue;
+        }
+        const QXmlStreamAttributes a = r.attributes();
+        if (r.name() == QLatin1String("store")) {
+            QString uri = a.value(QLatin1String("uri")).toString();
+            current = uri.isEmpty() ? nullptr : &m_stores[uri];
+        } else if (r.name() == QLatin1String("folder") && current) {
+            CachedFolder folder;
+            folder.name = a.value(QLatin1String("name")).toString();
+            folder.delimiter = a.value(QLatin1String("delimiter")).toString();
+            folder.attributes = a.value(QLatin1String("attributes")).toString();
+            if (!folder.name.isEmpty()) {
+                current->append(folder);
+            }
+        }
+    }
+    if (r.hasError()) {
+        fprintf(stderr, "[folders] %s: %s\n", path().toUtf8().constData(), r.errorString().toUtf8().constData());
+    }
+}
+
+void FolderListCache::setFolders(const QString &storeUri, const QVector<CachedFolder> &folders) {
+    auto it = m_stores.find(storeUri);
+    if (it != m_stores.end() && sameFolders(*it, folders)) {
+        return;
+    }
+    m_stores.insert(storeUri, folders);
+    m_dirty = true;
+}
+
+void FolderListCache::save() {
+    if (!m_dirty) {
+        return;
+    }
+    QSaveFile f(path());
+    if (!f.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QXmlStreamWriter w(&f);
+    w.setAutoFormatting(true);
+    w.writeStartDocument(QStringLiteral("1.0"), true);
+    w.writeStartElement(QStringLiteral("folders"));
+    for (auto it = m_stores.constBegin(); it != m_stores.constEnd(); ++it) {
+        w.writeStartElement(QStringLiteral("store"));
+        w.writeAttribute(QStringLiteral("uri"), it.key());
+        for (const CachedFolder &folder : it.value()) {
+            w.writeStartElement(QStringLiteral("folder"));
+            w.writeAttribute(QStringLiteral("name"), folder.name);
+            if (!folder.delimiter.isEmpty()) w.writeAttribute(QStringLiteral("delimiter"), folder.delimiter);
+            if (!folder.attributes.isEmpty()) w.writeAttribute(QStringLiteral("attributes"), folder.attributes);
+            w.writeEndElement();
+        }
+        w.writeEndElement();
+    }
+    w.writeEndElement();
+    w.writeEndDocument();
+    if (f.commit()) {
+        m_dirty = false;
+    }
+}
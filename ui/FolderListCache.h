@@ -0,0 +1,59 @@
+/*
+ * FolderListCache.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FOLDERLISTCACHE_H
+#define FOLDERLISTCACHE_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+/** A folder as reported by the store's folder listing. */
+struct CachedFolder {
+    QString name;
+    QString delimiter;
+    QString attributes;
+};
+
+/**
+ * Each store's last complete folder listing, kept across restarts so the folder tree can be
+ * shown as soon as a store is selected. Stored in folders.xml in the cache directory, keyed
+ * by store URI; folders are kept in listing order.
+ */
+class FolderListCache {
+public:
+    /** Load the cache file (missing or unreadable: start empty). */
+    FolderListCache();
+
+    QVector<CachedFolder> folders(const QString &storeUri) const { return m_stores.value(storeUri); }
+    /** Replace the listing for storeUri. */
+    void setFolders(const QString &storeUri, const QVector<CachedFolder> &folders);
+
+    /** Write the cache file if anything changed since it was loaded or last saved. */
+    void save();
+
+private:
+    static QString path();
+
+    QHash<QString, QVector<CachedFolder>> m_stores;
+    bool m_dirty = false;
+};
+
+#endif // FOLDERLISTCACHE_H
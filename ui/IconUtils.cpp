@@ -107,12 +107,16 @@ QIcon iconFromSvgResource(const QString &path, const QColor &color, int size, qr
 }
 
 QPixmap circularAvatar(const QPixmap &src, int size) {
-    QPixmap scaled = src.scaled(size, size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+    return QPixmap::fromImage(circularAvatarImage(src.toImage(), size));
+}
+
+QImage circularAvatarImage(const QImage &src, int size) {
+    QImage scaled = src.scaled(size, size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
     if (scaled.width() != scaled.height()) {
         int sz = qMin(scaled.width(), scaled.height());
         scaled = scaled.copy((scaled.width() - sz) / 2, (scaled.height() - sz) / 2, sz, sz);
     }
-    QPixmap rounded(size, size);
+    QImage rounded(size, size, QImage::Format_ARGB32_Premultiplied);
     rounded.fill(Qt::transparent);
     QPainter p(&rounded);
     p.setRenderHint(QPainter::Antialiasing);
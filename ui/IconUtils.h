@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QIcon>
+#include <QImage>
 #include <QPixmap>
 #include <QColor>
 
@@ -25,6 +26,8 @@ QIcon iconFromSvgResource(const QString &path, const QColor &color, int size = 2
 
 // Crop and scale a pixmap into a circular avatar at the given size.
 QPixmap circularAvatar(const QPixmap &src, int size);
+// As circularAvatar, on a QImage (safe outside the GUI thread).
+QImage circularAvatarImage(const QImage &src, int size);
 
 // Generate a circular pixmap with a colored background and a centered letter.
 QPixmap letterAvatar(QChar letter, const QColor &bg, int size);
@@ -6,6 +6,9 @@
 #include "CidTextBrowser.h"
 #include "ComposeDialog.h"
 #include "EmojiPicker.h"
+#include "NewsgroupBrowser.h"
+#include "UnifiedInbox.h"
+#include "Trace.h"
 #include "Tr.h"
 #include "tagliacarte.h"
 
@@ -26,6 +29,15 @@
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QTextCursor>
+#include <QApplication>
+#include <QPointer>
+#include <QScrollBar>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <cstdio>
+
+// Gap before and between background warm-ups, so they trail the selected store's own traffic
+static const int WARM_UP_INTERVAL_MS = 2000;
 
 MainController::MainController(QObject *parent)
     : QObject(parent)
@@ -61,7 +73,8 @@ void MainController::updateComposeAppendButtons()
 
 void MainController::updateMessageActionButtons()
 {
-    bool hasMessage = !bridge->folderUri().isEmpty() && conversationList->currentItem() != nullptr;
+    auto *current = conversationList->currentItem();
+    bool hasMessage = current != nullptr && !bridge->folderUriForItem(current).isEmpty();
     bool hasTransport = !smtpTransportUri.isEmpty();
     replyBtn->setEnabled(hasMessage && hasTransport);
     replyAllBtn->setEnabled(hasMessage && hasTransport);
@@ -103,9 +116,10 @@ void MainController::addStoreCircle(const QString &initial, const QByteArray &ur
     }
 }
 
-QByteArray MainController::createStoreFromEntry(const StoreEntry &entry)
+MainController::CreatedStore MainController::createStoreFromEntry(const StoreEntry &entry)
 {
     QByteArray uri;
+    QByteArray transportUri;
     if (entry.type == QLatin1String("maildir") && !storeHostOrPath(entry).isEmpty()) {
         char *uriPtr = tagliacarte_store_maildir_new(storeHostOrPath(entry).toUtf8().constData());
         if (!uriPtr) {
@@ -134,7 +148,7 @@ QByteArray MainController::createStoreFromEntry(const StoreEntry &entry)
                 param(entry, "transportHostname").toUtf8().constData(),
                 static_cast<uint16_t>(qBound(1, paramInt(entry, "transportPort", 586), 65535)));
             if (tUri) {
-                storeToTransport[uri] = QByteArray(tUri);
+                transportUri = QByteArray(tUri);
                 tagliacarte_free_string(tUri);
             }
         }
@@ -147,7 +161,8 @@ QByteArray MainController::createStoreFromEntry(const StoreEntry &entry)
         if (!userAtHost.contains(QLatin1Char('@'))) {
             userAtHost = userAtHost + QLatin1Char('@') + host;
         }
-        char *uriPtr = tagliacarte_store_pop3_new(userAtHost.toUtf8().constData(), host.toUtf8().constData(), 995);
+        const uint16_t pop3Port = static_cast<uint16_t>(qBound(1, paramInt(entry, "port", 995), 65535));
+        char *uriPtr = tagliacarte_store_pop3_new(userAtHost.toUtf8().constData(), host.toUtf8().constData(), pop3Port);
         if (!uriPtr) {
             return {};
         }
@@ -158,7 +173,7 @@ QByteArray MainController::createStoreFromEntry(const StoreEntry &entry)
                 param(entry, "transportHostname").toUtf8().constData(),
                 static_cast<uint16_t>(qBound(1, paramInt(entry, "transportPort", 586), 65535)));
             if (tUri) {
-                storeToTransport[uri] = QByteArray(tUri);
+                transportUri = QByteArray(tUri);
                 tagliacarte_free_string(tUri);
             }
         }
@@ -173,7 +188,7 @@ QByteArray MainController::createStoreFromEntry(const StoreEntry &entry)
         tagliacarte_free_string(uriPtr);
         char *tUri = tagliacarte_transport_nostr_new(relaysUtf8.constData(), pubkeyUtf8.constData());
         if (tUri) {
-            storeToTransport[uri] = QByteArray(tUri);
+            transportUri = QByteArray(tUri);
             tagliacarte_free_string(tUri);
         }
     } else if (entry.type == QLatin1String("gmail") && !entry.emailAddress.isEmpty()) {
@@ -185,7 +200,7 @@ QByteArray MainController::createStoreFromEntry(const StoreEntry &entry)
         tagliacarte_free_string(uriPtr);
         char *tUri = tagliacarte_transport_gmail_smtp_new(entry.emailAddress.toUtf8().constData());
         if (tUri) {
-            storeToTransport[uri] = QByteArray(tUri);
+            transportUri = QByteArray(tUri);
             tagliacarte_free_string(tUri);
         }
     } else if (entry.type == QLatin1String("exchange") && !entry.emailAddress.isEmpty()) {
@@ -197,7 +212,7 @@ QByteArray MainController::createStoreFromEntry(const StoreEntry &entry)
         tagliacarte_free_string(uriPtr);
         char *tUri = tagliacarte_transport_graph_new(entry.emailAddress.toUtf8().constData());
         if (tUri) {
-            storeToTransport[uri] = QByteArray(tUri);
+            transportUri = QByteArray(tUri);
             tagliacarte_free_string(tUri);
         }
     } else if (entry.type == QLatin1String("matrix") && !storeHostOrPath(entry).isEmpty() && !param(entry, "userId").isEmpty()) {
@@ -214,7 +229,7 @@ QByteArray MainController::createStoreFromEntry(const StoreEntry &entry)
             storeHostOrPath(entry).toUtf8().constData(),
             param(entry, "userId").toUtf8().constData(), token);
         if (tUri) {
-            storeToTransport[uri] = QByteArray(tUri);
+            transportUri = QByteArray(tUri);
             tagliacarte_free_string(tUri);
         }
     } else if (entry.type == QLatin1String("nntp") && !storeHostOrPath(entry).isEmpty()) {
@@ -234,92 +249,347 @@ QByteArray MainController::createStoreFromEntry(const StoreEntry &entry)
         // Transport uses same server
         char *tUri = tagliacarte_transport_nntp_new(userAtHost.toUtf8().constData(), host.toUtf8().constData(), port);
         if (tUri) {
-            storeToTransport[uri] = QByteArray(tUri);
+            transportUri = QByteArray(tUri);
             tagliacarte_free_string(tUri);
         }
     }
-    return uri;
+    return { uri, transportUri };
 }
 
-void MainController::refreshStoresFromConfig()
+void MainController::startStatusPolling(const QByteArray &uri, const StoreEntry &entry)
 {
-    // Tear down existing stores
-    for (const QByteArray &u : allStoreUris) {
-        tagliacarte_store_free(u.constData());
+    // Counts come from IMAP STATUS or Maildir directories; other stores have none
+    if (entry.type != QLatin1String("imap") && entry.type != QLatin1String("gmail")
+        && entry.type != QLatin1String("maildir")) {
+        return;
     }
-    for (const QByteArray &t : storeToTransport) {
-        tagliacarte_transport_free(t.constData());
+    int seconds = qMax(0, paramInt(entry, "imapPollSeconds", 300));
+    tagliacarte_store_start_status_polling(uri.constData(), static_cast<uint32_t>(seconds),
+        on_folder_status_cb, bridge);
+}
+
+/** Letter shown in a store's circle: the display name's initial, else one for the type. */
+static QString storeInitial(const StoreEntry &entry)
+{
+    QString initial = entry.displayName.left(1).toUpper();
+    if (!initial.isEmpty()) {
+        return initial;
     }
-    allStoreUris.clear();
-    storeToTransport.clear();
+    if (entry.type == QLatin1String("maildir")) {
+        return QStringLiteral("M");
+    } else if (entry.type == QLatin1String("imap")) {
+        return QStringLiteral("I");
+    } else if (entry.type == QLatin1String("pop3")) {
+        return QStringLiteral("P");
+    } else if (entry.type == QLatin1String("nostr")) {
+        return QStringLiteral("N");
+    } else if (entry.type == QLatin1String("matrix")) {
+        return QStringLiteral("X");
+    } else if (entry.type == QLatin1String("nntp")) {
+        return QStringLiteral("U");
+    } else if (entry.type == QLatin1String("gmail")) {
+        return QStringLiteral("G");
+    } else if (entry.type == QLatin1String("exchange")) {
+        return QStringLiteral("E");
+    }
+    return QStringLiteral("?");
+}
+
+/** True if a live store made from a can stand for b.  Display name and picture only affect
+ *  the circle; the email address is the From address (for Gmail and Exchange it is part of
+ *  the id, so a change there is a new store anyway); the poll interval is applied in place; NNTP read state and subscriptions are
+ *  written back by the running store itself; the IMAP deletion, trash and idle settings are
+ *  not given to the store. */
+static bool sameStore(const StoreEntry &a, const StoreEntry &b)
+{
+    if (a.type != b.type) {
+        return false;
+    }
+    QMap<QString, QString> pa = a.params;
+    QMap<QString, QString> pb = b.params;
+    for (const char *key : { "imapPollSeconds", "readArticles", "subscribedGroups",
+                             "imapDeletion", "imapTrashFolder", "imapIdleSeconds" }) {
+        pa.remove(QLatin1String(key));
+        pb.remove(QLatin1String(key));
+    }
+    return pa == pb;
+}
+
+QToolButton *MainController::storeButtonForId(const QString &id) const
+{
     for (QToolButton *b : storeButtons) {
-        b->deleteLater();
+        if (b->property("storeId").toString() == id) {
+            return b;
+        }
     }
-    storeButtons.clear();
-    bridge->clearFolder();
-    folderTree->clear();
-    conversationList->clear();
-    messageView->clear();
-    messageHeaderPane->hide();
+    return nullptr;
+}
+
+void MainController::startCreatingStore(const StoreEntry &entry, int colourIndex)
+{
+    addStoreCircle(storeInitial(entry), QByteArray(), colourIndex);
+    QToolButton *placeholder = storeButtons.last();
+    placeholder->setProperty("storeId", entry.id);
+    placeholder->setChecked(false);
+    placeholder->setEnabled(false);
+    const quint64 token = ++m_storeCreationCounter;
+    m_pendingStores[entry.id] = token;
+    m_storeEntries[entry.id] = entry;
+    // A store's URI follows from its entry, so an earlier creation for this id still in
+    // flight registers under the same URI: this one starts once that result is freed
+    if (!m_creatingStores.contains(entry.id)) {
+        runStoreCreation(token, entry);
+    }
+}
+
+void MainController::runStoreCreation(quint64 token, const StoreEntry &entry)
+{
+    m_creatingStores.insert(entry.id);
+    QPointer<MainController> self(this);
+    (void)QtConcurrent::run([self, token, entry]() {
+        const qint64 start = Trace::now();
+        CreatedStore created = createStoreFromEntry(entry);
+        Trace::record("store.create", start);
+        QMetaObject::invokeMethod(qApp, [self, token, entry, created]() {
+            if (self) {
+                self->onStoreCreated(token, entry, created);
+            } else {
+                tagliacarte_store_free(created.uri.constData());
+                tagliacarte_transport_free(created.transportUri.constData());
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainController::removeStore(const QString &id)
+{
+    // A store still being created is freed by onStoreCreated when it arrives
+    m_pendingStores.remove(id);
+    m_storeEntries.remove(id);
+    QByteArray uri;
+    if (QToolButton *btn = storeButtonForId(id)) {
+        uri = btn->property("storeUri").toByteArray();
+        storeButtons.removeOne(btn);
+        btn->deleteLater();
+    }
+    if (uri.isEmpty()) {
+        return;
+    }
+    if (storeToTransport.contains(uri)) {
+        tagliacarte_transport_free(storeToTransport.take(uri).constData());
+    }
+    allStoreUris.removeAll(uri);
+    if (unifiedInbox) {
+        unifiedInbox->removeStore(uri);
+    }
+    tagliacarte_store_free(uri.constData());
+    if (storeUri == uri) {
+        bridge->clearFolder();
+        folderTree->clear();
+        conversationList->clear();
+        messageView->clear();
+        messageHeaderPane->hide();
+        storeUri.clear();
+        smtpTransportUri.clear();
+    }
+}
 
-    // Re-create from config
+void MainController::refreshStoresFromConfig()
+{
     Config c = loadConfig();
+    m_warmUpStores = c.warmUpStores;
+    QHash<QString, StoreEntry> configured;
+    for (const StoreEntry &entry : c.stores) {
+        configured.insert(entry.id, entry);
+    }
+
+    // Circles made outside this function have no id; adopt them under their URI, which is
+    // their config id
+    for (QToolButton *b : storeButtons) {
+        if (b->property("storeId").toString().isEmpty()) {
+            b->setProperty("storeId", QString::fromUtf8(b->property("storeUri").toByteArray()));
+        }
+    }
+
+    // Drop stores whose entry is gone, or changed in a way only a new store can pick up
+    QStringList current;
+    for (QToolButton *b : storeButtons) {
+        current.append(b->property("storeId").toString());
+    }
+    for (auto it = m_storeEntries.begin(); it != m_storeEntries.end(); ) {
+        if (current.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_storeEntries.erase(it);
+        }
+    }
+    for (const QString &id : current) {
+        auto next = configured.constFind(id);
+        auto known = m_storeEntries.constFind(id);
+        if (next == configured.constEnd()) {
+            m_pendingCredentials.remove(id);
+            removeStore(id);
+        } else if (known != m_storeEntries.constEnd() && !sameStore(*known, *next)) {
+            removeStore(id);
+        }
+    }
+
+    // Reconfigure what is left in place and create what is new
     for (int i = 0; i < c.stores.size(); ++i) {
         const StoreEntry &entry = c.stores[i];
-        QByteArray uri = createStoreFromEntry(entry);
-        if (uri.isEmpty()) {
+        QToolButton *btn = storeButtonForId(entry.id);
+        if (!btn) {
+            startCreatingStore(entry, i);
             continue;
         }
-        allStoreUris.append(uri);
-        QString initial = entry.displayName.left(1).toUpper();
-        if (initial.isEmpty()) {
-            if (entry.type == QLatin1String("maildir")) {
-                initial = QStringLiteral("M");
-            } else if (entry.type == QLatin1String("imap")) {
-                initial = QStringLiteral("I");
-            } else if (entry.type == QLatin1String("pop3")) {
-                initial = QStringLiteral("P");
-            } else if (entry.type == QLatin1String("nostr")) {
-                initial = QStringLiteral("N");
-            } else if (entry.type == QLatin1String("matrix")) {
-                initial = QStringLiteral("X");
-            } else if (entry.type == QLatin1String("nntp")) {
-                initial = QStringLiteral("U");
-            } else if (entry.type == QLatin1String("gmail")) {
-                initial = QStringLiteral("G");
-            } else if (entry.type == QLatin1String("exchange")) {
-                initial = QStringLiteral("E");
-            } else {
-                initial = QStringLiteral("?");
-            }
+        btn->setText(storeInitial(entry));
+        btn->setToolTip(storeInitial(entry));
+        btn->setProperty("colourIndex", i);
+        btn->setStyleSheet(storeCircleStyleSheet(i));
+        QByteArray uri = btn->property("storeUri").toByteArray();
+        auto known = m_storeEntries.constFind(entry.id);
+        if (!uri.isEmpty() && known != m_storeEntries.constEnd()
+            && param(*known, "imapPollSeconds") != param(entry, "imapPollSeconds")) {
+            startStatusPolling(uri, entry);
+        }
+        m_storeEntries[entry.id] = entry;
+    }
+
+    // Leave the selection alone unless its store went away
+    if (!storeUri.isEmpty() || (unifiedInbox && unifiedInbox->isActive())) {
+        return;
+    }
+    m_initialStoreId.clear();
+    m_selectFirstReadyStore = false;
+    QString target = configured.contains(c.lastSelectedStoreId) ? c.lastSelectedStoreId
+        : (c.stores.isEmpty() ? QString() : c.stores.first().id);
+    if (target.isEmpty()) {
+        return;
+    }
+    QToolButton *btn = storeButtonForId(target);
+    QByteArray uri = btn ? btn->property("storeUri").toByteArray() : QByteArray();
+    if (!uri.isEmpty()) {
+        selectStore(uri);
+    } else if (m_pendingStores.contains(target)) {
+        m_initialStoreId = target;
+    } else {
+        m_selectFirstReadyStore = true;
+    }
+}
+
+void MainController::provideCredential(const QString &id, const QString &secret)
+{
+    QToolButton *btn = storeButtonForId(id);
+    QByteArray uri = btn ? btn->property("storeUri").toByteArray() : QByteArray();
+    if (uri.isEmpty()) {
+        m_pendingCredentials[id] = secret;  // still being created
+        return;
+    }
+    if (tagliacarte_credential_provide(uri.constData(), secret.toUtf8().constData()) != 0) {
+        fprintf(stderr, "[stores] could not set credential for %s\n", uri.constData());
+    }
+}
+
+void MainController::onStoreCreated(quint64 token, const StoreEntry &entry, const CreatedStore &created)
+{
+    m_creatingStores.remove(entry.id);
+    if (m_pendingStores.value(entry.id) != token) {
+        // The entry was removed or changed meanwhile. Creations for one id run one at a time,
+        // so the URI is this result's unless another entry's live store has it too.
+        if (!created.uri.isEmpty() && !allStoreUris.contains(created.uri)) {
+            tagliacarte_store_free(created.uri.constData());
+        }
+        if (!created.transportUri.isEmpty() && !storeToTransport.values().contains(created.transportUri)) {
+            tagliacarte_transport_free(created.transportUri.constData());
+        }
+        auto next = m_pendingStores.constFind(entry.id);
+        if (next != m_pendingStores.constEnd()) {
+            runStoreCreation(*next, m_storeEntries.value(entry.id));
+        }
+        return;
+    }
+    m_pendingStores.remove(entry.id);
+    QToolButton *btn = storeButtonForId(entry.id);
+    bool isInitial = (entry.id == m_initialStoreId);
+    if (created.uri.isEmpty()) {
+        fprintf(stderr, "[stores] could not create store %s\n", entry.id.toUtf8().constData());
+        m_storeEntries.remove(entry.id);
+        m_pendingCredentials.remove(entry.id);
+        if (btn) {
+            storeButtons.removeOne(btn);
+            btn->deleteLater();
         }
-        addStoreCircle(initial, uri, i);
-        tagliacarte_store_set_folder_list_callbacks(uri.constData(),
-            on_folder_found_cb, on_folder_removed_cb, on_folder_list_complete_cb, bridge);
-    }
-    if (!allStoreUris.isEmpty()) {
-        QByteArray initialUri;
-        QString lastId = c.lastSelectedStoreId;
-        if (!lastId.isEmpty()) {
-            QByteArray lastUtf8 = lastId.toUtf8();
-            for (const QByteArray &u : allStoreUris) {
-                if (u == lastUtf8) {
-                    initialUri = u;
+        if (isInitial) {
+            m_initialStoreId.clear();
+            m_selectFirstReadyStore = true;
+            for (QToolButton *b : storeButtons) {
+                QByteArray u = b->property("storeUri").toByteArray();
+                if (!u.isEmpty()) {
+                    m_selectFirstReadyStore = false;
+                    selectStore(u);
                     break;
                 }
             }
         }
-        if (initialUri.isEmpty()) {
-            initialUri = allStoreUris.first();
-        }
-        selectStore(initialUri);
-    } else {
-        storeUri.clear();
+        return;
+    }
+    allStoreUris.append(created.uri);
+    if (!created.transportUri.isEmpty()) {
+        storeToTransport[created.uri] = created.transportUri;
+    }
+    if (btn) {
+        btn->setProperty("storeUri", created.uri);
+        btn->setEnabled(true);
+    }
+    if (m_pendingCredentials.contains(entry.id)) {
+        provideCredential(entry.id, m_pendingCredentials.take(entry.id));
+    }
+    tagliacarte_store_set_folder_list_callbacks(created.uri.constData(),
+        on_folder_found_cb, on_folder_removed_cb, on_folder_list_complete_cb,
+        bridge->folderListContext(created.uri));
+    startStatusPolling(created.uri, entry);
+    if (isInitial || m_selectFirstReadyStore) {
+        m_initialStoreId.clear();
+        m_selectFirstReadyStore = false;
+        selectStore(created.uri);
+    } else if (m_warmUpStores) {
+        queueWarmUp(created.uri);
+    }
+}
+
+void MainController::queueWarmUp(const QByteArray &uri)
+{
+    m_warmUpQueue.append(uri);
+    if (m_warmUpQueue.size() == 1) {
+        QTimer::singleShot(WARM_UP_INTERVAL_MS, this, &MainController::warmUpNextStore);
+    }
+}
+
+void MainController::warmUpNextStore()
+{
+    if (m_warmUpQueue.isEmpty()) {
+        return;
+    }
+    QByteArray uri = m_warmUpQueue.takeFirst();
+    // Skip stores removed meanwhile, and the selected one, which connects by itself
+    if (allStoreUris.contains(uri) && uri != storeUri) {
+        tagliacarte_store_warm_up(uri.constData());
+    }
+    if (!m_warmUpQueue.isEmpty()) {
+        QTimer::singleShot(WARM_UP_INTERVAL_MS, this, &MainController::warmUpNextStore);
     }
 }
 
 void MainController::selectStore(const QByteArray &uri)
 {
+    rememberSession();
+    m_sessions.save();
+    if (unifiedInbox) {
+        unifiedInbox->close();
+    }
+    if (allInboxesBtn) {
+        allInboxesBtn->setChecked(false);
+    }
     storeUri = uri;
     smtpTransportUri = storeToTransport.value(storeUri);
 
@@ -343,6 +613,9 @@ void MainController::selectStore(const QByteArray &uri)
     bool convMode = bridge->isConversationMode();
     conversationList->setVisible(!convMode);
     messageHeaderPane->setVisible(false);
+    messageView->setVisible(!convMode);
+    if (bridge->chatView)
+        bridge->chatView->setVisible(convMode);
 
     if (kind == TAGLIACARTE_STORE_KIND_NOSTR) {
         QString uriStr = QString::fromUtf8(storeUri);
@@ -353,6 +626,7 @@ void MainController::selectStore(const QByteArray &uri)
         bridge->setSelfPubkey(storePubkey);
 
         Config c = loadConfig();
+        bridge->setProfileCacheTtl(c.profileCacheTtlHours);
         for (const StoreEntry &e : c.stores) {
             if (e.type == QLatin1String("nostr") && param(e, "pubkey").toLower() == storePubkey) {
                 bridge->setNostrRelays(storeHostOrPath(e));
@@ -381,17 +655,150 @@ void MainController::selectStore(const QByteArray &uri)
         }
     }
 
+    if (bridge->newsgroups) {
+        if (kind == TAGLIACARTE_STORE_KIND_NNTP) {
+            QStringList subscribed;
+            for (const StoreEntry &e : c.stores) {
+                if (e.id.toUtf8() == storeUri) {
+                    subscribed = param(e, "subscribedGroups").split(QLatin1Char(','), Qt::SkipEmptyParts);
+                    break;
+                }
+            }
+            bridge->newsgroups->activate(subscribed);
+        } else {
+            bridge->newsgroups->deactivate();
+        }
+    }
+
     for (auto *b : storeButtons) {
         b->setChecked(b->property("storeUri").toByteArray() == storeUri);
     }
+    bridge->showCachedFolders(storeUri);
+    // Go back to where the user left this store: the folder opens from the cached tree while
+    // the listing below revalidates it
+    m_restore = m_sessions.session(QString::fromUtf8(storeUri));
+    m_restoreStoreUri = m_restore.folder.isEmpty() ? QByteArray() : storeUri;
+    restoreFolder(false);
     tagliacarte_store_set_folder_list_callbacks(storeUri.constData(),
-        on_folder_found_cb, on_folder_removed_cb, on_folder_list_complete_cb, bridge);
-    tagliacarte_store_refresh_folders(storeUri.constData());
+        on_folder_found_cb, on_folder_removed_cb, on_folder_list_complete_cb,
+        bridge->folderListContext(storeUri));
+    bridge->refreshFolders(storeUri);
     win->statusBar()->showMessage(TR("status.folders_loaded"));
 }
 
+void MainController::rememberSession()
+{
+    if (storeUri.isEmpty() || m_restoreStoreUri == storeUri) {
+        return;  // nothing selected, or still restoring: keep what was saved
+    }
+    StoreSession session;
+    if (auto *folder = folderTree->currentItem()) {
+        session.folder = folder->data(0, FolderNameRole).toString();
+    }
+    if (!session.folder.isEmpty() && !bridge->isConversationMode()) {
+        if (auto *message = conversationList->currentItem()) {
+            session.messageId = message->data(0, MessageIdRole).toString();
+        }
+        session.scroll = conversationList->verticalScrollBar()->value();
+    }
+    m_sessions.setSession(QString::fromUtf8(storeUri), session);
+}
+
+void MainController::restoreFolder(bool listingComplete)
+{
+    if (m_restoreStoreUri.isEmpty() || m_restoreStoreUri != storeUri || folderTree->currentItem()) {
+        return;  // nothing to restore, or a folder is already open
+    }
+    if (QTreeWidgetItem *item = bridge->findFolderItem(m_restore.folder)) {
+        folderTree->setCurrentItem(item);
+    } else if (listingComplete) {
+        m_restoreStoreUri.clear();  // the folder is gone
+    }
+}
+
+void MainController::restoreMessageSelection()
+{
+    if (m_restoreStoreUri.isEmpty() || m_restoreStoreUri != storeUri) {
+        return;
+    }
+    m_restoreStoreUri.clear();
+    auto *folder = folderTree->currentItem();
+    if (!folder || folder->data(0, FolderNameRole).toString() != m_restore.folder) {
+        return;  // the user opened another folder meanwhile
+    }
+    QTreeWidgetItem *message = nullptr;
+    if (!m_restore.messageId.isEmpty()) {
+        for (int i = 0; i < conversationList->topLevelItemCount(); ++i) {
+            QTreeWidgetItem *item = conversationList->topLevelItem(i);
+            if (item->data(0, MessageIdRole).toString() == m_restore.messageId) {
+                message = item;
+                break;
+            }
+        }
+    }
+    if (message) {
+        conversationList->setCurrentItem(message);
+    }
+    // After the list has laid out its rows, so that the scroll range is final
+    const int scroll = m_restore.scroll;
+    QPointer<QTreeWidget> list(conversationList);
+    QTimer::singleShot(0, this, [list, message, scroll]() {
+        if (!list) {
+            return;
+        }
+        if (scroll >= 0) {
+            list->verticalScrollBar()->setValue(scroll);
+        } else if (message && list->currentItem() == message) {
+            list->scrollToItem(message);
+        }
+    });
+}
+
+void MainController::showUnifiedInbox()
+{
+    rememberSession();
+    m_sessions.save();
+    storeUri.clear();
+    smtpTransportUri.clear();
+    bridge->clearFolder();
+    folderTree->clear();
+    conversationList->clear();
+    messageView->clear();
+    messageHeaderPane->hide();
+    if (bridge->newsgroups) {
+        bridge->newsgroups->deactivate();
+    }
+    bridge->setStoreKind(TAGLIACARTE_STORE_KIND_EMAIL);
+    conversationList->setVisible(true);
+    messageView->setVisible(true);
+    if (bridge->chatView) {
+        bridge->chatView->setVisible(false);
+    }
+    if (bridge->composeBar) {
+        bridge->composeBar->setVisible(false);
+    }
+    updateComposeAppendButtons();
+    updateMessageActionButtons();
+    for (auto *b : storeButtons) {
+        b->setChecked(false);
+    }
+    allInboxesBtn->setChecked(true);
+
+    // Email stores in sidebar order; UnifiedInbox skips those without a default folder
+    QList<QByteArray> uris;
+    for (QToolButton *b : storeButtons) {
+        QByteArray u = b->property("storeUri").toByteArray();
+        if (!u.isEmpty() && tagliacarte_store_kind(u.constData()) == TAGLIACARTE_STORE_KIND_EMAIL) {
+            uris.append(u);
+        }
+    }
+    unifiedInbox->open(uris);
+}
+
 void MainController::shutdown()
 {
+    rememberSession();
+    m_sessions.save();
     bridge->clearFolder();
     for (const QByteArray &u : allStoreUris) {
         tagliacarte_store_free(u.constData());
@@ -401,6 +808,8 @@ void MainController::shutdown()
     }
     allStoreUris.clear();
     storeToTransport.clear();
+    // Stores still being created are freed as they arrive
+    m_pendingStores.clear();
 }
 
 // --- Compose / message action methods ---
@@ -516,30 +925,7 @@ void MainController::sendChatMessage(const QString &text)
         return;
     }
 
-    QString selfPubkey = bridge->selfPubkey();
-    QByteArray transportBa = smtpTransportUri;
-    QByteArray fromBa = selfPubkey.toUtf8();
-    QByteArray toBa = recipientPubkey.toUtf8();
-    QByteArray bodyBa = text.trimmed().toUtf8();
-
-    fprintf(stderr, "[chat] sending to %s via %s\n", toBa.constData(), transportBa.constData());
-
-    win->statusBar()->showMessage(TR("status.sending"));
-    tagliacarte_transport_send_async(
-        transportBa.constData(),
-        fromBa.constData(),
-        toBa.constData(),
-        nullptr,
-        nullptr,
-        nullptr,
-        bodyBa.constData(),
-        nullptr,
-        0,
-        nullptr,
-        on_send_progress_cb,
-        on_send_complete_cb,
-        bridge
-    );
+    bridge->queueChatMessage(smtpTransportUri, recipientPubkey, text);
 }
 
 void MainController::connectComposeActions()
@@ -658,7 +1044,7 @@ void MainController::connectComposeActions()
 
         if (forwardMode == QLatin1String("embedded") || forwardMode == QLatin1String("attachment")) {
             auto *item = conversationList->currentItem();
-            QByteArray folderUri = bridge->folderUri();
+            QByteArray folderUri = bridge->folderUriForItem(item);
             if (!item || folderUri.isEmpty()) {
                 return;
             }
@@ -695,7 +1081,7 @@ void MainController::connectComposeActions()
 
     QObject::connect(deleteBtn, &QToolButton::clicked, this, [this]() {
         auto *item = conversationList->currentItem();
-        QByteArray folderUri = bridge->folderUri();
+        QByteArray folderUri = bridge->folderUriForItem(item);
         if (!item || folderUri.isEmpty()) {
             return;
         }
@@ -4,9 +4,14 @@
 #include <QObject>
 #include <QByteArray>
 #include <QMap>
+#include <QHash>
 #include <QList>
+#include <QSet>
 #include <QString>
 
+#include "Config.h"
+#include "SessionCache.h"
+
 class QMainWindow;
 class QToolButton;
 class QLineEdit;
@@ -18,10 +23,9 @@ class QVBoxLayout;
 class QStackedWidget;
 
 class EventBridge;
+class UnifiedInbox;
 class CidTextBrowser;
 class ComposeDialog;
-struct StoreEntry;
-struct Config;
 
 /**
  * Central controller holding shared mutable state that was formerly
@@ -63,22 +67,52 @@ public:
     QVBoxLayout *storeListLayout = nullptr;
     QStackedWidget *rightStack = nullptr;
     QToolButton *settingsBtn = nullptr;
+    QToolButton *allInboxesBtn = nullptr;
+    UnifiedInbox *unifiedInbox = nullptr;
 
     // --- Methods extracted from lambdas ---
     void updateComposeAppendButtons();
     void updateMessageActionButtons();
     void addStoreCircle(const QString &initial, const QByteArray &uri, int colourIndex);
 
-    /** Create a store URI from a config entry.  Returns the URI (empty on failure).
-     *  Adds any associated transport to storeToTransport. */
-    QByteArray createStoreFromEntry(const StoreEntry &entry);
+    /** A store made from a config entry, and its transport if it has one. */
+    struct CreatedStore {
+        QByteArray uri;           // empty on failure
+        QByteArray transportUri;  // empty if none
+    };
+
+    /** Create a store (and any associated transport) from a config entry.  Touches no
+     *  controller state, so it may run on a worker thread. */
+    static CreatedStore createStoreFromEntry(const StoreEntry &entry);
 
-    /** Tear down all current stores and re-create them from config. */
+    /** Poll folder counts for an IMAP or Maildir store every imapPollSeconds. */
+    void startStatusPolling(const QByteArray &uri, const StoreEntry &entry);
+
+    /** Bring the stores in line with config.  Stores whose entry is unchanged (apart from
+     *  display name and poll interval) keep their connections and state; removed or changed
+     *  ones are freed, and new or changed ones get a disabled circle at once and are created
+     *  on a worker thread.  The selection only moves if its store went away. */
     void refreshStoresFromConfig();
 
+    /** Give the store for config id its secret (e.g. a Nostr key): now if the store is live,
+     *  else once onStoreCreated has it. */
+    void provideCredential(const QString &id, const QString &secret);
+
     /** Select a store by URI: update state, load folders, check correct circle. */
     void selectStore(const QByteArray &uri);
 
+    /** Show the inboxes of all email stores merged in one list (no store selected). */
+    void showUnifiedInbox();
+
+    /** Record the selected store's open folder, selected message and scroll position. */
+    void rememberSession();
+    /** Session restore: open the selected store's remembered folder once it is in the folder
+     *  tree.  listingComplete: the tree is final, so give up if the folder is not there. */
+    void restoreFolder(bool listingComplete);
+    /** Session restore: reselect the remembered message and scroll position once the
+     *  remembered folder's message list has loaded. */
+    void restoreMessageSelection();
+
     /** Free all stores and transports. Called during shutdown. */
     void shutdown();
 
@@ -113,6 +147,40 @@ public:
                            const QStringList &messageIds,
                            const QString &destFolderName,
                            bool isMove);
+
+private:
+    /** The circle for a config entry id, or null. */
+    QToolButton *storeButtonForId(const QString &id) const;
+
+    /** Add a disabled circle for entry and create its store on a worker thread. */
+    void startCreatingStore(const StoreEntry &entry, int colourIndex);
+    /** Create entry's store on a worker thread; the result goes to onStoreCreated. */
+    void runStoreCreation(quint64 token, const StoreEntry &entry);
+
+    /** Free a store, its transport and its circle; clear the panes if it was selected. */
+    void removeStore(const QString &id);
+
+    /** Queue a store for background warm-up (see tagliacarte_store_warm_up). */
+    void queueWarmUp(const QByteArray &uri);
+
+    /** Warm up the next queued store, then schedule the one after. */
+    void warmUpNextStore();
+
+    /** A store from startCreatingStore is ready (or failed, if created.uri is empty). */
+    void onStoreCreated(quint64 token, const StoreEntry &entry, const CreatedStore &created);
+
+    SessionCache m_sessions;
+    QByteArray m_restoreStoreUri;               // store whose session is being restored; empty if none
+    StoreSession m_restore;                     // what is left to restore for it
+    QList<QByteArray> m_warmUpQueue;            // stores still to warm up, one at a time
+    bool m_warmUpStores = false;                // Config::warmUpStores as of the last refresh
+    QHash<QString, StoreEntry> m_storeEntries;  // config id -> entry each live or pending store was made from
+    QHash<QString, quint64> m_pendingStores;     // config id -> token of the creation whose result is wanted
+    QSet<QString> m_creatingStores;              // config ids with a creation running on a worker thread
+    QHash<QString, QString> m_pendingCredentials; // config id -> secret for its store once created
+    quint64 m_storeCreationCounter = 0;
+    QString m_initialStoreId;          // store to select once it is ready
+    bool m_selectFirstReadyStore = false;  // the initial store failed: select whichever comes up first
 };
 
 #endif // MAINCONTROLLER_H
@@ -36,13 +36,25 @@ protected:
     // mimeTypes and mimeData are sufficient for drag support.
 
     QMimeData *mimeData(const QList<QTreeWidgetItem *> &items) const override {
-        if (items.isEmpty() || m_sourceFolderUri.isEmpty()) {
+        if (items.isEmpty()) {
+            return nullptr;
+        }
+        // Rows of the unified inbox carry their own folder; a drag takes those of the first one
+        QByteArray sourceFolderUri = items.first()->data(0, MessageFolderUriRole).toByteArray();
+        if (sourceFolderUri.isEmpty()) {
+            sourceFolderUri = m_sourceFolderUri;
+        }
+        if (sourceFolderUri.isEmpty()) {
             return nullptr;
         }
         QByteArray payload;
-        payload.append(m_sourceFolderUri);
+        payload.append(sourceFolderUri);
         payload.append('\n');
         for (auto *item : items) {
+            QByteArray itemFolderUri = item->data(0, MessageFolderUriRole).toByteArray();
+            if (!itemFolderUri.isEmpty() && itemFolderUri != sourceFolderUri) {
+                continue;
+            }
             QVariant idVar = item->data(0, MessageIdRole);
             if (idVar.isValid()) {
                 payload.append(idVar.toString().toUtf8());
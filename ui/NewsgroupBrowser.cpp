@@ -0,0 +1,279 @@
+/*
+ * NewsgroupBrowser.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NewsgroupBrowser.h"
+#include "EventBridge.h"
+#include "Tr.h"
+
+#include <QFont>
+#include <QHash>
+#include <QLineEdit>
+#include <QTimer>
+#include <QToolButton>
+#include <QTreeWidget>
+#include <algorithm>
+
+// Filter results are listed flat; beyond this many the filter needs to be narrowed
+static constexpr int FilterLimit = 1000;
+
+NewsgroupBrowser::NewsgroupBrowser(QTreeWidget *tree, QWidget *bar, QLineEdit *filterEdit,
+                                   QToolButton *allGroupsButton, QObject *parent)
+    : QObject(parent)
+    , m_tree(tree)
+    , m_bar(bar)
+    , m_filterEdit(filterEdit)
+    , m_allGroupsButton(allGroupsButton)
+    , m_filterTimer(new QTimer(this))
+{
+    m_bar->hide();
+    // Wait for a pause in typing: each pass scans the whole group list
+    m_filterTimer->setSingleShot(true);
+    m_filterTimer->setInterval(150);
+    connect(m_filterTimer, &QTimer::timeout, this, &NewsgroupBrowser::rebuild);
+    connect(m_filterEdit, &QLineEdit::textChanged, m_filterTimer, qOverload<>(&QTimer::start));
+    connect(m_allGroupsButton, &QToolButton::toggled, this, &NewsgroupBrowser::rebuild);
+    connect(m_tree, &QTreeWidget::itemExpanded, this, [this](QTreeWidgetItem *item) {
+        QString path = item->data(0, NewsgroupPathRole).toString();
+        if (m_active && item->childCount() == 0 && !path.isEmpty()) {
+            populate(item, path + QLatin1Char('.'));
+        }
+    });
+}
+
+void NewsgroupBrowser::activate(const QStringList &subscribed) {
+    m_active = true;
+    m_loading = false;
+    m_groups.clear();
+    m_arriving.clear();
+    m_subscribed = QSet<QString>(subscribed.begin(), subscribed.end());
+    m_filterTimer->stop();
+    m_filterEdit->clear();
+    m_bar->show();
+    rebuild();
+}
+
+void NewsgroupBrowser::deactivate() {
+    if (!m_active) {
+        return;
+    }
+    m_active = false;
+    m_loading = false;
+    m_groups.clear();
+    m_arriving.clear();
+    m_subscribed.clear();
+    m_filterTimer->stop();
+    m_bar->hide();
+}
+
+void NewsgroupBrowser::addGroup(const QString &name) {
+    if (!m_loading) {
+        // First group of a new listing: it replaces the previous one when complete
+        m_loading = true;
+        m_arriving.clear();
+    }
+    m_arriving.insert(name);
+}
+
+void NewsgroupBrowser::removeGroup(const QString &name) {
+    m_arriving.remove(name);
+    auto it = std::lower_bound(m_groups.begin(), m_groups.end(), name);
+    if (it != m_groups.end() && *it == name) {
+        m_groups.erase(it);
+        rebuild();
+    }
+}
+
+void NewsgroupBrowser::finishLoading() {
+    if (!m_loading) {
+        return;
+    }
+    m_loading = false;
+    m_groups = QStringList(m_arriving.cbegin(), m_arriving.cend());
+    m_arriving.clear();
+    std::sort(m_groups.begin(), m_groups.end());
+    // The subscribed view does not depend on the listing
+    if (!showsSubscribedOnly()) {
+        rebuild();
+    }
+}
+
+void NewsgroupBrowser::setSubscribed(const QString &name, bool subscribed) {
+    if (subscribed == m_subscribed.contains(name)) {
+        return;
+    }
+    if (subscribed) {
+        m_subscribed.insert(name);
+    } else {
+        m_subscribed.remove(name);
+    }
+    if (m_active) {
+        showSubscription(name, subscribed);
+    }
+    emit subscriptionsChanged(subscribedGroups());
+}
+
+void NewsgroupBrowser::showSubscription(const QString &name, bool subscribed) {
+    // Only the toggled group's item changes; the rest of the tree keeps its expansion
+    if (!showsSubscribedOnly()) {
+        if (QTreeWidgetItem *item = findGroupItem(name)) {
+            setSubscribedFont(item, subscribed);
+        }
+    } else if (subscribed) {
+        // Top-level items are the sorted subscriptions
+        int lo = 0, hi = m_tree->topLevelItemCount();
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (m_tree->topLevelItem(mid)->data(0, FolderNameRole).toString() < name) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        m_tree->insertTopLevelItem(lo, groupItem(name, name));
+    } else if (QTreeWidgetItem *item = findGroupItem(name)) {
+        // Removing the open group must not look like a selection change, as in rebuild
+        m_tree->blockSignals(true);
+        delete item;
+        m_tree->blockSignals(false);
+    }
+}
+
+bool NewsgroupBrowser::showsSubscribedOnly() const {
+    return !m_allGroupsButton->isChecked() && m_filterEdit->text().trimmed().isEmpty();
+}
+
+QTreeWidgetItem *NewsgroupBrowser::findGroupItem(const QString &group) const {
+    QAbstractItemModel *model = m_tree->model();
+    const QModelIndexList found = model->match(model->index(0, 0), FolderNameRole, group, 1,
+                                               Qt::MatchExactly | Qt::MatchRecursive);
+    return found.isEmpty() ? nullptr : m_tree->itemFromIndex(found.first());
+}
+
+void NewsgroupBrowser::setSubscribedFont(QTreeWidgetItem *item, bool subscribed) {
+    QFont f = item->font(0);
+    f.setBold(subscribed);
+    item->setFont(0, f);
+}
+
+QStringList NewsgroupBrowser::subscribedGroups() const {
+    QStringList groups(m_subscribed.begin(), m_subscribed.end());
+    std::sort(groups.begin(), groups.end());
+    return groups;
+}
+
+QTreeWidgetItem *NewsgroupBrowser::groupItem(const QString &text, const QString &group) const {
+    auto *item = new QTreeWidgetItem();
+    item->setText(0, text);
+    item->setData(0, FolderNameRole, group);
+    item->setData(0, FolderDelimRole, QStringLiteral("."));
+    item->setData(0, FolderAttrsRole, QString());
+    if (!group.isEmpty() && m_subscribed.contains(group)) {
+        setSubscribedFont(item, true);
+    }
+    return item;
+}
+
+void NewsgroupBrowser::rebuild() {
+    if (!m_active) {
+        return;
+    }
+    QTreeWidgetItem *current = m_tree->currentItem();
+    QString currentGroup = current ? current->data(0, FolderNameRole).toString() : QString();
+
+    // Rebuilding must not look like a selection change: that would close the open group
+    m_tree->blockSignals(true);
+    m_tree->setUpdatesEnabled(false);
+    m_tree->clear();
+
+    QString filter = m_filterEdit->text().trimmed();
+    QList<QTreeWidgetItem *> items;
+    if (!filter.isEmpty()) {
+        for (const QString &group : std::as_const(m_groups)) {
+            if (!group.contains(filter, Qt::CaseInsensitive)) {
+                continue;
+            }
+            if (items.size() == FilterLimit) {
+                auto *more = new QTreeWidgetItem();
+                more->setText(0, TR("newsgroups.more_matches"));
+                more->setFlags(Qt::NoItemFlags);
+                items.append(more);
+                break;
+            }
+            items.append(groupItem(group, group));
+        }
+        m_tree->addTopLevelItems(items);
+    } else if (m_allGroupsButton->isChecked()) {
+        populate(nullptr, QString());
+    } else {
+        for (const QString &group : subscribedGroups()) {
+            items.append(groupItem(group, group));
+        }
+        m_tree->addTopLevelItems(items);
+    }
+
+    if (!currentGroup.isEmpty()) {
+        for (int i = 0; i < m_tree->topLevelItemCount(); ++i) {
+            QTreeWidgetItem *item = m_tree->topLevelItem(i);
+            if (item->data(0, FolderNameRole).toString() == currentGroup) {
+                m_tree->setCurrentItem(item);
+                break;
+            }
+        }
+    }
+    m_tree->setUpdatesEnabled(true);
+    m_tree->blockSignals(false);
+}
+
+void NewsgroupBrowser::populate(QTreeWidgetItem *parent, const QString &prefix) {
+    // Groups below prefix are one contiguous run of the sorted list. Within it, the groups
+    // under one child ("prefix.child.*") are again contiguous, so each child costs two
+    // binary searches however many groups lie beneath it.
+    QHash<QString, QTreeWidgetItem *> made;
+    QList<QTreeWidgetItem *> items;
+    auto end = m_groups.cend();
+    auto it = std::lower_bound(m_groups.cbegin(), end, prefix);
+    while (it != end && it->startsWith(prefix)) {
+        int dot = it->indexOf(QLatin1Char('.'), prefix.size());
+        QString path = dot < 0 ? *it : it->left(dot);
+        QString below = path + QLatin1Char('.');
+        QString after = path + QLatin1Char('/');  // '/' sorts right after '.'
+        if (made.contains(path)) {
+            // Back under a node made earlier: "alt-x" sorts between "alt" and "alt.x"
+            it = std::lower_bound(it, end, after);
+            continue;
+        }
+        auto childrenBegin = std::lower_bound(it, end, below);
+        auto childrenEnd = std::lower_bound(childrenBegin, end, after);
+        bool isGroup = *it == path;
+        QTreeWidgetItem *item = groupItem(path.mid(prefix.size()), isGroup ? path : QString());
+        if (childrenBegin != childrenEnd) {
+            item->setData(0, NewsgroupPathRole, path);
+            item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+        }
+        made.insert(path, item);
+        items.append(item);
+        it = isGroup ? it + 1 : childrenEnd;
+    }
+    if (parent) {
+        parent->addChildren(items);
+    } else {
+        m_tree->addTopLevelItems(items);
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ * NewsgroupBrowser.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NEWSGROUPBROWSER_H
+#define NEWSGROUPBROWSER_H
+
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+
+class QLineEdit;
+class QTimer;
+class QToolButton;
+class QTreeWidget;
+class QTreeWidgetItem;
+class QWidget;
+
+/**
+ * Folder tree for NNTP stores. The server's group list is held as one sorted string list
+ * rather than tree items. By default the tree shows only subscribed groups. With the
+ * "all groups" button checked it shows the group hierarchy, creating each level's items
+ * when its parent is expanded. Text in the filter field lists matching groups from the
+ * whole server.
+ */
+class NewsgroupBrowser : public QObject {
+    Q_OBJECT
+public:
+    /** bar holds filterEdit and allGroupsButton; it is shown while the browser is active. */
+    NewsgroupBrowser(QTreeWidget *tree, QWidget *bar, QLineEdit *filterEdit, QToolButton *allGroupsButton,
+                     QObject *parent = nullptr);
+
+    /** Take over the folder tree for an NNTP store with the given subscriptions. */
+    void activate(const QStringList &subscribed);
+    /** Hand the folder tree back (another kind of store was selected). */
+    void deactivate();
+    bool isActive() const { return m_active; }
+
+    /** A group from the server's listing; shown once the listing completes. */
+    void addGroup(const QString &name);
+    void removeGroup(const QString &name);
+    /** The listing is complete: sort the groups received and show them. */
+    void finishLoading();
+    int groupCount() const { return static_cast<int>(m_groups.size()); }
+
+    bool isSubscribed(const QString &name) const { return m_subscribed.contains(name); }
+    void setSubscribed(const QString &name, bool subscribed);
+    /** Subscribed groups in sorted order. */
+    QStringList subscribedGroups() const;
+
+Q_SIGNALS:
+    /** Subscriptions changed through setSubscribed; groups is the new sorted list. */
+    void subscriptionsChanged(const QStringList &groups);
+
+private:
+    void rebuild();
+    /** Update the tree for a subscription change of group name. */
+    void showSubscription(const QString &name, bool subscribed);
+    /** Only subscribed groups are shown: no filter text and "all groups" unchecked. */
+    bool showsSubscribedOnly() const;
+    /** The item showing group, if it is in the tree. */
+    QTreeWidgetItem *findGroupItem(const QString &group) const;
+    /** Subscribed groups are shown in bold. */
+    static void setSubscribedFont(QTreeWidgetItem *item, bool subscribed);
+    /** Add the items one level below prefix ("" for the top level, else ending with '.'). */
+    void populate(QTreeWidgetItem *parent, const QString &prefix);
+    QTreeWidgetItem *groupItem(const QString &text, const QString &group) const;
+
+    QTreeWidget *m_tree;
+    QWidget *m_bar;
+    QLineEdit *m_filterEdit;
+    QToolButton *m_allGroupsButton;
+    QTimer *m_filterTimer;
+    bool m_active = false;
+    bool m_loading = false;       // listing in progress: m_arriving not yet merged
+    QStringList m_groups;         // every group on the server, sorted
+    QSet<QString> m_arriving;     // groups received during the current listing
+    QSet<QString> m_subscribed;
+};
+
+#endif // NEWSGROUPBROWSER_H
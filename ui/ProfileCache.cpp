@@ -0,0 +1,112 @@
+/*
+ * ProfileCache.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProfileCache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <cstdio>
+
+QString ProfileCache::path() {
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QDir().mkpath(dir);
+    return dir + QStringLiteral("/profiles.xml");
+}
+
+ProfileCache::ProfileCache() {
+    QFile f(path());
+    if (!f.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QXmlStreamReader r(&f);
+    while (!r.atEnd()) {
+        r.readNext();
+        if (r.isStartElement() && r.name() == QLatin1String("profile")) {
+            const QXmlStreamAttributes a = r.attributes();
+            QString id = a.value(QLatin1String("id")).toString().toLower();
+            if (id.isEmpty()) {
+                continue;
+            }
+            CachedProfile p;
+            p.displayName = a.value(QLatin1String("name")).toString();
+            p.nip05 = a.value(QLatin1String("nip05")).toString();
+            p.pictureUrl = a.value(QLatin1String("picture")).toString();
+            p.fetchedAt = a.value(QLatin1String("fetched")).toLongLong();
+            m_profiles.insert(id, p);
+        }
+    }
+    if (r.hasError()) {
+        fprintf(stderr, "[profiles] %s: %s\n", path().toUtf8().constData(), r.errorString().toUtf8().constData());
+    }
+}
+
+bool ProfileCache::isFresh(const QString &id, qint64 ttlSecs) const {
+    auto it = m_profiles.constFind(id);
+    if (it == m_profiles.constEnd()) {
+        return false;
+    }
+    qint64 ttl = it->isEmpty() ? qMin(ttlSecs, MissingTtlSecs) : ttlSecs;
+    return QDateTime::currentSecsSinceEpoch() - it->fetchedAt < ttl;
+}
+
+void ProfileCache::insert(const QString &id, CachedProfile profile) {
+    profile.fetchedAt = QDateTime::currentSecsSinceEpoch();
+    m_profiles.insert(id, profile);
+    m_dirty = true;
+}
+
+void ProfileCache::insertMissing(const QString &id) {
+    m_profiles[id].fetchedAt = QDateTime::currentSecsSinceEpoch();
+    m_dirty = true;
+}
+
+void ProfileCache::save() {
+    if (!m_dirty) {
+        return;
+    }
+    QSaveFile f(path());
+    if (!f.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QXmlStreamWriter w(&f);
+    w.setAutoFormatting(true);
+    w.writeStartDocument(QStringLiteral("1.0"), true);
+    w.writeStartElement(QStringLiteral("profiles"));
+    for (auto it = m_profiles.constBegin(); it != m_profiles.constEnd(); ++it) {
+        const CachedProfile &p = it.value();
+        w.writeStartElement(QStringLiteral("profile"));
+        w.writeAttribute(QStringLiteral("id"), it.key());
+        if (!p.displayName.isEmpty()) w.writeAttribute(QStringLiteral("name"), p.displayName);
+        if (!p.nip05.isEmpty()) w.writeAttribute(QStringLiteral("nip05"), p.nip05);
+        if (!p.pictureUrl.isEmpty()) w.writeAttribute(QStringLiteral("picture"), p.pictureUrl);
+        w.writeAttribute(QStringLiteral("fetched"), QString::number(p.fetchedAt));
+        w.writeEndElement();
+    }
+    w.writeEndElement();
+    w.writeEndDocument();
+    if (f.commit()) {
+        m_dirty = false;
+    }
+}
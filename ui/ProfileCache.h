@@ -0,0 +1,75 @@
+/*
+ * ProfileCache.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILECACHE_H
+#define PROFILECACHE_H
+
+#include <QHash>
+#include <QString>
+
+/** What is known about a Nostr author (hex pubkey) from their kind 0 profile. */
+struct CachedProfile {
+    QString displayName;
+    QString nip05;
+    QString pictureUrl;
+    qint64 fetchedAt = 0;   // seconds since the epoch
+
+    /** Display name, else NIP-05; empty if the profile has neither. */
+    QString bestName() const { return displayName.isEmpty() ? nip05 : displayName; }
+    /** No profile was found when last fetched. */
+    bool isEmpty() const { return displayName.isEmpty() && nip05.isEmpty() && pictureUrl.isEmpty(); }
+};
+
+/**
+ * Nostr author profiles kept across restarts, so chat folders and timelines show real
+ * names and avatars at once. Entries older than the TTL are still used, but are due for a
+ * refresh. Authors without a profile are remembered too, for at most MissingTtlSecs.
+ * Stored in profiles.xml in the cache directory; keys are lower case.
+ */
+class ProfileCache {
+public:
+    /** Load the cache file (missing or unreadable: start empty). */
+    ProfileCache();
+
+    bool contains(const QString &id) const { return m_profiles.contains(id); }
+    CachedProfile value(const QString &id) const { return m_profiles.value(id); }
+    const QHash<QString, CachedProfile> &profiles() const { return m_profiles; }
+    /** How long "no profile" stands before the author is looked up again. */
+    static constexpr qint64 MissingTtlSecs = 6 * 3600;
+
+    /** True if id was fetched less than ttlSecs (MissingTtlSecs if no profile was found) ago. */
+    bool isFresh(const QString &id, qint64 ttlSecs) const;
+    /** Store a profile fetched now. */
+    void insert(const QString &id, CachedProfile profile);
+    /** Record a fetch that found no profile for id; what was cached before is kept. */
+    void insertMissing(const QString &id);
+
+    bool isDirty() const { return m_dirty; }
+    /** Write the cache file if anything changed since it was loaded or last saved. */
+    void save();
+
+private:
+    static QString path();
+
+    QHash<QString, CachedProfile> m_profiles;
+    bool m_dirty = false;
+};
+
+#endif // PROFILECACHE_H
@@ -0,0 +1,119 @@
+/*
+ * RemoteResourceLoader.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RemoteResourceLoader.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QStandardPaths>
+#include <cstdio>
+
+RemoteResourceLoader *RemoteResourceLoader::instance() {
+    static RemoteResourceLoader *s_instance = new RemoteResourceLoader(QCoreApplication::instance());
+    return s_instance;
+}
+
+RemoteResourceLoader::RemoteResourceLoader(QObject *parent)
+    : QObject(parent)
+    , m_nam(new QNetworkAccessManager(this))
+    , m_images(64 * 1024)  // 64 MiB of decoded pixels
+{
+    auto *cache = new QNetworkDiskCache(this);
+    cache->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/http"));
+    cache->setMaximumCacheSize(200 * 1024 * 1024);
+    m_nam->setCache(cache);
+    connect(m_nam, &QNetworkAccessManager::finished, this, &RemoteResourceLoader::onFinished);
+}
+
+QImage RemoteResourceLoader::cachedImage(const QUrl &url) const {
+    const QImage *img = m_images.object(url.toString());
+    return img ? *img : QImage();
+}
+
+void RemoteResourceLoader::request(const QUrl &url) {
+    QString key = url.toString();
+    if (m_images.contains(key) || m_pending.contains(key)) {
+        return;
+    }
+    auto failed = m_failed.constFind(key);
+    if (failed != m_failed.constEnd() && QDateTime::currentMSecsSinceEpoch() < failed->retryAt) {
+        return;
+    }
+    m_pending.insert(key);
+    QString host = url.host().toLower();
+    m_hostQueues[host].enqueue(url);
+    startNext(host);
+}
+
+void RemoteResourceLoader::startNext(const QString &host) {
+    auto qit = m_hostQueues.find(host);
+    while (qit != m_hostQueues.end() && !qit->isEmpty() && m_hostActive.value(host) < MaxPerHost) {
+        QNetworkRequest req(qit->dequeue());
+        // PreferNetwork: fresh entries come from disk, stale ones are revalidated conditionally
+        req.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+        req.setAttribute(QNetworkRequest::CacheSaveControlAttribute, true);
+        req.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+        m_hostActive[host]++;
+        QNetworkReply *reply = m_nam->get(req);
+        // Stop an oversized image as it arrives (or as soon as Content-Length gives it away)
+        // rather than buffering all of it; the abort finishes the reply with an error
+        connect(reply, &QNetworkReply::downloadProgress, reply, [reply](qint64 received, qint64 total) {
+            if (received > MaxImageBytes || total > MaxImageBytes) {
+                reply->abort();
+            }
+        });
+    }
+    if (qit != m_hostQueues.end() && qit->isEmpty()) {
+        m_hostQueues.erase(qit);
+    }
+}
+
+void RemoteResourceLoader::onFinished(QNetworkReply *reply) {
+    reply->deleteLater();
+    QUrl url = reply->request().url();
+    QString key = url.toString();
+    QString host = url.host().toLower();
+    m_pending.remove(key);
+    if (--m_hostActive[host] <= 0) {
+        m_hostActive.remove(host);
+    }
+
+    QImage img;
+    if (reply->error() == QNetworkReply::NoError && reply->bytesAvailable() <= MaxImageBytes) {
+        img.loadFromData(reply->readAll());
+    }
+    if (img.isNull()) {
+        fprintf(stderr, "[resource] failed: %s (%s)\n", qPrintable(key), qPrintable(reply->errorString()));
+        // A transient failure is retried: after 30 s, then twice as long each time, up to an hour
+        Failure &failure = m_failed[key];
+        qint64 delay = qMin(RetryBaseMs << qMin(failure.attempts, 7), RetryMaxMs);
+        failure.attempts++;
+        failure.retryAt = QDateTime::currentMSecsSinceEpoch() + delay;
+    } else {
+        m_failed.remove(key);
+        m_images.insert(key, new QImage(img), qMax<qsizetype>(1, img.sizeInBytes() / 1024));
+    }
+    emit imageReady(url, img);
+    startNext(host);
+}
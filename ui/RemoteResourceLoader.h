@@ -0,0 +1,83 @@
+/*
+ * RemoteResourceLoader.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REMOTERESOURCELOADER_H
+#define REMOTERESOURCELOADER_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QQueue>
+#include <QSet>
+#include <QUrl>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/**
+ * Asynchronous loader for remote (http/https) images in message views.
+ *
+ * One shared QNetworkAccessManager with an on-disk QNetworkDiskCache, so responses
+ * are revalidated with their ETag / Last-Modified instead of refetched. Decoded images
+ * are kept in a memory cache; a URL requested by several views or messages is fetched
+ * once. At most MaxPerHost requests run against one host; the rest queue.
+ */
+class RemoteResourceLoader : public QObject {
+    Q_OBJECT
+public:
+    static RemoteResourceLoader *instance();
+
+    /** Decoded image for url if already loaded, else a null image. */
+    QImage cachedImage(const QUrl &url) const;
+
+    /** Start loading url unless it is cached, in flight, queued, or backing off after a failure.
+     *  imageReady fires when done. */
+    void request(const QUrl &url);
+
+Q_SIGNALS:
+    /** url finished loading; image is null if it failed or did not decode. */
+    void imageReady(const QUrl &url, const QImage &image);
+
+private:
+    explicit RemoteResourceLoader(QObject *parent = nullptr);
+    void startNext(const QString &host);
+    void onFinished(QNetworkReply *reply);
+
+    static constexpr int MaxPerHost = 4;
+    static constexpr qint64 MaxImageBytes = 16 * 1024 * 1024;
+    static constexpr qint64 RetryBaseMs = 30 * 1000;        // first retry after a failure
+    static constexpr qint64 RetryMaxMs = 60 * 60 * 1000;    // backoff ceiling
+
+    /** A url that failed: not requested again before retryAt (ms since epoch). */
+    struct Failure {
+        int attempts = 0;
+        qint64 retryAt = 0;
+    };
+
+    QNetworkAccessManager *m_nam = nullptr;
+    QCache<QString, QImage> m_images;            // url -> decoded image, cost in KiB
+    QHash<QString, Failure> m_failed;            // urls that failed, backing off exponentially
+    QSet<QString> m_pending;                     // urls queued or in flight
+    QHash<QString, QQueue<QUrl>> m_hostQueues;   // host -> urls waiting for a slot
+    QHash<QString, int> m_hostActive;            // host -> requests in flight
+};
+
+#endif // REMOTERESOURCELOADER_H
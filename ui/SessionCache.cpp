@@ -0,0 +1,101 @@
+/*
+ * SessionCache.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SessionCache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <cstdio>
+
+QString SessionCache::path() {
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QDir().mkpath(dir);
+    return dir + QStringLiteral("/session.xml");
+}
+
+SessionCache::SessionCache() {
+    QFile f(path());
+    if (!f.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QXmlStreamReader r(&f);
+    while (!r.atEnd()) {
+        r.readNext();
+        if (!r.isStartElement() || r.name() != QLatin1String("store")) {
+            continue;
+        }
+        const QXmlStreamAttributes a = r.attributes();
+        QString uri = a.value(QLatin1String("uri")).toString();
+        if (uri.isEmpty()) {
+            continue;
+        }
+        StoreSession session;
+        session.folder = a.value(QLatin1String("folder")).toString();
+        session.messageId = a.value(QLatin1String("message")).toString();
+        bool ok = false;
+        int scroll = a.value(QLatin1String("scroll")).toInt(&ok);
+        session.scroll = ok ? scroll : -1;
+        m_stores.insert(uri, session);
+    }
+    if (r.hasError()) {
+        fprintf(stderr, "[session] %s: %s\n", path().toUtf8().constData(), r.errorString().toUtf8().constData());
+    }
+}
+
+void SessionCache::setSession(const QString &storeUri, const StoreSession &session) {
+    auto it = m_stores.find(storeUri);
+    if (it != m_stores.end() && it->folder == session.folder && it->messageId == session.messageId
+        && it->scroll == session.scroll) {
+        return;
+    }
+    m_stores.insert(storeUri, session);
+    m_dirty = true;
+}
+
+void SessionCache::save() {
+    if (!m_dirty) {
+        return;
+    }
+    QSaveFile f(path());
+    if (!f.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QXmlStreamWriter w(&f);
+    w.setAutoFormatting(true);
+    w.writeStartDocument(QStringLiteral("1.0"), true);
+    w.writeStartElement(QStringLiteral("session"));
+    for (auto it = m_stores.constBegin(); it != m_stores.constEnd(); ++it) {
+        w.writeStartElement(QStringLiteral("store"));
+        w.writeAttribute(QStringLiteral("uri"), it.key());
+        if (!it->folder.isEmpty()) w.writeAttribute(QStringLiteral("folder"), it->folder);
+        if (!it->messageId.isEmpty()) w.writeAttribute(QStringLiteral("message"), it->messageId);
+        if (it->scroll >= 0) w.writeAttribute(QStringLiteral("scroll"), QString::number(it->scroll));
+        w.writeEndElement();
+    }
+    w.writeEndElement();
+    w.writeEndDocument();
+    if (f.commit()) {
+        m_dirty = false;
+    }
+}
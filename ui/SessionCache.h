@@ -0,0 +1,58 @@
+/*
+ * SessionCache.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SESSIONCACHE_H
+#define SESSIONCACHE_H
+
+#include <QHash>
+#include <QString>
+
+/** Where the user was in a store. */
+struct StoreSession {
+    QString folder;     // real name of the open folder; empty if none
+    QString messageId;  // selected message; empty if none
+    int scroll = -1;    // message list scroll offset; -1 if not saved
+};
+
+/**
+ * The last open folder, selected message and message list scroll position of each store,
+ * kept across restarts so that selecting a store returns to them. Stored in session.xml in
+ * the cache directory, keyed by store URI.
+ */
+class SessionCache {
+public:
+    /** Load the cache file (missing or unreadable: start empty). */
+    SessionCache();
+
+    StoreSession session(const QString &storeUri) const { return m_stores.value(storeUri); }
+    /** Replace the session for storeUri. */
+    void setSession(const QString &storeUri, const StoreSession &session);
+
+    /** Write the cache file if anything changed since it was loaded or last saved. */
+    void save();
+
+private:
+    static QString path();
+
+    QHash<QString, StoreSession> m_stores;
+    bool m_dirty = false;
+};
+
+#endif // SESSIONCACHE_H
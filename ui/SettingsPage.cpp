@@ -623,7 +623,7 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
                     pop3DisplayNameEdit->setText(entryCopy.displayName);
                     pop3EmailEdit->setText(entryCopy.emailAddress);
                     pop3HostEdit->setText(storeHostOrPath(entryCopy));
-                    pop3PortSpin->setValue(995);
+                    pop3PortSpin->setValue(paramInt(entryCopy, "port", 995));
                     pop3UserEdit->setText(param(entryCopy, "username"));
                     pop3SmtpHostEdit->setText(param(entryCopy, "transportHostname"));
                     pop3SmtpPortSpin->setValue(paramInt(entryCopy, "transportPort", 586));
@@ -730,6 +730,9 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
         }
     }
     viewingLayout->addRow(TR("viewing.resource_load.label") + QStringLiteral(":"), resourceLoadCombo);
+    auto *warmUpStoresCheck = new QCheckBox(viewingPage);
+    warmUpStoresCheck->setChecked(loadConfig().warmUpStores);
+    viewingLayout->addRow(TR("viewing.warm_up_stores") + QStringLiteral(":"), warmUpStoresCheck);
     settingsTabs->addTab(viewingPage, TR("settings.rubric.viewing"));
     QObject::connect(dateFormatCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), [dateFormatCombo](int) {
         Config c = loadConfig();
@@ -743,6 +746,11 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
         saveConfig(c);
         messageView->setResourceLoadPolicy(policy);
     });
+    QObject::connect(warmUpStoresCheck, &QCheckBox::checkStateChanged, [warmUpStoresCheck]() {
+        Config c = loadConfig();
+        c.warmUpStores = warmUpStoresCheck->isChecked();
+        saveConfig(c);
+    });
 
     // Composing tab
     auto *composingPage = new QWidget(settingsPage);
@@ -847,6 +855,7 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
                     break;
                 }
             }
+            warmUpStoresCheck->setChecked(vc.warmUpStores);
         } else if (index == 3) {
             Config c = loadConfig();
             for (int i = 0; i < forwardModeCombo->count(); ++i) {
@@ -965,48 +974,19 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
         if (mb.clickedButton() != deleteConfirmBtn) {
             return;
         }
-        QByteArray idToRemove = ctrl->editingStoreId.toUtf8();
+        const QString idToRemove = ctrl->editingStoreId;
         Config config = loadConfig();
         config.stores.removeIf([&idToRemove](const StoreEntry &e) {
-            return e.id.toUtf8() == idToRemove;
+            return e.id == idToRemove;
         });
         if (config.lastSelectedStoreId == ctrl->editingStoreId) {
             config.lastSelectedStoreId = config.stores.isEmpty() ? QString() : config.stores.first().id;
         }
         saveConfig(config);
-        QByteArray transportUri = ctrl->storeToTransport.value(idToRemove);
-        if (!transportUri.isEmpty()) {
-            tagliacarte_transport_free(transportUri.constData());
-            ctrl->storeToTransport.remove(idToRemove);
-        }
-        ctrl->allStoreUris.removeAll(idToRemove);
-        tagliacarte_store_free(idToRemove.constData());
-        for (int i = 0; i < ctrl->storeButtons.size(); ++i) {
-            if (ctrl->storeButtons[i]->property("storeUri").toByteArray() == idToRemove) {
-                ctrl->storeButtons[i]->deleteLater();
-                ctrl->storeButtons.removeAt(i);
-                break;
-            }
-        }
-        if (ctrl->storeUri == idToRemove) {
-            ctrl->storeUri.clear();
-            ctrl->smtpTransportUri.clear();
-            ctrl->bridge->clearFolder();
-            ctrl->folderTree->clear();
-            ctrl->conversationList->clear();
-            ctrl->messageView->clear();
-            ctrl->messageHeaderPane->hide();
-            if (!ctrl->allStoreUris.isEmpty()) {
-                ctrl->storeUri = ctrl->allStoreUris.first();
-                ctrl->smtpTransportUri = ctrl->storeToTransport.value(ctrl->storeUri);
-                for (int i = 0; i < ctrl->storeButtons.size(); ++i) {
-                    ctrl->storeButtons[i]->setChecked(ctrl->storeButtons[i]->property("storeUri").toByteArray() == ctrl->storeUri);
-                }
-                tagliacarte_store_set_folder_list_callbacks(ctrl->storeUri.constData(), on_folder_found_cb, on_folder_removed_cb, on_folder_list_complete_cb, ctrl->bridge);
-                tagliacarte_store_refresh_folders(ctrl->storeUri.constData());
-            }
-            ctrl->updateComposeAppendButtons();
-        }
+        // Reconciliation frees the store (or drops its creation if still pending) and
+        // selects another one if it was selected
+        ctrl->refreshStoresFromConfig();
+        ctrl->updateComposeAppendButtons();
         ctrl->editingStoreId.clear();
         accountDeleteBtn->setVisible(false);
         accountsStack->setCurrentIndex(0);
@@ -1033,14 +1013,14 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
             QMessageBox::warning(win, TR("accounts.type.maildir"), TR("maildir.validation.select_directory"));
             return;
         }
-        char *uriPtr = tagliacarte_store_maildir_new(path.toUtf8().constData());
+        // The store itself is made (or kept) by refreshStoresFromConfig; only its id is needed here
+        char *uriPtr = tagliacarte_store_maildir_uri(path.toUtf8().constData());
         if (!uriPtr) {
             showError(win, "error.context.maildir");
             return;
         }
         QByteArray newUri(uriPtr);
         tagliacarte_free_string(uriPtr);
-        tagliacarte_store_free(newUri.constData());
         QString displayName = maildirDisplayNameEdit->text().trimmed();
         if (displayName.isEmpty()) {
             displayName = QDir(path).dirName();
@@ -1097,152 +1077,78 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
             QMessageBox::warning(win, TR("accounts.type.imap"), TR("imap.validation.enter_host"));
             return;
         }
-        Config config = loadConfig();
-        const bool isEdit = !ctrl->editingStoreId.isEmpty();
-        const QByteArray previousStoreUri = ctrl->storeUri;
-        int colourIndex = 0;
-        if (isEdit) {
-            for (int i = 0; i < config.stores.size(); ++i) {
-                if (config.stores[i].id == ctrl->editingStoreId) {
-                    colourIndex = i;
-                    break;
-                }
-            }
-        } else {
-            colourIndex = config.stores.size();
-        }
         QString userAtHost = imapUser;
         if (!imapUser.contains(QLatin1Char('@')) && !imapHost.isEmpty()) {
             userAtHost = imapUser + QLatin1Char('@') + imapHost;
         }
-        char *uriPtr = tagliacarte_store_imap_new(userAtHost.toUtf8().constData(), imapHost.toUtf8().constData(), static_cast<uint16_t>(imapPort));
+        // The store itself is made (or kept) by refreshStoresFromConfig; only its id is needed here
+        char *uriPtr = tagliacarte_store_imap_uri(userAtHost.toUtf8().constData(), imapHost.toUtf8().constData(), static_cast<uint16_t>(imapPort));
         if (!uriPtr) {
             showError(win, "error.context.imap");
             return;
         }
-        ctrl->storeUri = QByteArray(uriPtr);
+        QString newId = QString::fromUtf8(uriPtr);
         tagliacarte_free_string(uriPtr);
+        QString transportId;
+        if (!smtpHost.isEmpty()) {
+            char *tUri = tagliacarte_transport_smtp_uri(smtpHost.toUtf8().constData(), static_cast<uint16_t>(smtpPort));
+            if (tUri) {
+                transportId = QString::fromUtf8(tUri);
+                tagliacarte_free_string(tUri);
+            }
+        }
         if (displayName.isEmpty()) {
             displayName = imapUser;
         }
         if (displayName.isEmpty()) {
             displayName = TR("accounts.type.imap");
         }
-        if (isEdit) {
-            QByteArray oldUri = ctrl->editingStoreId.toUtf8();
-            tagliacarte_store_free(oldUri.constData());
-            ctrl->storeToTransport.remove(oldUri);
-            ctrl->allStoreUris.removeAll(oldUri);
-            for (int i = 0; i < ctrl->storeButtons.size(); ++i) {
-                if (ctrl->storeButtons[i]->property("storeUri").toByteArray() == oldUri) {
-                    ctrl->storeButtons[i]->deleteLater();
-                    ctrl->storeButtons.removeAt(i);
-                    break;
-                }
-            }
-            if (previousStoreUri == oldUri) {
-                ctrl->bridge->clearFolder();
-                ctrl->folderTree->clear();
-                ctrl->conversationList->clear();
-                ctrl->messageView->clear();
-                ctrl->messageHeaderPane->hide();
-            }
-        } else {
-            ctrl->bridge->clearFolder();
-            ctrl->folderTree->clear();
-            ctrl->conversationList->clear();
-            ctrl->messageView->clear();
-            ctrl->messageHeaderPane->hide();
-        }
-        ctrl->allStoreUris.append(ctrl->storeUri);
-        tagliacarte_store_set_folder_list_callbacks(ctrl->storeUri.constData(), on_folder_found_cb, on_folder_removed_cb, on_folder_list_complete_cb, ctrl->bridge);
-        tagliacarte_store_refresh_folders(ctrl->storeUri.constData());
-        QString initial = displayName.left(1).toUpper();
-        if (initial.isEmpty()) {
-            initial = QStringLiteral("I");
-        }
-        ctrl->addStoreCircle(initial, ctrl->storeUri, colourIndex);
-        for (auto *b : ctrl->storeButtons) {
-            b->setChecked(b->property("storeUri").toByteArray() == ctrl->storeUri);
-        }
-        ctrl->smtpTransportUri.clear();
-        if (!smtpHost.isEmpty()) {
-            char *transportUri = tagliacarte_transport_smtp_new(smtpHost.toUtf8().constData(), static_cast<uint16_t>(smtpPort));
-            if (transportUri) {
-                ctrl->smtpTransportUri = QByteArray(transportUri);
-                tagliacarte_free_string(transportUri);
-                ctrl->storeToTransport[ctrl->storeUri] = ctrl->smtpTransportUri;
+        Config config = loadConfig();
+        QString oldId = ctrl->editingStoreId;
+        int idx = -1;
+        for (int i = 0; !oldId.isEmpty() && i < config.stores.size(); ++i) {
+            if (config.stores[i].id == oldId) {
+                idx = i;
+                break;
             }
         }
-        ctrl->updateComposeAppendButtons();
-        if (isEdit) {
-            int idx = -1;
-            for (int i = 0; i < config.stores.size(); ++i) {
-                if (config.stores[i].id == ctrl->editingStoreId) {
-                    idx = i;
-                    break;
-                }
-            }
-            if (idx >= 0) {
-                StoreEntry &e = config.stores[idx];
-                e.id = QString::fromUtf8(ctrl->storeUri);
-                e.type = QStringLiteral("imap");
-                e.displayName = displayName;
-                e.emailAddress = imapEmailEdit->text().trimmed();
-                e.params[QStringLiteral("hostname")] = imapHost;
-                e.params[QStringLiteral("username")] = userAtHost;
-                e.params[QStringLiteral("port")] = QString::number(imapPortSpin->value());
-                e.params[QStringLiteral("security")] = QString::number(imapSecurityCombo->currentIndex());
-                const int pollSeconds[] = { 60, 300, 600, 3600 };
-                e.params[QStringLiteral("imapPollSeconds")] = QString::number((imapPollCombo->currentIndex() >= 0 && imapPollCombo->currentIndex() < 4) ? pollSeconds[imapPollCombo->currentIndex()] : 300);
-                e.params[QStringLiteral("imapDeletion")] = QString::number(imapDeletionCombo->currentIndex());
-                e.params[QStringLiteral("imapTrashFolder")] = imapTrashFolderEdit->text().trimmed();
-                const int idleSeconds[] = { 30, 60, 300 };
-                e.params[QStringLiteral("imapIdleSeconds")] = QString::number((imapIdleCombo->currentIndex() >= 0 && imapIdleCombo->currentIndex() < 3) ? idleSeconds[imapIdleCombo->currentIndex()] : 60);
-                if (!smtpHost.isEmpty()) {
-                    e.params[QStringLiteral("transportId")] = QString::fromUtf8(ctrl->smtpTransportUri);
-                    e.params[QStringLiteral("transportHostname")] = smtpHost;
-                    e.params[QStringLiteral("transportPort")] = QString::number(smtpPortSpin->value());
-                    e.params[QStringLiteral("transportSecurity")] = QString::number(smtpSecurityCombo->currentIndex());
-                    e.params[QStringLiteral("transportUsername")] = smtpUserEdit->text().trimmed();
-                } else {
-                    e.params.remove(QStringLiteral("transportId"));
-                    e.params.remove(QStringLiteral("transportHostname"));
-                    e.params.remove(QStringLiteral("transportPort"));
-                    e.params.remove(QStringLiteral("transportSecurity"));
-                    e.params.remove(QStringLiteral("transportUsername"));
-                }
-                if (config.lastSelectedStoreId == ctrl->editingStoreId) {
-                    config.lastSelectedStoreId = e.id;
-                }
-            }
+        if (idx < 0) {
+            idx = config.stores.size();
+            config.stores.append(StoreEntry());
+            config.lastSelectedStoreId = newId;
+        } else if (config.lastSelectedStoreId == oldId) {
+            config.lastSelectedStoreId = newId;
+        }
+        StoreEntry &e = config.stores[idx];
+        e.id = newId;
+        e.type = QStringLiteral("imap");
+        e.displayName = displayName;
+        e.emailAddress = imapEmailEdit->text().trimmed();
+        e.params[QStringLiteral("hostname")] = imapHost;
+        e.params[QStringLiteral("username")] = userAtHost;
+        e.params[QStringLiteral("port")] = QString::number(imapPort);
+        e.params[QStringLiteral("security")] = QString::number(imapSecurityCombo->currentIndex());
+        const int pollSeconds[] = { 60, 300, 600, 3600 };
+        e.params[QStringLiteral("imapPollSeconds")] = QString::number((imapPollCombo->currentIndex() >= 0 && imapPollCombo->currentIndex() < 4) ? pollSeconds[imapPollCombo->currentIndex()] : 300);
+        e.params[QStringLiteral("imapDeletion")] = QString::number(imapDeletionCombo->currentIndex());
+        e.params[QStringLiteral("imapTrashFolder")] = imapTrashFolderEdit->text().trimmed();
+        const int idleSeconds[] = { 30, 60, 300 };
+        e.params[QStringLiteral("imapIdleSeconds")] = QString::number((imapIdleCombo->currentIndex() >= 0 && imapIdleCombo->currentIndex() < 3) ? idleSeconds[imapIdleCombo->currentIndex()] : 60);
+        if (!smtpHost.isEmpty()) {
+            e.params[QStringLiteral("transportId")] = transportId;
+            e.params[QStringLiteral("transportHostname")] = smtpHost;
+            e.params[QStringLiteral("transportPort")] = QString::number(smtpPort);
+            e.params[QStringLiteral("transportSecurity")] = QString::number(smtpSecurityCombo->currentIndex());
+            e.params[QStringLiteral("transportUsername")] = smtpUserEdit->text().trimmed();
         } else {
-            StoreEntry entry;
-            entry.id = QString::fromUtf8(ctrl->storeUri);
-            entry.type = QStringLiteral("imap");
-            entry.displayName = displayName;
-            entry.emailAddress = imapEmailEdit->text().trimmed();
-            entry.params[QStringLiteral("hostname")] = imapHost;
-            entry.params[QStringLiteral("username")] = userAtHost;
-            entry.params[QStringLiteral("port")] = QString::number(imapPortSpin->value());
-            entry.params[QStringLiteral("security")] = QString::number(imapSecurityCombo->currentIndex());
-            const int pollSeconds[] = { 60, 300, 600, 3600 };
-            entry.params[QStringLiteral("imapPollSeconds")] = QString::number((imapPollCombo->currentIndex() >= 0 && imapPollCombo->currentIndex() < 4) ? pollSeconds[imapPollCombo->currentIndex()] : 300);
-            entry.params[QStringLiteral("imapDeletion")] = QString::number(imapDeletionCombo->currentIndex());
-            entry.params[QStringLiteral("imapTrashFolder")] = imapTrashFolderEdit->text().trimmed();
-            const int idleSeconds[] = { 30, 60, 300 };
-            entry.params[QStringLiteral("imapIdleSeconds")] = QString::number((imapIdleCombo->currentIndex() >= 0 && imapIdleCombo->currentIndex() < 3) ? idleSeconds[imapIdleCombo->currentIndex()] : 60);
-            if (!smtpHost.isEmpty()) {
-                entry.params[QStringLiteral("transportId")] = QString::fromUtf8(ctrl->smtpTransportUri);
-                entry.params[QStringLiteral("transportHostname")] = smtpHost;
-                entry.params[QStringLiteral("transportPort")] = QString::number(smtpPortSpin->value());
-                entry.params[QStringLiteral("transportSecurity")] = QString::number(smtpSecurityCombo->currentIndex());
-                entry.params[QStringLiteral("transportUsername")] = smtpUserEdit->text().trimmed();
-            }
-            config.stores.append(entry);
-            config.lastSelectedStoreId = entry.id;
+            e.params.remove(QStringLiteral("transportId"));
+            e.params.remove(QStringLiteral("transportHostname"));
+            e.params.remove(QStringLiteral("transportPort"));
+            e.params.remove(QStringLiteral("transportSecurity"));
+            e.params.remove(QStringLiteral("transportUsername"));
         }
         saveConfig(config);
+        ctrl->refreshStoresFromConfig();
         ctrl->editingStoreId.clear();
         win->statusBar()->showMessage(TR("status.added_imap"));
         accountsStack->setCurrentIndex(0);
@@ -1259,135 +1165,71 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
             QMessageBox::warning(win, TR("accounts.type.pop3"), TR("imap.validation.enter_host"));
             return;
         }
-        Config config = loadConfig();
-        const bool isEdit = !ctrl->editingStoreId.isEmpty();
-        const QByteArray previousStoreUri = ctrl->storeUri;
-        int colourIndex = 0;
-        if (isEdit) {
-            for (int i = 0; i < config.stores.size(); ++i) {
-                if (config.stores[i].id == ctrl->editingStoreId) {
-                    colourIndex = i;
-                    break;
-                }
-            }
-        } else {
-            colourIndex = config.stores.size();
-        }
         QString userAtHost = pop3User;
         if (!pop3User.contains(QLatin1Char('@')) && !pop3Host.isEmpty()) {
             userAtHost = pop3User + QLatin1Char('@') + pop3Host;
         }
-        char *uriPtr = tagliacarte_store_pop3_new(userAtHost.toUtf8().constData(), pop3Host.toUtf8().constData(), static_cast<uint16_t>(pop3Port));
+        // The store itself is made (or kept) by refreshStoresFromConfig; only its id is needed here
+        char *uriPtr = tagliacarte_store_pop3_uri(userAtHost.toUtf8().constData(), pop3Host.toUtf8().constData(), static_cast<uint16_t>(pop3Port));
         if (!uriPtr) {
             showError(win, "error.context.imap");
             return;
         }
-        ctrl->storeUri = QByteArray(uriPtr);
+        QString newId = QString::fromUtf8(uriPtr);
         tagliacarte_free_string(uriPtr);
+        QString pop3SmtpHost = pop3SmtpHostEdit->text().trimmed();
+        int pop3SmtpPort = pop3SmtpPortSpin->value();
+        QString transportId;
+        if (!pop3SmtpHost.isEmpty()) {
+            char *tUri = tagliacarte_transport_smtp_uri(pop3SmtpHost.toUtf8().constData(), static_cast<uint16_t>(pop3SmtpPort));
+            if (tUri) {
+                transportId = QString::fromUtf8(tUri);
+                tagliacarte_free_string(tUri);
+            }
+        }
         if (displayName.isEmpty()) {
             displayName = pop3User;
         }
         if (displayName.isEmpty()) {
             displayName = TR("accounts.type.pop3");
         }
-        if (isEdit) {
-            QByteArray oldUri = ctrl->editingStoreId.toUtf8();
-            tagliacarte_store_free(oldUri.constData());
-            ctrl->storeToTransport.remove(oldUri);
-            ctrl->allStoreUris.removeAll(oldUri);
-            for (int i = 0; i < ctrl->storeButtons.size(); ++i) {
-                if (ctrl->storeButtons[i]->property("storeUri").toByteArray() == oldUri) {
-                    ctrl->storeButtons[i]->deleteLater();
-                    ctrl->storeButtons.removeAt(i);
-                    break;
-                }
-            }
-            if (previousStoreUri == oldUri) {
-                ctrl->bridge->clearFolder();
-                ctrl->folderTree->clear();
-                ctrl->conversationList->clear();
-                ctrl->messageView->clear();
-                ctrl->messageHeaderPane->hide();
-            }
-        } else {
-            ctrl->bridge->clearFolder();
-            ctrl->folderTree->clear();
-            ctrl->conversationList->clear();
-            ctrl->messageView->clear();
-            ctrl->messageHeaderPane->hide();
-        }
-        ctrl->allStoreUris.append(ctrl->storeUri);
-        tagliacarte_store_set_folder_list_callbacks(ctrl->storeUri.constData(), on_folder_found_cb, on_folder_removed_cb, on_folder_list_complete_cb, ctrl->bridge);
-        tagliacarte_store_refresh_folders(ctrl->storeUri.constData());
-        QString initial = displayName.left(1).toUpper();
-        if (initial.isEmpty()) {
-            initial = QStringLiteral("P");
-        }
-        ctrl->addStoreCircle(initial, ctrl->storeUri, colourIndex);
-        for (auto *b : ctrl->storeButtons) {
-            b->setChecked(b->property("storeUri").toByteArray() == ctrl->storeUri);
-        }
-        ctrl->smtpTransportUri.clear();
-        QString pop3SmtpHost = pop3SmtpHostEdit->text().trimmed();
-        int pop3SmtpPort = pop3SmtpPortSpin->value();
-        if (!pop3SmtpHost.isEmpty()) {
-            char *transportUri = tagliacarte_transport_smtp_new(pop3SmtpHost.toUtf8().constData(), static_cast<uint16_t>(pop3SmtpPort));
-            if (transportUri) {
-                ctrl->smtpTransportUri = QByteArray(transportUri);
-                tagliacarte_free_string(transportUri);
-                ctrl->storeToTransport[ctrl->storeUri] = ctrl->smtpTransportUri;
+        Config config = loadConfig();
+        QString oldId = ctrl->editingStoreId;
+        int idx = -1;
+        for (int i = 0; !oldId.isEmpty() && i < config.stores.size(); ++i) {
+            if (config.stores[i].id == oldId) {
+                idx = i;
+                break;
             }
         }
-        ctrl->updateComposeAppendButtons();
-        if (isEdit) {
-            int idx = -1;
-            for (int i = 0; i < config.stores.size(); ++i) {
-                if (config.stores[i].id == ctrl->editingStoreId) {
-                    idx = i;
-                    break;
-                }
-            }
-            if (idx >= 0) {
-                StoreEntry &e = config.stores[idx];
-                e.id = QString::fromUtf8(ctrl->storeUri);
-                e.type = QStringLiteral("pop3");
-                e.displayName = displayName;
-                e.emailAddress = pop3EmailEdit->text().trimmed();
-                e.params[QStringLiteral("hostname")] = pop3Host;
-                e.params[QStringLiteral("username")] = userAtHost;
-                if (!pop3SmtpHost.isEmpty()) {
-                    e.params[QStringLiteral("transportId")] = QString::fromUtf8(ctrl->smtpTransportUri);
-                    e.params[QStringLiteral("transportHostname")] = pop3SmtpHost;
-                    e.params[QStringLiteral("transportPort")] = QString::number(pop3SmtpPortSpin->value());
-                    e.params[QStringLiteral("transportUsername")] = pop3SmtpUserEdit->text().trimmed();
-                } else {
-                    e.params.remove(QStringLiteral("transportId"));
-                    e.params.remove(QStringLiteral("transportHostname"));
-                    e.params.remove(QStringLiteral("transportPort"));
-                    e.params.remove(QStringLiteral("transportUsername"));
-                }
-                if (config.lastSelectedStoreId == ctrl->editingStoreId) {
-                    config.lastSelectedStoreId = e.id;
-                }
-            }
+        if (idx < 0) {
+            idx = config.stores.size();
+            config.stores.append(StoreEntry());
+            config.lastSelectedStoreId = newId;
+        } else if (config.lastSelectedStoreId == oldId) {
+            config.lastSelectedStoreId = newId;
+        }
+        StoreEntry &e = config.stores[idx];
+        e.id = newId;
+        e.type = QStringLiteral("pop3");
+        e.displayName = displayName;
+        e.emailAddress = pop3EmailEdit->text().trimmed();
+        e.params[QStringLiteral("hostname")] = pop3Host;
+        e.params[QStringLiteral("username")] = userAtHost;
+        e.params[QStringLiteral("port")] = QString::number(pop3Port);
+        if (!pop3SmtpHost.isEmpty()) {
+            e.params[QStringLiteral("transportId")] = transportId;
+            e.params[QStringLiteral("transportHostname")] = pop3SmtpHost;
+            e.params[QStringLiteral("transportPort")] = QString::number(pop3SmtpPort);
+            e.params[QStringLiteral("transportUsername")] = pop3SmtpUserEdit->text().trimmed();
         } else {
-            StoreEntry entry;
-            entry.id = QString::fromUtf8(ctrl->storeUri);
-            entry.type = QStringLiteral("pop3");
-            entry.displayName = displayName;
-            entry.emailAddress = pop3EmailEdit->text().trimmed();
-            entry.params[QStringLiteral("hostname")] = pop3Host;
-            entry.params[QStringLiteral("username")] = userAtHost;
-            if (!pop3SmtpHost.isEmpty()) {
-                entry.params[QStringLiteral("transportId")] = QString::fromUtf8(ctrl->smtpTransportUri);
-                entry.params[QStringLiteral("transportHostname")] = pop3SmtpHost;
-                entry.params[QStringLiteral("transportPort")] = QString::number(pop3SmtpPortSpin->value());
-                entry.params[QStringLiteral("transportUsername")] = pop3SmtpUserEdit->text().trimmed();
-            }
-            config.stores.append(entry);
-            config.lastSelectedStoreId = entry.id;
+            e.params.remove(QStringLiteral("transportId"));
+            e.params.remove(QStringLiteral("transportHostname"));
+            e.params.remove(QStringLiteral("transportPort"));
+            e.params.remove(QStringLiteral("transportUsername"));
         }
         saveConfig(config);
+        ctrl->refreshStoresFromConfig();
         ctrl->editingStoreId.clear();
         win->statusBar()->showMessage(TR("status.added_pop3"));
         accountsStack->setCurrentIndex(0);
@@ -1528,24 +1370,14 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
             QMessageBox::warning(win, TR("accounts.type.nostr"), TR("nostr.validation.key_required"));
             return;
         }
-        QByteArray relaysUtf8 = relays.toUtf8();
-        QByteArray pubkeyUtf8 = pubkeyHex.toUtf8();
-        char *uriPtr = tagliacarte_store_nostr_new(relaysUtf8.constData(), pubkeyUtf8.constData());
+        // The store itself is made (or kept) by refreshStoresFromConfig; only its id is needed here
+        char *uriPtr = tagliacarte_store_nostr_uri(pubkeyHex.toUtf8().constData());
         if (!uriPtr) {
             showError(win, "error.context.nostr");
             return;
         }
         QByteArray newStoreUri(uriPtr);
         tagliacarte_free_string(uriPtr);
-        if (!secretText.isEmpty()) {
-            tagliacarte_credential_provide(newStoreUri.constData(), secretText.toUtf8().constData());
-        }
-        char *transportUriPtr = tagliacarte_transport_nostr_new(relaysUtf8.constData(), pubkeyUtf8.constData());
-        QByteArray newTransportUri;
-        if (transportUriPtr) {
-            newTransportUri = QByteArray(transportUriPtr);
-            tagliacarte_free_string(transportUriPtr);
-        }
         QString displayName = nostrDisplayNameEdit->text().trimmed();
         if (displayName.isEmpty()) {
             displayName = TR("accounts.type.nostr");
@@ -1589,6 +1421,9 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
         }
         saveConfig(config);
         ctrl->refreshStoresFromConfig();
+        if (!secretText.isEmpty()) {
+            ctrl->provideCredential(QString::fromUtf8(newStoreUri), secretText);
+        }
         ctrl->editingStoreId.clear();
         win->statusBar()->showMessage(TR("status.added_nostr"));
         accountsStack->setCurrentIndex(0);
@@ -1603,19 +1438,14 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
             QMessageBox::warning(win, TR("accounts.type.matrix"), TR("matrix.validation.homeserver_user"));
             return;
         }
-        char *uriPtr = tagliacarte_store_matrix_new(homeserver.toUtf8().constData(), userId.toUtf8().constData(), nullptr);
+        // The store itself is made (or kept) by refreshStoresFromConfig; only its id is needed here
+        char *uriPtr = tagliacarte_store_matrix_uri(homeserver.toUtf8().constData(), userId.toUtf8().constData());
         if (!uriPtr) {
             showError(win, "error.context.matrix");
             return;
         }
         QByteArray newStoreUri(uriPtr);
         tagliacarte_free_string(uriPtr);
-        char *transportUriPtr = tagliacarte_transport_matrix_new(homeserver.toUtf8().constData(), userId.toUtf8().constData(), nullptr);
-        QByteArray newTransportUri;
-        if (transportUriPtr) {
-            newTransportUri = QByteArray(transportUriPtr);
-            tagliacarte_free_string(transportUriPtr);
-        }
         QString displayName = matrixDisplayNameEdit->text().trimmed();
         if (displayName.isEmpty()) {
             displayName = userId;
@@ -1677,14 +1507,15 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
         if (userAtHost.isEmpty()) {
             userAtHost = nntpHost;
         }
-        char *uriPtr = tagliacarte_store_nntp_new(userAtHost.toUtf8().constData(), nntpHost.toUtf8().constData(), static_cast<uint16_t>(nntpPort));
+        // The store itself is made (or kept) by refreshStoresFromConfig; only its id is needed here
+        char *uriPtr = tagliacarte_store_nntp_uri(userAtHost.toUtf8().constData(), nntpHost.toUtf8().constData(), static_cast<uint16_t>(nntpPort));
         if (!uriPtr) {
             showError(win, "error.context.nntp");
             return;
         }
         QByteArray newStoreUri(uriPtr);
         tagliacarte_free_string(uriPtr);
-        char *tUri = tagliacarte_transport_nntp_new(userAtHost.toUtf8().constData(), nntpHost.toUtf8().constData(), static_cast<uint16_t>(nntpPort));
+        char *tUri = tagliacarte_transport_nntp_uri(userAtHost.toUtf8().constData(), nntpHost.toUtf8().constData(), static_cast<uint16_t>(nntpPort));
         QByteArray newTransportUri;
         if (tUri) {
             newTransportUri = QByteArray(tUri);
@@ -1796,7 +1627,8 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
         if (email.isEmpty()) {
             return;
         }
-        char *uriPtr = tagliacarte_store_gmail_new(email.toUtf8().constData());
+        // The store itself is made (or kept) by refreshStoresFromConfig; only its id is needed here
+        char *uriPtr = tagliacarte_store_gmail_uri(email.toUtf8().constData());
         if (!uriPtr) {
             showError(win, "error.context.gmail");
             gmailStatusLabel->setText(TR("gmail.status.error"));
@@ -1805,12 +1637,6 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
         }
         QByteArray newStoreUri(uriPtr);
         tagliacarte_free_string(uriPtr);
-        char *transportUriPtr = tagliacarte_transport_gmail_smtp_new(email.toUtf8().constData());
-        QByteArray newTransportUri;
-        if (transportUriPtr) {
-            newTransportUri = QByteArray(transportUriPtr);
-            tagliacarte_free_string(transportUriPtr);
-        }
         QString displayName = gmailDisplayNameEdit->text().trimmed();
         if (displayName.isEmpty()) {
             displayName = email;
@@ -1887,7 +1713,8 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
         if (email.isEmpty()) {
             return;
         }
-        char *uriPtr = tagliacarte_store_graph_new(email.toUtf8().constData());
+        // The store itself is made (or kept) by refreshStoresFromConfig; only its id is needed here
+        char *uriPtr = tagliacarte_store_graph_uri(email.toUtf8().constData());
         if (!uriPtr) {
             showError(win, "error.context.exchange");
             exchangeStatusLabel->setText(TR("exchange.status.error"));
@@ -1896,12 +1723,6 @@ QWidget *buildSettingsPage(MainController *ctrl, QMainWindow *win, const char *v
         }
         QByteArray newStoreUri(uriPtr);
         tagliacarte_free_string(uriPtr);
-        char *transportUriPtr = tagliacarte_transport_graph_new(email.toUtf8().constData());
-        QByteArray newTransportUri;
-        if (transportUriPtr) {
-            newTransportUri = QByteArray(transportUriPtr);
-            tagliacarte_free_string(transportUriPtr);
-        }
         QString displayName = exchangeDisplayNameEdit->text().trimmed();
         if (displayName.isEmpty()) {
             displayName = email;
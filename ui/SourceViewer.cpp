@@ -0,0 +1,129 @@
+/*
+ * SourceViewer.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SourceViewer.h"
+#include "Tr.h"
+
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QScrollBar>
+#include <climits>
+#include <cstring>
+
+static constexpr int Margin = 4;
+
+SourceViewer::SourceViewer(QWidget *parent)
+    : QAbstractScrollArea(parent)
+{
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    viewport()->setBackgroundRole(QPalette::Base);
+    viewport()->setAutoFillBackground(true);
+    m_lineStarts.append(0);
+    m_status = TR("status.loading");
+}
+
+void SourceViewer::appendData(const QByteArray &chunk) {
+    if (chunk.isEmpty()) {
+        return;
+    }
+    qsizetype scan = m_data.size();
+    if (m_data.isEmpty()) {
+        m_data = chunk; // shares the chunk: local stores deliver the whole source at once
+    } else {
+        m_data.append(chunk);
+    }
+    const char *base = m_data.constData();
+    qsizetype end = m_data.size();
+    while (scan < end) {
+        const void *nl = std::memchr(base + scan, '\n', static_cast<size_t>(end - scan));
+        if (!nl) {
+            break;
+        }
+        qsizetype next = static_cast<const char *>(nl) - base + 1;
+        m_longestLine = qMax(m_longestLine, next - m_lineStarts.last());
+        m_lineStarts.append(next);
+        scan = next;
+    }
+    m_longestLine = qMax(m_longestLine, end - m_lineStarts.last());
+    updateScrollBars();
+    viewport()->update();
+}
+
+void SourceViewer::setFinished(bool ok) {
+    m_status = (!ok && m_data.isEmpty()) ? TR("source.load_error") : QString();
+    viewport()->update();
+}
+
+int SourceViewer::lineCount() const {
+    // A trailing newline does not start another visible line
+    int n = static_cast<int>(m_lineStarts.size());
+    return (n > 1 && m_lineStarts.last() == m_data.size()) ? n - 1 : n;
+}
+
+void SourceViewer::updateScrollBars() {
+    QFontMetrics fm(font());
+    int lineHeight = fm.lineSpacing();
+    int pageLines = qMax(1, viewport()->height() / lineHeight);
+    verticalScrollBar()->setPageStep(pageLines);
+    verticalScrollBar()->setSingleStep(1);
+    verticalScrollBar()->setRange(0, qMax(0, lineCount() - pageLines));
+    int charWidth = fm.horizontalAdvance(QLatin1Char('M'));
+    qint64 contentWidth = qint64(m_longestLine) * charWidth + 2 * Margin;
+    int maxX = static_cast<int>(qMin<qint64>(contentWidth - viewport()->width(), INT_MAX / 2));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setSingleStep(charWidth * 4);
+    horizontalScrollBar()->setRange(0, qMax(0, maxX));
+}
+
+void SourceViewer::resizeEvent(QResizeEvent *event) {
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void SourceViewer::paintEvent(QPaintEvent *) {
+    QPainter painter(viewport());
+    painter.setFont(font());
+    painter.setPen(palette().color(QPalette::Text));
+    QFontMetrics fm(font());
+    if (m_data.isEmpty()) {
+        painter.drawText(viewport()->rect().adjusted(Margin, Margin, -Margin, -Margin),
+            Qt::AlignLeft | Qt::AlignTop, m_status);
+        return;
+    }
+    int lineHeight = fm.lineSpacing();
+    int charWidth = qMax(1, fm.horizontalAdvance(QLatin1Char('M')));
+    int xOffset = horizontalScrollBar()->value();
+    // Decode only the part of each line that can reach the viewport (at most 4 bytes per char)
+    qsizetype maxBytes = qsizetype(xOffset + viewport()->width()) / charWidth * 4 + 4;
+    int first = verticalScrollBar()->value();
+    int last = qMin(lineCount(), first + viewport()->height() / lineHeight + 2);
+    int y = Margin + fm.ascent();
+    for (int i = first; i < last; ++i, y += lineHeight) {
+        qsizetype start = m_lineStarts[i];
+        qsizetype end = (i + 1 < m_lineStarts.size()) ? m_lineStarts[i + 1] : m_data.size();
+        while (end > start && (m_data[end - 1] == '\n' || m_data[end - 1] == '\r')) {
+            --end;
+        }
+        QString text = QString::fromUtf8(m_data.constData() + start, qMin(end - start, maxBytes));
+        text.replace(QLatin1Char('\t'), QStringLiteral("    "));
+        painter.drawText(Margin - xOffset, y, text);
+    }
+}
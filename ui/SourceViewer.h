@@ -0,0 +1,61 @@
+/*
+ * SourceViewer.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOURCEVIEWER_H
+#define SOURCEVIEWER_H
+
+#include <QAbstractScrollArea>
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+/**
+ * Read-only viewer for raw message source.
+ *
+ * Keeps the bytes as they arrived plus an index of line starts, and paints only the lines
+ * in the viewport, decoding each as it is drawn. Opening a very large message costs one
+ * pass to find newlines; there is no document layout.
+ */
+class SourceViewer : public QAbstractScrollArea {
+    Q_OBJECT
+public:
+    explicit SourceViewer(QWidget *parent = nullptr);
+
+    /** Append the next chunk of source. */
+    void appendData(const QByteArray &chunk);
+
+    /** Loading finished; on error, a message is shown if nothing was received. */
+    void setFinished(bool ok);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void updateScrollBars();
+    int lineCount() const;
+
+    QByteArray m_data;
+    QVector<qsizetype> m_lineStarts;    // byte offset of each line
+    qsizetype m_longestLine = 0;        // bytes, for the horizontal range
+    QString m_status;                   // shown instead of the source while empty
+};
+
+#endif // SOURCEVIEWER_H
@@ -0,0 +1,136 @@
+/*
+ * Trace.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Trace.h"
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <atomic>
+
+/*
+ * Each slot is guarded by a sequence number, seqlock style: 0 while a writer fills it, then
+ * 1 + the index of the span it holds. A reader keeps a slot only if the sequence is the same
+ * before and after copying it. Fields are relaxed atomics so a torn read is merely discarded.
+ */
+struct Slot {
+    std::atomic<quint64> seq{0};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<qint64> startUs{0};
+    std::atomic<qint64> durationUs{0};
+    std::atomic<quint32> thread{0};
+    std::atomic<qint64> value{-1};
+};
+
+static Slot s_slots[Trace::Capacity];
+static std::atomic<quint64> s_next{0};          // index of the next span
+static std::atomic<quint64> s_clearedBefore{0}; // spans below this index were cleared
+static std::atomic<quint32> s_threadCount{0};
+
+static const QElapsedTimer &traceClock() {
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return timer;
+}
+
+// Start the clock at load time, so that spans measured from 0 cover startup
+[[maybe_unused]] static const QElapsedTimer &s_clockStarted = traceClock();
+
+static quint32 threadNumber() {
+    thread_local const quint32 number = ++s_threadCount;
+    return number;
+}
+
+qint64 Trace::now() {
+    return traceClock().nsecsElapsed() / 1000;
+}
+
+void Trace::record(const char *name, qint64 startUs, qint64 value) {
+    const qint64 end = now();
+    const quint64 index = s_next.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = s_slots[index % Capacity];
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startUs.store(startUs, std::memory_order_relaxed);
+    slot.durationUs.store(end - startUs, std::memory_order_relaxed);
+    slot.thread.store(threadNumber(), std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.seq.store(index + 1, std::memory_order_release);
+}
+
+QVector<TraceEvent> Trace::snapshot() {
+    const quint64 next = s_next.load(std::memory_order_acquire);
+    const quint64 cleared = s_clearedBefore.load(std::memory_order_relaxed);
+    quint64 first = next > quint64(Capacity) ? next - Capacity : 0;
+    if (first < cleared) {
+        first = cleared;
+    }
+    QVector<TraceEvent> events;
+    events.reserve(static_cast<int>(next - first));
+    for (quint64 index = first; index < next; ++index) {
+        const Slot &slot = s_slots[index % Capacity];
+        if (slot.seq.load(std::memory_order_acquire) != index + 1) {
+            continue;  // still being written, or already overwritten
+        }
+        TraceEvent event;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.startUs = slot.startUs.load(std::memory_order_relaxed);
+        event.durationUs = slot.durationUs.load(std::memory_order_relaxed);
+        event.thread = slot.thread.load(std::memory_order_relaxed);
+        event.value = slot.value.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != index + 1) {
+            continue;
+        }
+        events.append(event);
+    }
+    return events;
+}
+
+void Trace::clear() {
+    s_clearedBefore.store(s_next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+QByteArray Trace::toChromeJson(const QVector<TraceEvent> &events) {
+    QJsonArray array;
+    for (const TraceEvent &event : events) {
+        QJsonObject o;
+        o.insert(QStringLiteral("name"), QString::fromLatin1(event.name));
+        o.insert(QStringLiteral("cat"), QStringLiteral("tagliacarte"));
+        o.insert(QStringLiteral("ph"), QStringLiteral("X"));
+        o.insert(QStringLiteral("ts"), event.startUs);
+        o.insert(QStringLiteral("dur"), event.durationUs);
+        o.insert(QStringLiteral("pid"), 1);
+        o.insert(QStringLiteral("tid"), static_cast<qint64>(event.thread));
+        if (event.value >= 0) {
+            o.insert(QStringLiteral("args"), QJsonObject{{QStringLiteral("value"), event.value}});
+        }
+        array.append(o);
+    }
+    QJsonObject root;
+    root.insert(QStringLiteral("traceEvents"), array);
+    root.insert(QStringLiteral("displayTimeUnit"), QStringLiteral("ms"));
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,77 @@
+/*
+ * Trace.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QtGlobal>
+
+/** A recorded span. Times are microseconds on the trace clock, which starts with the process. */
+struct TraceEvent {
+    const char *name = nullptr;
+    qint64 startUs = 0;
+    qint64 durationUs = 0;
+    quint32 thread = 0;     // small per-thread number, in order of first use
+    qint64 value = -1;      // optional count (rows, bytes); -1 if none
+};
+
+/**
+ * Latency trace: spans around the stages between startup or a click and what ends up on
+ * screen (store creation, folder list, SELECT, summary stream, MIME events, setHtml, layout).
+ *
+ * Recording is lock-free and does not allocate, so it is always on: each span claims the next
+ * slot of a fixed ring and the oldest spans are overwritten. Names must be string literals.
+ * The trace panel reads a snapshot; it can be exported as Chrome trace JSON.
+ */
+class Trace {
+public:
+    static constexpr int Capacity = 4096;
+
+    /** Current time on the trace clock, in microseconds. */
+    static qint64 now();
+    /** Record a span from startUs (see now()) until now. Any thread. */
+    static void record(const char *name, qint64 startUs, qint64 value = -1);
+
+    /** The spans currently in the ring, oldest first. */
+    static QVector<TraceEvent> snapshot();
+    /** Forget the spans recorded so far. */
+    static void clear();
+    /** Chrome trace event format (chrome://tracing, Perfetto). */
+    static QByteArray toChromeJson(const QVector<TraceEvent> &events);
+};
+
+/** Records a span covering its own lifetime. */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char *name) : m_name(name), m_startUs(Trace::now()) {}
+    ~TraceSpan() { Trace::record(m_name, m_startUs, m_value); }
+    Q_DISABLE_COPY(TraceSpan)
+
+    void setValue(qint64 value) { m_value = value; }
+
+private:
+    const char *m_name;
+    qint64 m_startUs;
+    qint64 m_value = -1;
+};
+
+#endif // TRACE_H
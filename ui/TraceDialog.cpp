@@ -0,0 +1,105 @@
+/*
+ * TraceDialog.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TraceDialog.h"
+#include "Trace.h"
+#include "Tr.h"
+
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSaveFile>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+TraceDialog::TraceDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle(TR("trace.title"));
+    auto *layout = new QVBoxLayout(this);
+
+    m_list = new QTreeWidget(this);
+    m_list->setRootIsDecorated(false);
+    m_list->setUniformRowHeights(true);
+    m_list->setHeaderLabels({TR("trace.column_span"), TR("trace.column_start"),
+        TR("trace.column_duration"), TR("trace.column_thread"), TR("trace.column_value")});
+    m_list->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    layout->addWidget(m_list);
+
+    auto *buttons = new QDialogButtonBox(QDialogButtonBox::Close, this);
+    QPushButton *refreshBtn = buttons->addButton(TR("trace.refresh"), QDialogButtonBox::ActionRole);
+    QPushButton *clearBtn = buttons->addButton(TR("trace.clear"), QDialogButtonBox::ActionRole);
+    QPushButton *exportBtn = buttons->addButton(TR("trace.export"), QDialogButtonBox::ActionRole);
+    connect(refreshBtn, &QPushButton::clicked, this, &TraceDialog::refresh);
+    connect(clearBtn, &QPushButton::clicked, this, [this]() {
+        Trace::clear();
+        refresh();
+    });
+    connect(exportBtn, &QPushButton::clicked, this, &TraceDialog::exportTrace);
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::close);
+    layout->addWidget(buttons);
+
+    resize(700, 500);
+    refresh();
+}
+
+void TraceDialog::refresh() {
+    const QVector<TraceEvent> events = Trace::snapshot();
+    QList<QTreeWidgetItem *> items;
+    items.reserve(events.size());
+    for (const TraceEvent &event : events) {
+        auto *item = new QTreeWidgetItem();
+        item->setText(0, QString::fromLatin1(event.name));
+        item->setText(1, QString::number(event.startUs / 1000.0, 'f', 1));
+        item->setText(2, QString::number(event.durationUs / 1000.0, 'f', 2));
+        item->setText(3, QString::number(event.thread));
+        if (event.value >= 0) {
+            item->setText(4, QString::number(event.value));
+        }
+        for (int col = 1; col < 5; ++col) {
+            item->setTextAlignment(col, Qt::AlignRight | Qt::AlignVCenter);
+        }
+        items.append(item);
+    }
+    m_list->clear();
+    m_list->addTopLevelItems(items);
+    if (!items.isEmpty()) {
+        m_list->scrollToItem(items.last());
+    }
+}
+
+void TraceDialog::exportTrace() {
+    QString path = QFileDialog::getSaveFileName(this, TR("trace.export"),
+        QStringLiteral("tagliacarte-trace.json"), QStringLiteral("JSON (*.json)"));
+    if (path.isEmpty()) {
+        return;
+    }
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        QMessageBox::warning(this, TR("common.error"), TR("trace.export_failed").arg(path));
+        return;
+    }
+    f.write(Trace::toChromeJson(Trace::snapshot()));
+    if (!f.commit()) {
+        QMessageBox::warning(this, TR("common.error"), TR("trace.export_failed").arg(path));
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * TraceDialog.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACEDIALOG_H
+#define TRACEDIALOG_H
+
+#include <QDialog>
+
+class QTreeWidget;
+
+/**
+ * Debug panel for the latency trace (see Trace): lists the recorded spans with their start,
+ * duration, thread and value, and exports them as Chrome trace JSON for offline analysis.
+ */
+class TraceDialog : public QDialog {
+public:
+    explicit TraceDialog(QWidget *parent = nullptr);
+
+    /** Reload the spans from the trace ring. */
+    void refresh();
+
+private:
+    void exportTrace();
+
+    QTreeWidget *m_list;
+};
+
+#endif // TRACEDIALOG_H
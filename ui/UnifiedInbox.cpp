@@ -0,0 +1,307 @@
+/*
+ * UnifiedInbox.cpp
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UnifiedInbox.h"
+#include "Config.h"
+#include "EventBridge.h"
+#include "Tr.h"
+#include "tagliacarte.h"
+
+#include <QDateTime>
+#include <QLocale>
+#include <QStatusBar>
+#include <QTimer>
+#include <QTreeWidget>
+#include <algorithm>
+#include <cstdio>
+
+// Newest messages loaded from each store; older ones are in the store's own view
+static constexpr quint64 MessagesPerStore = 500;
+
+// Summaries are gathered this long before a flush, so the list grows in batches
+static constexpr int FlushDelayMs = 50;
+
+static void on_unified_folder_ready(const char *folder_uri, void *user_data) {
+    auto *ctx = static_cast<UnifiedInbox::CallbackContext *>(user_data);
+    QString uri = QString::fromUtf8(folder_uri);
+    tagliacarte_free_string(const_cast<char *>(folder_uri));
+    QMetaObject::invokeMethod(ctx->inbox, "onFolderReady", Qt::QueuedConnection,
+        Q_ARG(quint64, ctx->generation), Q_ARG(int, ctx->source), Q_ARG(QString, uri));
+}
+
+static void on_unified_open_error(const char *message, void *user_data) {
+    auto *ctx = static_cast<UnifiedInbox::CallbackContext *>(user_data);
+    QMetaObject::invokeMethod(ctx->inbox, "onSourceError", Qt::QueuedConnection,
+        Q_ARG(quint64, ctx->generation), Q_ARG(int, ctx->source),
+        Q_ARG(QString, message ? QString::fromUtf8(message) : QString()));
+}
+
+static void on_unified_message_count(uint64_t count, int error, void *user_data) {
+    auto *ctx = static_cast<UnifiedInbox::CallbackContext *>(user_data);
+    if (error != 0) {
+        QMetaObject::invokeMethod(ctx->inbox, "onSourceError", Qt::QueuedConnection,
+            Q_ARG(quint64, ctx->generation), Q_ARG(int, ctx->source), Q_ARG(QString, QString()));
+        return;
+    }
+    QMetaObject::invokeMethod(ctx->inbox, "onMessageCount", Qt::QueuedConnection,
+        Q_ARG(quint64, ctx->generation), Q_ARG(int, ctx->source), Q_ARG(quint64, static_cast<quint64>(count)));
+}
+
+static void on_unified_message_summary(const char *id, const char *subject, const char *from_, int64_t date_timestamp_secs,
+                                       uint64_t, uint32_t flags, void *user_data) {
+    auto *ctx = static_cast<UnifiedInbox::CallbackContext *>(user_data);
+    QMetaObject::invokeMethod(ctx->inbox, "onMessageSummary", Qt::QueuedConnection,
+        Q_ARG(quint64, ctx->generation), Q_ARG(int, ctx->source),
+        Q_ARG(QString, QString::fromUtf8(id)),
+        Q_ARG(QString, subject ? QString::fromUtf8(subject) : QString()),
+        Q_ARG(QString, from_ ? QString::fromUtf8(from_) : QString()),
+        Q_ARG(qint64, static_cast<qint64>(date_timestamp_secs)),
+        Q_ARG(quint32, flags));
+}
+
+static void on_unified_message_list_complete(int error, void *user_data) {
+    auto *ctx = static_cast<UnifiedInbox::CallbackContext *>(user_data);
+    QMetaObject::invokeMethod(ctx->inbox, "onMessageListComplete", Qt::QueuedConnection,
+        Q_ARG(quint64, ctx->generation), Q_ARG(int, ctx->source), Q_ARG(int, error));
+}
+
+UnifiedInbox::UnifiedInbox(QTreeWidget *list, QStatusBar *statusBar, QObject *parent)
+    : QObject(parent)
+    , m_list(list)
+    , m_statusBar(statusBar)
+{
+}
+
+void UnifiedInbox::open(const QList<QByteArray> &storeUris)
+{
+    close();
+    m_active = true;
+    m_dateFormat = loadConfig().dateFormat;
+    const quint64 generation = ++m_generation;
+    for (const QByteArray &storeUri : storeUris) {
+        char *name = tagliacarte_store_default_folder(storeUri.constData());
+        if (!name) {
+            continue;  // chat and news stores have no inbox
+        }
+        m_contexts.push_back(std::make_unique<CallbackContext>(
+            CallbackContext{ this, generation, static_cast<int>(m_sources.size()), QByteArray() }));
+        Source source;
+        source.storeUri = storeUri;
+        source.context = m_contexts.back().get();
+        m_sources.append(source);
+        tagliacarte_store_start_open_folder(storeUri.constData(), name, nullptr,
+            on_unified_folder_ready, on_unified_open_error, source.context);
+        tagliacarte_free_string(name);
+    }
+    if (m_statusBar) {
+        m_statusBar->showMessage(m_sources.isEmpty()
+            ? TR_N("status.folder_messages_count", 0)
+            : TR("status.folder_loading").arg(TR("unified.all_inboxes")));
+    }
+}
+
+void UnifiedInbox::close()
+{
+    ++m_generation;
+    for (const Source &source : m_sources) {
+        if (!source.folderUri.isEmpty()) {
+            tagliacarte_folder_free(source.folderUri.constData());
+        }
+    }
+    m_sources.clear();
+    m_active = false;
+    m_flushScheduled = false;
+}
+
+void UnifiedInbox::removeStore(const QByteArray &storeUri)
+{
+    for (Source &source : m_sources) {
+        if (source.storeUri != storeUri) {
+            continue;
+        }
+        if (!source.folderUri.isEmpty()) {
+            for (int i = m_list->topLevelItemCount() - 1; i >= 0; --i) {
+                if (m_list->topLevelItem(i)->data(0, MessageFolderUriRole).toByteArray() == source.folderUri) {
+                    delete m_list->takeTopLevelItem(i);
+                }
+            }
+            tagliacarte_folder_free(source.folderUri.constData());
+        }
+        // Keep the slot so that the other sources' indices stay valid
+        source.storeUri.clear();
+        source.folderUri.clear();
+        source.pending.clear();
+        source.finished = true;
+    }
+}
+
+QByteArray UnifiedInbox::storeUriForFolder(const QByteArray &folderUri) const
+{
+    for (const Source &source : m_sources) {
+        if (!folderUri.isEmpty() && source.folderUri == folderUri) {
+            return source.storeUri;
+        }
+    }
+    return QByteArray();
+}
+
+bool UnifiedInbox::folderInUse(const QByteArray &folderUri) const
+{
+    for (const Source &source : m_sources) {
+        if (source.folderUri == folderUri
+            || (source.folderUri.isEmpty() && !source.finished && !source.storeUri.isEmpty()
+                && folderUri.startsWith(source.storeUri + '/'))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UnifiedInbox::releaseContext(quint64 generation, int source)
+{
+    auto it = std::find_if(m_contexts.begin(), m_contexts.end(),
+        [generation, source](const std::unique_ptr<CallbackContext> &ctx) {
+            return ctx->generation == generation && ctx->source == source;
+        });
+    if (it == m_contexts.end()) {
+        return;
+    }
+    if (!(*it)->folderUri.isEmpty()) {
+        tagliacarte_folder_clear_message_list_callbacks((*it)->folderUri.constData(), it->get());
+    }
+    m_contexts.erase(it);
+}
+
+void UnifiedInbox::onFolderReady(quint64 generation, int source, const QString &folderUri)
+{
+    if (generation != m_generation || m_sources[source].storeUri.isEmpty()) {
+        // Stale (the view was closed or reopened meanwhile) or the store went away. Folder
+        // URIs are per name, so leave it to a current source that has (or is opening) it.
+        const QByteArray uri = folderUri.toUtf8();
+        if (!folderInUse(uri)) {
+            tagliacarte_folder_free(uri.constData());
+        }
+        releaseContext(generation, source);
+        return;
+    }
+    Source &src = m_sources[source];
+    src.folderUri = folderUri.toUtf8();
+    tagliacarte_folder_message_count(src.folderUri.constData(), on_unified_message_count, src.context);
+}
+
+void UnifiedInbox::onSourceError(quint64 generation, int source, const QString &message)
+{
+    releaseContext(generation, source);
+    if (generation != m_generation) {
+        return;
+    }
+    fprintf(stderr, "[unified] %s: %s\n", m_sources[source].storeUri.constData(),
+        message.isEmpty() ? "could not open inbox" : message.toUtf8().constData());
+    finishSource(source);
+}
+
+void UnifiedInbox::onMessageCount(quint64 generation, int source, quint64 count)
+{
+    if (generation != m_generation) {
+        releaseContext(generation, source);
+        return;
+    }
+    const Source &src = m_sources[source];
+    if (count == 0 || src.folderUri.isEmpty()) {
+        releaseContext(generation, source);
+        finishSource(source);
+        return;
+    }
+    src.context->folderUri = src.folderUri;
+    tagliacarte_folder_set_message_list_callbacks(src.folderUri.constData(),
+        on_unified_message_summary, on_unified_message_list_complete, src.context);
+    quint64 start = count > MessagesPerStore ? count - MessagesPerStore : 0;
+    tagliacarte_folder_request_message_list(src.folderUri.constData(), start, count);
+}
+
+void UnifiedInbox::onMessageSummary(quint64 generation, int source, const QString &id, const QString &subject,
+                                    const QString &from, qint64 timestampSecs, quint32 flags)
+{
+    if (generation != m_generation || m_sources[source].storeUri.isEmpty()) {
+        return;
+    }
+    m_sources[source].pending.append({ id, subject, from, timestampSecs, flags });
+    scheduleFlush();
+}
+
+void UnifiedInbox::onMessageListComplete(quint64 generation, int source, int error)
+{
+    releaseContext(generation, source);
+    if (generation != m_generation) {
+        return;
+    }
+    if (error != 0) {
+        fprintf(stderr, "[unified] %s: message list failed\n", m_sources[source].storeUri.constData());
+    }
+    finishSource(source);
+}
+
+void UnifiedInbox::finishSource(int source)
+{
+    m_sources[source].finished = true;
+    flush();
+    bool allFinished = std::all_of(m_sources.cbegin(), m_sources.cend(),
+        [](const Source &s) { return s.finished; });
+    if (allFinished && m_statusBar) {
+        m_statusBar->showMessage(TR("unified.all_inboxes") + QStringLiteral(" — ")
+            + TR_N("status.folder_messages_count", m_list->topLevelItemCount()));
+    }
+}
+
+void UnifiedInbox::scheduleFlush()
+{
+    if (m_flushScheduled) {
+        return;
+    }
+    m_flushScheduled = true;
+    const quint64 generation = m_generation;
+    QTimer::singleShot(FlushDelayMs, this, [this, generation]() {
+        if (m_flushScheduled && generation == m_generation) {
+            flush();
+        }
+    });
+}
+
+void UnifiedInbox::flush()
+{
+    m_flushScheduled = false;
+    QList<QTreeWidgetItem *> items;
+    for (Source &source : m_sources) {
+        for (const Summary &s : source.pending) {
+            QString dateStr;
+            if (s.timestampSecs >= 0) {
+                QDateTime dt = QDateTime::fromSecsSinceEpoch(s.timestampSecs);
+                dateStr = m_dateFormat.isEmpty() ? QLocale().toString(dt, QLocale::ShortFormat) : dt.toString(m_dateFormat);
+            }
+            QTreeWidgetItem *item = EventBridge::newMessageItem(s.id, s.subject, s.from, dateStr, s.timestampSecs, s.flags);
+            item->setData(0, MessageFolderUriRole, source.folderUri);
+            items.append(item);
+        }
+        source.pending.clear();
+    }
+    if (!items.isEmpty()) {
+        m_list->addTopLevelItems(items);
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * UnifiedInbox.h
+ * Copyright (C) 2026 Chris Burdess
+ *
+ * This file is part of Tagliacarte, a cross-platform email client.
+ *
+ * Tagliacarte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Tagliacarte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Tagliacarte.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UNIFIEDINBOX_H
+#define UNIFIEDINBOX_H
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <vector>
+
+class QStatusBar;
+class QTreeWidget;
+
+/**
+ * The "All inboxes" view: opens the default folder of several stores at once and fills
+ * the message list from all of them. Summaries are collected per store and flushed in
+ * short batches; the list itself keeps the rows sorted (by timestamp when sorted by date).
+ * Each row keeps its folder URI (MessageFolderUriRole) so that opening, deleting and
+ * dragging act on the right store.
+ */
+class UnifiedInbox : public QObject {
+    Q_OBJECT
+public:
+    UnifiedInbox(QTreeWidget *list, QStatusBar *statusBar, QObject *parent = nullptr);
+
+    /** Open the default folder of each store and stream their messages into the list.
+     *  The caller clears the list first. */
+    void open(const QList<QByteArray> &storeUris);
+    /** Free the folders; results still in flight are dropped. Rows are left to the caller. */
+    void close();
+    bool isActive() const { return m_active; }
+    /** A store is going away: drop its rows and free its folder. */
+    void removeStore(const QByteArray &storeUri);
+    /** The store whose folder folderUri is, or empty. */
+    QByteArray storeUriForFolder(const QByteArray &folderUri) const;
+
+public Q_SLOTS:
+    void onFolderReady(quint64 generation, int source, const QString &folderUri);
+    void onSourceError(quint64 generation, int source, const QString &message);
+    void onMessageCount(quint64 generation, int source, quint64 count);
+    void onMessageSummary(quint64 generation, int source, const QString &id, const QString &subject,
+                          const QString &from, qint64 timestampSecs, quint32 flags);
+    void onMessageListComplete(quint64 generation, int source, int error);
+
+public:
+    /** user_data for the backend callbacks of one store in one open(). */
+    struct CallbackContext {
+        UnifiedInbox *inbox;
+        quint64 generation;
+        int source;
+        QByteArray folderUri;  // folder whose message list callbacks carry this context
+    };
+
+private:
+    struct Summary {
+        QString id;
+        QString subject;
+        QString from;
+        qint64 timestampSecs;
+        quint32 flags;
+    };
+    struct Source {
+        QByteArray storeUri;
+        QByteArray folderUri;       // empty until the folder is open
+        CallbackContext *context = nullptr;
+        QVector<Summary> pending;   // received since the last flush
+        bool finished = false;
+    };
+
+    void scheduleFlush();
+    void flush();
+    void finishSource(int source);
+    /** True if a current source has folderUri open, or is opening a folder of its store. */
+    bool folderInUse(const QByteArray &folderUri) const;
+    /** The backend will not call back with this context again: detach it from its folder
+     *  and free it. */
+    void releaseContext(quint64 generation, int source);
+
+    QTreeWidget *m_list;
+    QStatusBar *m_statusBar;
+    bool m_active = false;
+    bool m_flushScheduled = false;
+    quint64 m_generation = 0;       // bumped by open and close; older callbacks are ignored
+    QString m_dateFormat;           // read from config by open()
+    QVector<Source> m_sources;
+    // Backends may call back after close(), so a context lives until its last callback
+    std::vector<std::unique_ptr<CallbackContext>> m_contexts;
+};
+
+#endif // UNIFIEDINBOX_H
@@ -439,6 +439,86 @@
         <source>status.sending</source>
         <translation>Senden…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>Nicht gesendet</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>Newsgroups filtern</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>Alle</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>Alle Gruppen des Servers durchsuchen</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>Weitere Treffer – Filter verfeinern</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>Abonnieren</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>Abbestellen</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>%1 Nachrichten, %2 ungelesen</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>Beim Start mit allen Konten verbinden</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>Alle Posteingänge</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>Latenz-Trace</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>Abschnitt</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>Beginn (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>Dauer (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>Thread</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>Wert</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>Aktualisieren</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>Leeren</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>Exportieren…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>%1 konnte nicht geschrieben werden</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>Öffnen Sie ein Maildir, um zu starten.</translation>
@@ -473,6 +553,18 @@
         <source>status.message_load_error</source>
         <translation>Fehler beim Laden der Nachricht.</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>Anhang wird gespeichert…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>Anhang gespeichert.</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>Fehler beim Speichern des Anhangs.</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>(unbekannt)</translation>
@@ -653,6 +745,18 @@
         <source>message.forward.tooltip</source>
         <translation>Weiterleiten</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>Quelltext anzeigen</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>Quelltext: %1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>Der Quelltext der Nachricht konnte nicht geladen werden.</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>Spam</translation>
@@ -439,6 +439,86 @@
         <source>status.sending</source>
         <translation>Αποστολή…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>Δεν στάλθηκε</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>Φιλτράρισμα ομάδων</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>Όλες</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>Περιήγηση σε όλες τις ομάδες του διακομιστή</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>Περισσότερα αποτελέσματα — περιορίστε το φίλτρο</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>Εγγραφή</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>Διαγραφή συνδρομής</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>%1 μηνύματα, %2 μη αναγνωσμένα</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>Σύνδεση σε όλους τους λογαριασμούς κατά την εκκίνηση</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>Όλα τα εισερχόμενα</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>Ίχνος καθυστέρησης</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>Στάδιο</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>Έναρξη (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>Διάρκεια (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>Νήμα</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>Τιμή</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>Ανανέωση</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>Εκκαθάριση</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>Εξαγωγή…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>Δεν ήταν δυνατή η εγγραφή του %1</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>Ανοίξτε ένα Maildir για να ξεκινήσετε.</translation>
@@ -473,6 +553,18 @@
         <source>status.message_load_error</source>
         <translation>Σφάλμα κατά τη φόρτωση του μηνύματος.</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>Αποθήκευση συνημμένου…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>Το συνημμένο αποθηκεύτηκε.</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>Σφάλμα κατά την αποθήκευση του συνημμένου.</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>(άγνωστο)</translation>
@@ -653,6 +745,18 @@
         <source>message.forward.tooltip</source>
         <translation>Προώθηση</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>Προβολή πηγής</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>Πηγή: %1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>Δεν ήταν δυνατή η φόρτωση της πηγής του μηνύματος.</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>Ανεπιθύμητη αλληλογραφία</translation>
@@ -955,6 +955,86 @@
         <source>status.sending</source>
         <translation>Sending…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>Not sent</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>Filter newsgroups</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>All</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>Browse every group on the server</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>More matches — refine the filter</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>Subscribe</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>Unsubscribe</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>%1 messages, %2 unread</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>Connect to all accounts at startup</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>All inboxes</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>Latency trace</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>Span</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>Start (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>Duration (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>Thread</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>Value</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>Refresh</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>Clear</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>Export…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>Could not write %1</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>Open a Maildir to start.</translation>
@@ -1004,6 +1084,18 @@
         <source>status.message_load_error</source>
         <translation>Error loading message.</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>Saving attachment…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>Attachment saved.</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>Error saving attachment.</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>Unknown sender</translation>
@@ -1056,6 +1148,18 @@
         <source>message.forward.tooltip</source>
         <translation>Forward</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>View Source</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>Source: %1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>Could not load the message source.</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>Mark as junk</translation>
@@ -439,6 +439,86 @@
         <source>status.sending</source>
         <translation>Enviando…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>No enviado</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>Filtrar grupos de noticias</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>Todos</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>Explorar todos los grupos del servidor</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>Más coincidencias: afine el filtro</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>Suscribirse</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>Cancelar suscripción</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>%1 mensajes, %2 sin leer</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>Conectar todas las cuentas al iniciar</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>Todas las bandejas de entrada</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>Traza de latencia</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>Tramo</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>Inicio (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>Duración (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>Hilo</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>Valor</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>Actualizar</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>Vaciar</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>Exportar…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>No se pudo escribir %1</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>Abra un Maildir para comenzar.</translation>
@@ -473,6 +553,18 @@
         <source>status.message_load_error</source>
         <translation>Error al cargar el mensaje.</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>Guardando adjunto…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>Adjunto guardado.</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>Error al guardar el adjunto.</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>(desconocido)</translation>
@@ -653,6 +745,18 @@
         <source>message.forward.tooltip</source>
         <translation>Reenviar</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>Ver código fuente</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>Código fuente: %1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>No se pudo cargar el código fuente del mensaje.</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>Correo no deseado</translation>
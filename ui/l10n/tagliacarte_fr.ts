@@ -439,6 +439,86 @@
         <source>status.sending</source>
         <translation>Envoi…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>Non envoyé</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>Filtrer les groupes</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>Tous</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>Parcourir tous les groupes du serveur</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>Autres résultats — affinez le filtre</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>S’abonner</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>Se désabonner</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>%1 messages, %2 non lus</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>Se connecter à tous les comptes au démarrage</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>Toutes les boîtes de réception</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>Trace de latence</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>Étape</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>Début (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>Durée (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>Thread</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>Valeur</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>Actualiser</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>Effacer</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>Exporter…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>Impossible d’écrire %1</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>Ouvrez un Maildir pour commencer.</translation>
@@ -473,6 +553,18 @@
         <source>status.message_load_error</source>
         <translation>Erreur lors du chargement du message.</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>Enregistrement de la pièce jointe…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>Pièce jointe enregistrée.</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>Erreur lors de l’enregistrement de la pièce jointe.</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>(inconnu)</translation>
@@ -653,6 +745,18 @@
         <source>message.forward.tooltip</source>
         <translation>Transférer</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>Afficher la source</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>Source : %1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>Impossible de charger la source du message.</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>Courrier indésirable</translation>
@@ -439,6 +439,86 @@
         <source>status.sending</source>
         <translation>Invio…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>Non inviato</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>Filtra newsgroup</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>Tutti</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>Sfoglia tutti i gruppi del server</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>Altri risultati — affina il filtro</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>Iscriviti</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>Annulla iscrizione</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>%1 messaggi, %2 non letti</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>Connetti tutti gli account all'avvio</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>Tutta la posta in arrivo</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>Traccia della latenza</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>Fase</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>Inizio (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>Durata (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>Thread</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>Valore</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>Aggiorna</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>Svuota</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>Esporta…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>Impossibile scrivere %1</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>Apri un Maildir per iniziare.</translation>
@@ -473,6 +553,18 @@
         <source>status.message_load_error</source>
         <translation>Errore durante il caricamento del messaggio.</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>Salvataggio dell’allegato…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>Allegato salvato.</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>Errore durante il salvataggio dell’allegato.</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>(sconosciuto)</translation>
@@ -653,6 +745,18 @@
         <source>message.forward.tooltip</source>
         <translation>Inoltra</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>Visualizza sorgente</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>Sorgente: %1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>Impossibile caricare il sorgente del messaggio.</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>Posta indesiderata</translation>
@@ -439,6 +439,86 @@
         <source>status.sending</source>
         <translation>送信中…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>未送信</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>ニュースグループを絞り込む</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>すべて</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>サーバーのすべてのグループを表示</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>他にも一致があります — 絞り込んでください</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>購読</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>購読解除</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>%1 件のメッセージ、未読 %2 件</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>起動時にすべてのアカウントに接続</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>すべての受信トレイ</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>レイテンシトレース</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>区間</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>開始 (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>所要時間 (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>スレッド</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>値</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>更新</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>消去</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>エクスポート…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>%1 を書き込めませんでした</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>Maildir を開いて開始してください。</translation>
@@ -471,6 +551,18 @@
         <source>status.message_load_error</source>
         <translation>メッセージの読み込みエラー。</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>添付ファイルを保存中…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>添付ファイルを保存しました。</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>添付ファイルの保存中にエラーが発生しました。</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>（不明）</translation>
@@ -651,6 +743,18 @@
         <source>message.forward.tooltip</source>
         <translation>転送</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>ソースを表示</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>ソース: %1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>メッセージのソースを読み込めませんでした。</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>迷惑メール</translation>
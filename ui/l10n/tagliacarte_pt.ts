@@ -439,6 +439,86 @@
         <source>status.sending</source>
         <translation>A enviar…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>Não enviado</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>Filtrar grupos de notícias</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>Todos</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>Explorar todos os grupos do servidor</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>Mais resultados — refine o filtro</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>Subscrever</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>Cancelar subscrição</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>%1 mensagens, %2 não lidas</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>Ligar a todas as contas ao iniciar</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>Todas as caixas de entrada</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>Rastreio de latência</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>Etapa</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>Início (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>Duração (ms)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>Thread</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>Valor</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>Atualizar</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>Limpar</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>Exportar…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>Não foi possível gravar %1</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>Abra um Maildir para começar.</translation>
@@ -473,6 +553,18 @@
         <source>status.message_load_error</source>
         <translation>Erro ao carregar a mensagem.</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>A guardar anexo…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>Anexo guardado.</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>Erro ao guardar o anexo.</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>(desconhecido)</translation>
@@ -653,6 +745,18 @@
         <source>message.forward.tooltip</source>
         <translation>Encaminhar</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>Ver código-fonte</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>Código-fonte: %1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>Não foi possível carregar o código-fonte da mensagem.</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>Lixo eletrônico</translation>
@@ -439,6 +439,86 @@
         <source>status.sending</source>
         <translation>Отправка…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>Не отправлено</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>Фильтр групп новостей</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>Все</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>Просмотреть все группы сервера</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>Есть ещё совпадения — уточните фильтр</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>Подписаться</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>Отписаться</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>Сообщений: %1, непрочитанных: %2</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>Подключаться ко всем учётным записям при запуске</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>Все входящие</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>Трассировка задержек</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>Этап</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>Начало (мс)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>Длительность (мс)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>Поток</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>Значение</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>Обновить</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>Очистить</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>Экспорт…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>Не удалось записать %1</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>Откройте Maildir, чтобы начать.</translation>
@@ -475,6 +555,18 @@
         <source>status.message_load_error</source>
         <translation>Ошибка загрузки сообщения.</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>Сохранение вложения…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>Вложение сохранено.</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>Ошибка при сохранении вложения.</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>(неизвестно)</translation>
@@ -655,6 +747,18 @@
         <source>message.forward.tooltip</source>
         <translation>Переслать</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>Показать исходный код</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>Исходный код: %1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>Не удалось загрузить исходный код сообщения.</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>Спам</translation>
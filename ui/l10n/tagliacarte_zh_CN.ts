@@ -439,6 +439,86 @@
         <source>status.sending</source>
         <translation>发送中…</translation>
     </message>
+    <message>
+        <source>chat.send_failed</source>
+        <translation>未发送</translation>
+    </message>
+    <message>
+        <source>newsgroups.filter_placeholder</source>
+        <translation>筛选新闻组</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups</source>
+        <translation>全部</translation>
+    </message>
+    <message>
+        <source>newsgroups.all_groups_tooltip</source>
+        <translation>浏览服务器上的所有组</translation>
+    </message>
+    <message>
+        <source>newsgroups.more_matches</source>
+        <translation>还有更多匹配项——请细化筛选</translation>
+    </message>
+    <message>
+        <source>newsgroups.subscribe</source>
+        <translation>订阅</translation>
+    </message>
+    <message>
+        <source>newsgroups.unsubscribe</source>
+        <translation>取消订阅</translation>
+    </message>
+    <message>
+        <source>folder.counts_tooltip</source>
+        <translation>%1 封邮件，%2 封未读</translation>
+    </message>
+    <message>
+        <source>viewing.warm_up_stores</source>
+        <translation>启动时连接所有账户</translation>
+    </message>
+    <message>
+        <source>unified.all_inboxes</source>
+        <translation>所有收件箱</translation>
+    </message>
+    <message>
+        <source>trace.title</source>
+        <translation>延迟跟踪</translation>
+    </message>
+    <message>
+        <source>trace.column_span</source>
+        <translation>阶段</translation>
+    </message>
+    <message>
+        <source>trace.column_start</source>
+        <translation>开始 (毫秒)</translation>
+    </message>
+    <message>
+        <source>trace.column_duration</source>
+        <translation>耗时 (毫秒)</translation>
+    </message>
+    <message>
+        <source>trace.column_thread</source>
+        <translation>线程</translation>
+    </message>
+    <message>
+        <source>trace.column_value</source>
+        <translation>值</translation>
+    </message>
+    <message>
+        <source>trace.refresh</source>
+        <translation>刷新</translation>
+    </message>
+    <message>
+        <source>trace.clear</source>
+        <translation>清除</translation>
+    </message>
+    <message>
+        <source>trace.export</source>
+        <translation>导出…</translation>
+    </message>
+    <message>
+        <source>trace.export_failed</source>
+        <translation>无法写入 %1</translation>
+    </message>
     <message>
         <source>status.open_maildir_to_start</source>
         <translation>打开一个 Maildir 以开始。</translation>
@@ -473,6 +553,18 @@
         <source>status.message_load_error</source>
         <translation>加载消息时出错。</translation>
     </message>
+    <message>
+        <source>status.saving_attachment</source>
+        <translation>正在保存附件…</translation>
+    </message>
+    <message>
+        <source>status.attachment_saved</source>
+        <translation>附件已保存。</translation>
+    </message>
+    <message>
+        <source>status.attachment_save_error</source>
+        <translation>保存附件时出错。</translation>
+    </message>
     <message>
         <source>message.unknown_sender</source>
         <translation>（未知）</translation>
@@ -653,6 +745,18 @@
         <source>message.forward.tooltip</source>
         <translation>转发</translation>
     </message>
+    <message>
+        <source>message.view_source</source>
+        <translation>查看源代码</translation>
+    </message>
+    <message>
+        <source>source.title</source>
+        <translation>源代码：%1</translation>
+    </message>
+    <message>
+        <source>source.load_error</source>
+        <translation>无法加载邮件源代码。</translation>
+    </message>
     <message>
         <source>message.junk.tooltip</source>
         <translation>垃圾邮件</translation>
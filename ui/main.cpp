@@ -27,7 +27,6 @@
 #include <QHBoxLayout>
 #include <QToolButton>
 #include <QTreeWidget>
-#include <QTreeWidgetItemIterator>
 #include <QSplitter>
 #include <QFileDialog>
 #include <QMessageBox>
@@ -44,11 +43,13 @@
 #include <QLocale>
 #include <QInputDialog>
 #include <QMenu>
+#include <QDialog>
 #include <QAction>
 #include <QHeaderView>
 #include <QUrl>
 #include <QDesktopServices>
 #include <QTimer>
+#include <QPointer>
 
 #include <memory>
 
@@ -65,6 +66,13 @@
 #include "EmojiPicker.h"
 #include "MessageDragTreeWidget.h"
 #include "FolderDropTreeWidget.h"
+#include "SourceViewer.h"
+#include "ChatTimelineModel.h"
+#include "ChatTimelineView.h"
+#include "NewsgroupBrowser.h"
+#include "UnifiedInbox.h"
+#include "Trace.h"
+#include "TraceDialog.h"
 
 
 int main(int argc, char *argv[]) {
@@ -113,6 +121,27 @@ int main(int argc, char *argv[]) {
     sidebarLayout->setContentsMargins(8, 8, 8, 8);
     sidebarLayout->setSpacing(4);
 
+    // All inboxes: a circle above the stores showing every email store's inbox at once
+    static const int circleIconPx = 28;  // same as compose quill so style scales both identically
+    auto *allInboxesBtn = new QToolButton(sidebar);
+    allInboxesBtn->setObjectName("allInboxesBtn");
+    allInboxesBtn->setToolTip(TR("unified.all_inboxes"));
+    QIcon inboxIcon = iconFromSvgResource(QStringLiteral(":/icons/inbox.svg"),
+                                          QApplication::palette().color(QPalette::ButtonText), circleIconPx);
+    if (!inboxIcon.isNull())
+        allInboxesBtn->setIcon(inboxIcon);
+    else
+        allInboxesBtn->setText(QString::fromUtf8("✉"));
+    allInboxesBtn->setIconSize(QSize(circleIconPx, circleIconPx));
+    allInboxesBtn->setFixedSize(40, 40);
+    allInboxesBtn->setCheckable(true);
+    allInboxesBtn->setStyleSheet(
+        "QToolButton#allInboxesBtn { border-radius: 20px; background-color: palette(button); color: palette(button-text); padding: 0; border: none; min-width: 40px; min-height: 40px; }"
+        "QToolButton#allInboxesBtn:hover { background-color: palette(light); }"
+        "QToolButton#allInboxesBtn:checked { background-color: #6b6b6b; color: white; }"
+    );
+    sidebarLayout->addWidget(allInboxesBtn, 0, Qt::AlignHCenter);
+
     auto *storeListWidget = new QWidget(sidebar);
     auto *storeListLayout = new QVBoxLayout(storeListWidget);
     storeListLayout->setContentsMargins(0, 8, 0, 0);
@@ -123,7 +152,6 @@ int main(int argc, char *argv[]) {
     auto *settingsBtn = new QToolButton(sidebar);
     settingsBtn->setObjectName("settingsBtn");
     settingsBtn->setToolTip(TR("settings.tooltip"));
-    static const int circleIconPx = 28;  // same as compose quill so style scales both identically
     QIcon cogIcon = iconFromSvgResource(QStringLiteral(":/icons/cog.svg"),
                                         QApplication::palette().color(QPalette::ButtonText), circleIconPx);
     if (!cogIcon.isNull())
@@ -298,14 +326,34 @@ int main(int argc, char *argv[]) {
     auto *folderListPanelLayout = new QVBoxLayout(folderListPanel);
     folderListPanelLayout->setContentsMargins(8, 8, 0, 8);
     auto *folderTree = new FolderDropTreeWidget(folderListPanel);
-    folderTree->setColumnCount(1);
+    folderTree->setColumnCount(2);  // name, message counts
     folderTree->setHeaderHidden(true);
+    folderTree->header()->setStretchLastSection(false);
+    folderTree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    folderTree->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
     folderTree->setSelectionMode(QAbstractItemView::SingleSelection);
     folderTree->setIndentation(16);
     folderTree->setContextMenuPolicy(Qt::CustomContextMenu);
     folderTree->setAcceptDrops(true);
     folderTree->setDragDropMode(QAbstractItemView::DropOnly);
+
+    // NNTP: group filter and subscribed/all toggle above the tree (NewsgroupBrowser shows it)
+    auto *newsgroupBar = new QWidget(folderListPanel);
+    auto *newsgroupBarLayout = new QHBoxLayout(newsgroupBar);
+    newsgroupBarLayout->setContentsMargins(0, 0, 0, 4);
+    newsgroupBarLayout->setSpacing(4);
+    auto *newsgroupFilter = new QLineEdit(newsgroupBar);
+    newsgroupFilter->setPlaceholderText(TR("newsgroups.filter_placeholder"));
+    newsgroupFilter->setClearButtonEnabled(true);
+    newsgroupBarLayout->addWidget(newsgroupFilter, 1);
+    auto *allGroupsBtn = new QToolButton(newsgroupBar);
+    allGroupsBtn->setText(TR("newsgroups.all_groups"));
+    allGroupsBtn->setToolTip(TR("newsgroups.all_groups_tooltip"));
+    allGroupsBtn->setCheckable(true);
+    newsgroupBarLayout->addWidget(allGroupsBtn);
+    folderListPanelLayout->addWidget(newsgroupBar);
     folderListPanelLayout->addWidget(folderTree);
+    auto *newsgroups = new NewsgroupBrowser(folderTree, newsgroupBar, newsgroupFilter, allGroupsBtn, &win);
 
     auto *rightSplitter = new QSplitter(Qt::Vertical, mainContentPage);
     auto *conversationList = new MessageDragTreeWidget(mainContentPage);
@@ -396,6 +444,12 @@ int main(int argc, char *argv[]) {
     messageView->setOpenExternalLinks(true);
     messageView->setResourceLoadPolicy(loadConfig().resourceLoadPolicy);
     messageAreaLayout->addWidget(messageView, 1);
+    // --- Conversation timeline (replaces the message body in conversation mode) ---
+    auto *chatModel = new ChatTimelineModel(&win);
+    auto *chatView = new ChatTimelineView(mainContentPage);
+    chatView->setModel(chatModel);
+    chatView->hide();
+    messageAreaLayout->addWidget(chatView, 1);
     auto *attachmentsPane = new QWidget(messageArea);
     auto *attachmentsLayout = new QHBoxLayout(attachmentsPane);
     attachmentsLayout->setContentsMargins(0, 4, 0, 0);
@@ -473,6 +527,7 @@ int main(int argc, char *argv[]) {
     ctrl.storeListLayout = storeListLayout;
     ctrl.rightStack = rightStack;
     ctrl.settingsBtn = settingsBtn;
+    ctrl.allInboxesBtn = allInboxesBtn;
     ctrl.chatInput = chatInput;
     ctrl.chatEmojiBtn = emojiBtn;
     ctrl.chatAttachBtn = attachBtn;
@@ -484,9 +539,34 @@ int main(int argc, char *argv[]) {
     buildSettingsPage(&ctrl, &win, version);
 
     mainLayout->addWidget(rightStack, 1);
-    bridge.folderTree = folderTree;
+    bridge.setFolderTree(folderTree);
+    bridge.newsgroups = newsgroups;
+    auto *unifiedInbox = new UnifiedInbox(conversationList, win.statusBar(), &win);
+    ctrl.unifiedInbox = unifiedInbox;
+    QObject::connect(allInboxesBtn, &QToolButton::clicked, [&ctrl]() {
+        ctrl.showUnifiedInbox();
+    });
+    QObject::connect(&bridge, &EventBridge::folderListLoaded, [&ctrl]() {
+        ctrl.restoreFolder(true);
+    });
+    QObject::connect(&bridge, &EventBridge::messageListLoaded, [&ctrl]() {
+        ctrl.restoreMessageSelection();
+    });
+    QObject::connect(newsgroups, &NewsgroupBrowser::subscriptionsChanged, [&](const QStringList &groups) {
+        Config config = loadConfig();
+        for (StoreEntry &e : config.stores) {
+            if (e.id == QString::fromUtf8(ctrl.storeUri)) {
+                e.params[QStringLiteral("subscribedGroups")] = groups.join(QLatin1Char(','));
+                break;
+            }
+        }
+        saveConfig(config);
+    });
     bridge.conversationList = conversationList;
     bridge.messageView = messageView;
+    bridge.chatView = chatView;
+    bridge.chatModel = chatModel;
+    QObject::connect(chatView, &ChatTimelineView::reachedTop, &bridge, &EventBridge::requestOlderChatMessages);
     messageView->setCidRegistry(bridge.cidRegistryPtr());
     bridge.attachmentsPane = attachmentsPane;
     bridge.composeBar = composeBar;
@@ -534,9 +614,9 @@ int main(int argc, char *argv[]) {
                         if (error == 0) {
                             QByteArray uri = ctx->storeUri;
                             EventBridge *b = ctx->bridge;
-                            QMetaObject::invokeMethod(b, [uri]() {
+                            QMetaObject::invokeMethod(b, [b, uri]() {
                                 tagliacarte_store_reload_oauth_token(uri.constData());
-                                tagliacarte_store_refresh_folders(uri.constData());
+                                b->refreshFolders(uri);
                             }, Qt::QueuedConnection);
                         }
                         delete ctx;
@@ -603,7 +683,7 @@ int main(int argc, char *argv[]) {
                     }
                 }
             }
-            tagliacarte_store_refresh_folders(storeUriQ.toUtf8().constData());
+            bridge.refreshFolders(storeUriQ.toUtf8());
         } else {
             const char *err = tagliacarte_last_error();
             QString msg = err ? QString::fromUtf8(err) : TR("auth.login_failed");
@@ -637,7 +717,13 @@ int main(int argc, char *argv[]) {
         auto *item = folderTree->currentItem();
         tagliacarte_folder_set_message_list_callbacks(uri.constData(), on_message_summary_cb, on_message_list_complete_cb, &bridge);
         bridge.startMessageLoading(total);
-        tagliacarte_folder_request_message_list(uri.constData(), 0, total);
+        if (bridge.isConversationMode()) {
+            bridge.requestChatHistory();
+            // New messages, including our own once the relay or homeserver echoes them
+            bridge.subscribeChat();
+        } else {
+            tagliacarte_folder_request_message_list(uri.constData(), 0, total);
+        }
         if (item) {
             win.statusBar()->showMessage(TR("status.folder_loading").arg(item->text(0)));
         }
@@ -672,22 +758,6 @@ int main(int argc, char *argv[]) {
         win.statusBar()->showMessage(TR("status.opening").arg(item->text(0)));
     });
 
-    QObject::connect(&bridge, &EventBridge::messageSent, [&]() {
-        if (!bridge.isConversationMode()) return;
-        auto *item = folderTree->currentItem();
-        if (!item || ctrl.storeUri.isEmpty()) return;
-        QString realName = item->data(0, FolderNameRole).toString();
-        if (realName.isEmpty()) return;
-        bridge.clearFolder();
-        conversationList->clear();
-        messageView->clear();
-        bridge.setFolderNameOpening(realName);
-        QByteArray name = realName.toUtf8();
-        tagliacarte_store_start_open_folder(
-            ctrl.storeUri.constData(), name.constData(),
-            on_open_folder_select_event_cb, on_folder_ready_cb, on_open_folder_error_cb, &bridge);
-    });
-
     // --- Folder tree context menu ---
     QObject::connect(folderTree, &QTreeWidget::customContextMenuRequested, [&](const QPoint &pos) {
         if (ctrl.storeUri.isEmpty()) {
@@ -803,16 +873,7 @@ int main(int argc, char *argv[]) {
                     int suffix = 2;
                     while (true) {
                         QString candidateFullName = realName + delimChar + candidateLeaf;
-                        bool exists = false;
-                        QTreeWidgetItemIterator it(folderTree);
-                        while (*it) {
-                            if ((*it)->data(0, FolderNameRole).toString() == candidateFullName) {
-                                exists = true;
-                                break;
-                            }
-                            ++it;
-                        }
-                        if (!exists) {
+                        if (!bridge.findFolderItem(candidateFullName)) {
                             break;
                         }
                         candidateLeaf = baseName + QStringLiteral(" %1").arg(suffix++);
@@ -958,6 +1019,13 @@ int main(int argc, char *argv[]) {
                     });
                 }
             }
+            if (kind == TAGLIACARTE_STORE_KIND_NNTP && !realName.isEmpty()) {
+                bool subscribed = newsgroups->isSubscribed(realName);
+                QAction *subAct = menu.addAction(subscribed ? TR("newsgroups.unsubscribe") : TR("newsgroups.subscribe"));
+                QObject::connect(subAct, &QAction::triggered, [&, realName, subscribed]() {
+                    newsgroups->setSubscribed(realName, !subscribed);
+                });
+            }
             // Mark all read: available for all store types that have an open folder.
             if (!realName.isEmpty()) {
                 bool noselect = attrs.toLower().contains(QLatin1String("\\noselect"));
@@ -1007,16 +1075,7 @@ int main(int argc, char *argv[]) {
                     QString candidate = baseName;
                     int suffix = 2;
                     while (true) {
-                        bool exists = false;
-                        QTreeWidgetItemIterator it(folderTree);
-                        while (*it) {
-                            if ((*it)->data(0, FolderNameRole).toString() == candidate) {
-                                exists = true;
-                                break;
-                            }
-                            ++it;
-                        }
-                        if (!exists) {
+                        if (!bridge.findFolderItem(candidate)) {
                             break;
                         }
                         candidate = baseName + QStringLiteral(" %1").arg(suffix++);
@@ -1102,11 +1161,17 @@ int main(int argc, char *argv[]) {
     });
 
     QObject::connect(conversationList, &QTreeWidget::itemSelectionChanged, [&]() {
+        if (unifiedInbox->isActive()) {
+            // Reply and forward through the store the selected row came from
+            QByteArray rowFolderUri = bridge.folderUriForItem(conversationList->currentItem());
+            ctrl.smtpTransportUri = ctrl.storeToTransport.value(unifiedInbox->storeUriForFolder(rowFolderUri));
+            ctrl.updateComposeAppendButtons();
+        }
         ctrl.updateMessageActionButtons();
         messageView->clear();
         messageHeaderPane->hide();
         auto *item = conversationList->currentItem();
-        QByteArray uri = bridge.folderUri();
+        QByteArray uri = bridge.folderUriForItem(item);
         if (!item || uri.isEmpty()) {
             return;
         }
@@ -1128,10 +1193,66 @@ int main(int argc, char *argv[]) {
             on_end_entity_cb,
             on_message_complete_cb,
             &bridge);
+        tagliacarte_folder_set_deferred_part_callback(uri.constData(), on_deferred_part_cb);
+        tagliacarte_folder_set_body_buffer_callback(uri.constData(), on_body_buffer_cb);
+        bridge.setMessageIdLoading(id);
         tagliacarte_folder_request_message(uri.constData(), id.constData());
         win.statusBar()->showMessage(TR("status.loading"));
     });
 
+    // View raw message source: conversation list context menu, or Ctrl+U
+    auto *viewSourceAct = new QAction(TR("message.view_source"), &win);
+    viewSourceAct->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_U));
+    win.addAction(viewSourceAct);
+    QObject::connect(viewSourceAct, &QAction::triggered, [&]() {
+        auto *item = conversationList->currentItem();
+        QByteArray uri = bridge.folderUriForItem(item);
+        if (!item || uri.isEmpty()) {
+            return;
+        }
+        QVariant idVar = item->data(0, MessageIdRole);
+        if (!idVar.isValid()) {
+            return;
+        }
+        QByteArray id = idVar.toString().toUtf8();
+        auto *dlg = new QDialog(&win);
+        dlg->setAttribute(Qt::WA_DeleteOnClose);
+        dlg->setWindowTitle(TR("source.title").arg(item->text(1)));
+        auto *dlgLayout = new QVBoxLayout(dlg);
+        dlgLayout->setContentsMargins(0, 0, 0, 0);
+        auto *viewer = new SourceViewer(dlg);
+        dlgLayout->addWidget(viewer);
+        dlg->resize(900, 700);
+        dlg->show();
+        tagliacarte_folder_request_message_source(uri.constData(), id.constData(),
+            on_source_chunk_cb, on_source_complete_cb, new SourceLoadContext{viewer});
+    });
+    // Latency trace panel: Ctrl+Shift+T
+    auto *traceAct = new QAction(TR("trace.title"), &win);
+    traceAct->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_T));
+    win.addAction(traceAct);
+    QObject::connect(traceAct, &QAction::triggered, [&win]() {
+        static QPointer<TraceDialog> dlg;
+        if (!dlg) {
+            dlg = new TraceDialog(&win);
+            dlg->setAttribute(Qt::WA_DeleteOnClose);
+        } else {
+            dlg->refresh();
+        }
+        dlg->show();
+        dlg->raise();
+        dlg->activateWindow();
+    });
+    conversationList->setContextMenuPolicy(Qt::CustomContextMenu);
+    QObject::connect(conversationList, &QTreeWidget::customContextMenuRequested, [&](const QPoint &pos) {
+        if (!conversationList->itemAt(pos)) {
+            return;
+        }
+        QMenu menu;
+        menu.addAction(viewSourceAct);
+        menu.exec(conversationList->viewport()->mapToGlobal(pos));
+    });
+
     // Show link URL in status bar on mouse hover
     QObject::connect(messageView, &QTextBrowser::highlighted, [&](const QUrl &url) {
         if (url.isEmpty()) {
@@ -1183,6 +1304,7 @@ int main(int argc, char *argv[]) {
     ctrl.connectComposeActions();
 
     win.show();
+    Trace::record("startup.window", 0);
 
     int ret = app.exec();
 